@@ -1,4 +1,5 @@
 #include "pch.h"
+#ifdef ELITE_BACKEND_DX11
 #include "BaseEffect.h"
 
 BaseEffect::BaseEffect(ID3D11Device* pDevice, const std::wstring& assetFile)
@@ -30,6 +31,15 @@ BaseEffect::BaseEffect(ID3D11Device* pDevice, const std::wstring& assetFile)
 	if (!m_pDiffuseMapVariable->IsValid())
 		std::wcout << L"Variable gDiffuseMap not found\n";
 
+	//Create position dequantization
+	m_pPositionOffsetVariable = m_pEffect->GetVariableByName("gPositionOffset")->AsVector();
+	if (!m_pPositionOffsetVariable->IsValid())
+		std::wcout << L"Variable gPositionOffset not found\n";
+
+	m_pPositionScaleVariable = m_pEffect->GetVariableByName("gPositionScale")->AsVector();
+	if (!m_pPositionScaleVariable->IsValid())
+		std::wcout << L"Variable gPositionScale not found\n";
+
 	//Create and set Pi
 	m_pEffect->GetVariableByName("gPi")->AsScalar()->SetFloat(float(M_PI));
 
@@ -115,6 +125,16 @@ BaseEffect::~BaseEffect()
 		m_pDiffuseMapVariable->Release();
 	}
 
+	if (m_pPositionOffsetVariable)
+	{
+		m_pPositionOffsetVariable->Release();
+	}
+
+	if (m_pPositionScaleVariable)
+	{
+		m_pPositionScaleVariable->Release();
+	}
+
 	for (int i{}; i < m_pTechniques.size(); i++)
 	{
 		m_pTechniques[i]->Release();
@@ -128,3 +148,13 @@ BaseEffect::~BaseEffect()
 	}
 
 }
+
+void BaseEffect::SetVertexQuantization(const Elite::VertexQuantization& quantization)
+{
+	//Effect vectors are always set as four floats
+	const float offset[4]{ quantization.offset.x, quantization.offset.y, quantization.offset.z, 0.f };
+	const float scale[4]{ quantization.scale.x, quantization.scale.y, quantization.scale.z, 0.f };
+	m_pPositionOffsetVariable->SetFloatVector(offset);
+	m_pPositionScaleVariable->SetFloatVector(scale);
+}
+#endif
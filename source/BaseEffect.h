@@ -1,6 +1,8 @@
 #pragma once
+#ifdef ELITE_BACKEND_DX11
 #include <sstream>
 #include <vector>
+#include "PackedVertex.h"
 
 class BaseEffect
 {
@@ -19,6 +21,7 @@ public:
 
 	virtual void SetMatrices(const Elite::FMatrix4& worldViewProj, const Elite::FMatrix4& world = Elite::FMatrix4(), const Elite::FMatrix4& viewInverse = Elite::FMatrix4()) = 0;
 	virtual void SetMaps(ID3D11ShaderResourceView* pDiffuseMap, ID3D11ShaderResourceView* pNormalMap = nullptr, ID3D11ShaderResourceView* pSpecularMap = nullptr, ID3D11ShaderResourceView* pGlossinessMap = nullptr) = 0;
+	void SetVertexQuantization(const Elite::VertexQuantization& quantization);
 
 	static ID3DX11Effect* LoadEffect(ID3D11Device* pDevice, const std::wstring& assetFile)
 	{
@@ -73,6 +76,8 @@ protected:
 	
 	ID3DX11EffectMatrixVariable* m_pMatWorldViewProjVariable;
 	ID3DX11EffectShaderResourceVariable* m_pDiffuseMapVariable;
+	ID3DX11EffectVectorVariable* m_pPositionOffsetVariable;
+	ID3DX11EffectVectorVariable* m_pPositionScaleVariable;
 	std::vector<ID3DX11EffectTechnique*> m_pTechniques;
 
 	ID3D11RasterizerState* m_pRasterizerStateNone;
@@ -81,4 +86,4 @@ protected:
 	ID3D11BlendState* m_pBlendState;
 	ID3D11DepthStencilState* m_pDepthState;
 };
-
+#endif
@@ -0,0 +1,166 @@
+#include "pch.h"
+#include "BatchRenderer.h"
+#include "Profiler.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+Elite::BatchRenderer::BatchRenderer(const SoftwareBackend& backend, uint32_t width, uint32_t height, uint32_t amountOfThreads)
+	: m_Backend{ backend }
+	, m_Width{ width }
+	, m_Height{ height }
+{
+	if (amountOfThreads == 0)
+		amountOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	//Two frames per thread, so a thread can render its next frame while the previous one waits to be handed out in order
+	const uint32_t framesPerWorker = 2;
+	for (uint32_t i = 0; i < amountOfThreads; ++i)
+	{
+		Worker* pWorker = new Worker{};
+		std::vector<uint32_t*> colorBuffers{};
+		for (uint32_t f = 0; f < framesPerWorker; ++f)
+		{
+			SDL_Surface* pFrame = SDL_CreateRGBSurface(0, m_Width, m_Height, 32, 0, 0, 0, 0);
+			pWorker->frames.push_back(pFrame);
+			pWorker->freeFrames.push_back(pFrame);
+			colorBuffers.push_back((uint32_t*)pFrame->pixels);
+		}
+
+		RasterContext& context = pWorker->context;
+		context.pFormat = pWorker->frames.front()->format;
+		context.pFrameBuffer = new FrameBuffer(context.pFormat);
+		context.pFrameBuffer->Resize(m_Width, m_Height, colorBuffers);
+		context.pRenderPixels = colorBuffers.front();
+		context.renderWidth = m_Width;
+		context.renderHeight = m_Height;
+		context.transparencyBuffer.Resize(m_Width, m_Height);
+		context.shadingRateMap.Resize(m_Width, m_Height);
+		context.shadingRateMode = ShadingRateMode::full;
+		context.cull = CullMode::back;
+		context.isMeshletOcclusion = true;
+		context.renderTransparent = false;
+		context.isTransparentPass = false;
+		context.tilePixels.resize(FrameBuffer::TileSize * FrameBuffer::TileSize);
+		context.statistics = FrameStatistics{};
+		context.isPixelStatistics = false;
+		context.debugView = DebugView::none;
+
+		m_pWorkers.push_back(pWorker);
+	}
+}
+
+Elite::BatchRenderer::~BatchRenderer()
+{
+	for (Worker* pWorker : m_pWorkers)
+	{
+		delete pWorker->context.pFrameBuffer;
+		for (SDL_Surface* pFrame : pWorker->frames)
+			SDL_FreeSurface(pFrame);
+		delete pWorker;
+	}
+	m_pWorkers.clear();
+}
+
+void Elite::BatchRenderer::SetPixelStatistics(bool isEnabled)
+{
+	for (Worker* pWorker : m_pWorkers)
+		pWorker->context.isPixelStatistics = isEnabled;
+}
+
+void Elite::BatchRenderer::Render(const std::vector<Elite::RenderJob>& jobs, const std::function<void(uint32_t jobIndex, SDL_Surface* pFrame, const FrameStatistics& statistics)>& onFrame)
+{
+	std::mutex mutex{};
+	std::condition_variable condition{};
+	uint32_t nextJob = 0;
+	std::vector<SDL_Surface*> finishedFrames(jobs.size(), nullptr);
+	std::vector<Worker*> finishedWorkers(jobs.size(), nullptr);
+	//A thread can start its next frame before this one is handed out, so the counters are copied out with the frame
+	std::vector<FrameStatistics> finishedStatistics(jobs.size(), FrameStatistics{});
+
+	//Threads take the next job & render it into one of their own free frames
+	auto work = [&](Worker* pWorker)
+	{
+		ELITE_PROFILE_THREAD("Batch worker");
+		while (true)
+		{
+			uint32_t jobIndex = 0;
+			SDL_Surface* pFrame = nullptr;
+			{
+				std::unique_lock<std::mutex> lock{ mutex };
+				if (nextJob == jobs.size())
+					return;
+
+				jobIndex = nextJob++;
+				condition.wait(lock, [pWorker]() { return !pWorker->freeFrames.empty(); });
+				pFrame = pWorker->freeFrames.front();
+				pWorker->freeFrames.pop_front();
+			}
+
+			RenderJob(*pWorker, jobs[jobIndex], pFrame);
+
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				finishedFrames[jobIndex] = pFrame;
+				finishedWorkers[jobIndex] = pWorker;
+				finishedStatistics[jobIndex] = pWorker->context.statistics;
+			}
+			condition.notify_all();
+		}
+	};
+
+	std::vector<std::thread> threads{};
+	for (Worker* pWorker : m_pWorkers)
+		threads.emplace_back(work, pWorker);
+
+	//Frames are streamed out in job order, a frame goes back to its thread once it has been handed out
+	for (uint32_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+	{
+		SDL_Surface* pFrame = nullptr;
+		{
+			std::unique_lock<std::mutex> lock{ mutex };
+			condition.wait(lock, [&]() { return finishedFrames[jobIndex] != nullptr; });
+			pFrame = finishedFrames[jobIndex];
+		}
+
+		{
+			ELITE_PROFILE_SCOPE("OnFrame");
+			onFrame(jobIndex, pFrame, finishedStatistics[jobIndex]);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			finishedWorkers[jobIndex]->freeFrames.push_back(pFrame);
+		}
+		condition.notify_all();
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void Elite::BatchRenderer::RenderJob(Worker& worker, const Elite::RenderJob& job, SDL_Surface* pFrame) const
+{
+	ELITE_PROFILE_SCOPE("BatchRenderer::RenderJob");
+	RasterContext& context = worker.context;
+	context.worldToView = job.worldToView;
+	context.projection = job.projection;
+	context.world = job.world;
+	context.instances = job.instances;
+	context.cull = job.cull;
+	context.renderTransparent = job.renderTransparent;
+	context.pRenderPixels = (uint32_t*)pFrame->pixels;
+
+	if (context.pFrameBuffer->GetDepthFormat() != job.depthFormat)
+		context.pFrameBuffer->SetDepthFormat(job.depthFormat);
+
+	if (job.shadingRateMode != context.shadingRateMode)
+	{
+		context.shadingRateMode = job.shadingRateMode;
+		context.shadingRateMap.Fill((job.shadingRateMode == ShadingRateMode::fixed) ? ShadingRate::rate2x2 : ShadingRate::rate1x1);
+	}
+
+	SDL_LockSurface(pFrame);
+	m_Backend.RenderFrame(context);
+	SDL_UnlockSurface(pFrame);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "SoftwareBackend.h"
+
+struct SDL_Surface;
+
+namespace Elite
+{
+	//One frame of a batch, the camera is passed as matrices so jobs never share a Camera
+	struct RenderJob
+	{
+		FMatrix4 worldToView;
+		FMatrix4 projection;
+		FMatrix4 world;
+		std::vector<InstanceData> instances;
+		CullMode cull;
+		ShadingRateMode shadingRateMode;
+		DepthFormat depthFormat;
+		bool renderTransparent;
+	};
+
+	//Renders many frames of the software backend's meshes concurrently, every thread has its own frame buffers
+	class BatchRenderer final
+	{
+	public:
+		//0 threads uses every core
+		BatchRenderer(const SoftwareBackend& backend, uint32_t width, uint32_t height, uint32_t amountOfThreads = 0);
+		~BatchRenderer();
+
+		BatchRenderer(const BatchRenderer&) = delete;
+		BatchRenderer(BatchRenderer&&) noexcept = delete;
+		BatchRenderer& operator=(const BatchRenderer&) = delete;
+		BatchRenderer& operator=(BatchRenderer&&) noexcept = delete;
+
+		//Finished frames are handed to onFrame in job order on the calling thread, the surface is reused once onFrame returns
+		//Adaptive shading rates are built from the previous frame the same thread rendered
+		void Render(const std::vector<RenderJob>& jobs, const std::function<void(uint32_t jobIndex, SDL_Surface* pFrame, const FrameStatistics& statistics)>& onFrame);
+
+		//Counts overwritten fragments, covered pixels & overdraw for every job
+		void SetPixelStatistics(bool isEnabled);
+
+		uint32_t GetAmountOfThreads() const { return uint32_t(m_pWorkers.size()); };
+
+	private:
+		struct Worker
+		{
+			RasterContext context;
+			std::vector<SDL_Surface*> frames;
+			std::deque<SDL_Surface*> freeFrames;
+		};
+
+		void RenderJob(Worker& worker, const Elite::RenderJob& job, SDL_Surface* pFrame) const;
+
+		const SoftwareBackend& m_Backend;
+		uint32_t m_Width;
+		uint32_t m_Height;
+		std::vector<Worker*> m_pWorkers;
+	};
+}
@@ -0,0 +1,581 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	//Z of the two sided 99% confidence interval
+	const double ConfidenceZ = 2.576;
+	//Stages that take less of the frame than this are too noisy to compare
+	const double MinStageFraction = 0.02;
+
+	struct StatisticsField
+	{
+		const char* pName;
+		uint64_t Elite::FrameStatistics::* pCount;
+	};
+
+	const StatisticsField StatisticsFields[]
+	{
+		{ "instances", &Elite::FrameStatistics::instances },
+		{ "meshletsTested", &Elite::FrameStatistics::meshletsTested },
+		{ "meshletsCulled", &Elite::FrameStatistics::meshletsCulled },
+		{ "trianglesTested", &Elite::FrameStatistics::trianglesTested },
+		{ "trianglesFrustumCulled", &Elite::FrameStatistics::trianglesFrustumCulled },
+		{ "trianglesBackFaceCulled", &Elite::FrameStatistics::trianglesBackFaceCulled },
+		{ "trianglesRasterized", &Elite::FrameStatistics::trianglesRasterized },
+		{ "fragmentsTested", &Elite::FrameStatistics::fragmentsTested },
+		{ "fragmentsPassed", &Elite::FrameStatistics::fragmentsPassed },
+		{ "shadingInvocations", &Elite::FrameStatistics::shadingInvocations },
+		{ "fragmentsOverwritten", &Elite::FrameStatistics::fragmentsOverwritten },
+		{ "pixelsCovered", &Elite::FrameStatistics::pixelsCovered },
+		{ "pixels", &Elite::FrameStatistics::pixels }
+	};
+
+	struct TimeSummary
+	{
+		double mean;
+		double p50;
+		double p95;
+		double p99;
+		double max;
+	};
+
+	TimeSummary GetTimeSummary(std::vector<double> times)
+	{
+		if (times.empty())
+			return TimeSummary{};
+
+		//Nearest rank, like the timer's percentiles
+		std::sort(times.begin(), times.end());
+		auto getPercentile = [&times](double fraction)
+		{
+			const size_t rank = size_t(std::ceil(fraction * double(times.size())));
+			return times[std::min(std::max(rank, size_t(1)), times.size()) - 1];
+		};
+
+		double sum = 0.0;
+		for (double time : times)
+			sum += time;
+		return TimeSummary{ sum / double(times.size()), getPercentile(0.5), getPercentile(0.95), getPercentile(0.99), times.back() };
+	}
+
+	//Geometric mean of the per frame ratios result / baseline with its confidence interval
+	struct TimeChange
+	{
+		bool isValid;
+		double ratio;
+		double lower;
+		double upper;
+	};
+
+	TimeChange GetTimeChange(const std::vector<double>& baseline, const std::vector<double>& result)
+	{
+		//Frames in which either run did not time the stage can not be paired
+		std::vector<double> logRatios{};
+		for (size_t i = 0; i < std::min(baseline.size(), result.size()); ++i)
+		{
+			if (baseline[i] > 0.0 && result[i] > 0.0)
+				logRatios.push_back(std::log(result[i] / baseline[i]));
+		}
+		if (logRatios.size() < 2)
+			return TimeChange{};
+
+		double mean = 0.0;
+		for (double logRatio : logRatios)
+			mean += logRatio;
+		mean /= double(logRatios.size());
+
+		double variance = 0.0;
+		for (double logRatio : logRatios)
+			variance += (logRatio - mean) * (logRatio - mean);
+		variance /= double(logRatios.size() - 1);
+
+		const double margin = ConfidenceZ * std::sqrt(variance / double(logRatios.size()));
+		return TimeChange{ true, std::exp(mean), std::exp(mean - margin), std::exp(mean + margin) };
+	}
+
+	std::string ToHex(uint64_t value)
+	{
+		std::ostringstream stream{};
+		stream << std::hex << std::setw(16) << std::setfill('0') << value;
+		return stream.str();
+	}
+
+	std::string FormatMilliseconds(double milliseconds)
+	{
+		std::ostringstream stream{};
+		stream << std::fixed << std::setprecision(3) << milliseconds;
+		return stream.str();
+	}
+
+	void WriteJsonArray(std::ostream& stream, const std::vector<double>& values)
+	{
+		stream << '[';
+		for (size_t i = 0; i < values.size(); ++i)
+			stream << (i == 0 ? "" : ", ") << values[i];
+		stream << ']';
+	}
+
+	//Flattens nested objects into dotted names, { "a": { "b": 1 } } becomes "a.b", arrays may only hold numbers
+	struct JsonReader
+	{
+		explicit JsonReader(const std::string& text)
+			: text{ text }
+			, position{ 0 }
+			, values{}
+			, arrays{}
+		{
+		}
+
+		const std::string& text;
+		size_t position;
+		std::map<std::string, std::string> values;
+		std::map<std::string, std::vector<double>> arrays;
+
+		void SkipWhitespace()
+		{
+			while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position])))
+				++position;
+		}
+
+		bool Consume(char c)
+		{
+			SkipWhitespace();
+			if (position >= text.size() || text[position] != c)
+				return false;
+			++position;
+			return true;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			if (!Consume('"'))
+				return false;
+			value.clear();
+			while (position < text.size() && text[position] != '"')
+			{
+				if (text[position] == '\\')
+					++position;
+				if (position < text.size())
+					value += text[position++];
+			}
+			return Consume('"');
+		}
+
+		//Numbers, true, false & null are kept as their text
+		bool ReadScalar(std::string& value)
+		{
+			SkipWhitespace();
+			const size_t start = position;
+			while (position < text.size() && (std::isalnum(static_cast<unsigned char>(text[position])) || text[position] == '-' || text[position] == '+' || text[position] == '.'))
+				++position;
+			value = text.substr(start, position - start);
+			return !value.empty();
+		}
+
+		bool ReadValue(const std::string& name)
+		{
+			SkipWhitespace();
+			if (position >= text.size())
+				return false;
+
+			if (Consume('{'))
+			{
+				if (Consume('}'))
+					return true;
+				do
+				{
+					std::string member{};
+					if (!ReadString(member) || !Consume(':') || !ReadValue(name.empty() ? member : name + "." + member))
+						return false;
+				} while (Consume(','));
+				return Consume('}');
+			}
+
+			if (Consume('['))
+			{
+				std::vector<double>& array = arrays[name];
+				if (Consume(']'))
+					return true;
+				do
+				{
+					std::string number{};
+					if (!ReadScalar(number))
+						return false;
+					array.push_back(std::atof(number.c_str()));
+				} while (Consume(','));
+				return Consume(']');
+			}
+
+			std::string value{};
+			if (!((text[position] == '"') ? ReadString(value) : ReadScalar(value)))
+				return false;
+			values[name] = value;
+			return true;
+		}
+	};
+}
+
+bool Elite::LoadBenchmarkSettings(const std::string& filePath, BenchmarkSettings& settings)
+{
+	std::ifstream file{ filePath };
+	if (!file)
+	{
+		std::cout << "Benchmark: could not read " << filePath << "\n";
+		return false;
+	}
+
+	settings = BenchmarkSettings{};
+	settings.width = 640;
+	settings.height = 480;
+	settings.fov = 45.f;
+	settings.frames = 300;
+	settings.warmupFrames = 10;
+	settings.timestep = 1.f / 60.f;
+	settings.instances = 1;
+	settings.renderTransparent = false;
+	settings.isOcclusionCulling = true;
+	settings.isMeshletOcclusion = true;
+	settings.shadingRateMode = ShadingRateMode::full;
+	settings.depthFormat = DepthFormat::float32;
+	settings.hash = HashSeed;
+
+	std::string line{};
+	uint32_t lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+		settings.hash = HashBytes(line.data(), line.size(), settings.hash);
+		settings.hash = HashBytes("\n", 1, settings.hash);
+
+		std::istringstream stream{ line.substr(0, line.find('#')) };
+		std::string name{};
+		if (!(stream >> name))
+			continue;
+
+		auto readBool = [&stream](bool& value)
+		{
+			int number = 0;
+			if (!(stream >> number))
+				return false;
+			value = (number != 0);
+			return true;
+		};
+
+		bool isValid = true;
+		std::string mode{};
+		if (name == "width")
+			isValid = bool(stream >> settings.width) && settings.width > 0;
+		else if (name == "height")
+			isValid = bool(stream >> settings.height) && settings.height > 0;
+		else if (name == "fov")
+			isValid = bool(stream >> settings.fov);
+		else if (name == "frames")
+			isValid = bool(stream >> settings.frames) && settings.frames > 0;
+		else if (name == "warmup")
+			isValid = bool(stream >> settings.warmupFrames);
+		else if (name == "timestep")
+			isValid = bool(stream >> settings.timestep);
+		else if (name == "instances")
+			isValid = bool(stream >> settings.instances) && settings.instances > 0;
+		else if (name == "fire")
+			isValid = readBool(settings.renderTransparent);
+		else if (name == "occlusion")
+			isValid = readBool(settings.isOcclusionCulling);
+		else if (name == "meshletOcclusion")
+			isValid = readBool(settings.isMeshletOcclusion);
+		else if (name == "shading")
+		{
+			isValid = bool(stream >> mode);
+			if (mode == "full")
+				settings.shadingRateMode = ShadingRateMode::full;
+			else if (mode == "fixed")
+				settings.shadingRateMode = ShadingRateMode::fixed;
+			else if (mode == "adaptive")
+				settings.shadingRateMode = ShadingRateMode::adaptive;
+			else
+				isValid = false;
+		}
+		else if (name == "depth")
+		{
+			isValid = bool(stream >> mode);
+			if (mode == "float32")
+				settings.depthFormat = DepthFormat::float32;
+			else if (mode == "reversed")
+				settings.depthFormat = DepthFormat::reversedFloat32;
+			else if (mode == "unorm24")
+				settings.depthFormat = DepthFormat::unorm24;
+			else if (mode == "unorm16")
+				settings.depthFormat = DepthFormat::unorm16;
+			else
+				isValid = false;
+		}
+		else if (name == "camera")
+		{
+			CameraKey key{};
+			isValid = bool(stream >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.pitch >> key.yaw);
+			settings.cameraPath.push_back(key);
+		}
+		else if (name == "rotation")
+		{
+			RotationKey key{};
+			isValid = bool(stream >> key.time >> key.angle);
+			settings.rotationPath.push_back(key);
+		}
+		else
+			isValid = false;
+
+		if (!isValid)
+		{
+			std::cout << "Benchmark: " << filePath << " line " << lineNumber << " is not a valid setting: " << line << "\n";
+			return false;
+		}
+	}
+
+	std::stable_sort(settings.cameraPath.begin(), settings.cameraPath.end(), [](const CameraKey& a, const CameraKey& b) { return a.time < b.time; });
+	std::stable_sort(settings.rotationPath.begin(), settings.rotationPath.end(), [](const RotationKey& a, const RotationKey& b) { return a.time < b.time; });
+	return true;
+}
+
+Elite::CameraKey Elite::GetCameraPose(const std::vector<CameraKey>& path, float time)
+{
+	if (path.empty())
+		return CameraKey{ time, FPoint3{}, 0.f, 0.f };
+	if (time <= path.front().time)
+		return path.front();
+
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		if (time < path[i].time)
+		{
+			const CameraKey& from = path[i - 1];
+			const CameraKey& to = path[i];
+			const float t = (time - from.time) / (to.time - from.time);
+			return CameraKey{ time, from.position + (to.position - from.position) * t, Lerp(from.pitch, to.pitch, t), Lerp(from.yaw, to.yaw, t) };
+		}
+	}
+	return path.back();
+}
+
+float Elite::GetWorldRotation(const std::vector<RotationKey>& path, float time)
+{
+	if (path.empty())
+		return 0.f;
+	if (time <= path.front().time)
+		return path.front().angle;
+
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		if (time < path[i].time)
+		{
+			const RotationKey& from = path[i - 1];
+			const RotationKey& to = path[i];
+			return Lerp(from.angle, to.angle, (time - from.time) / (to.time - from.time));
+		}
+	}
+	return path.back().angle;
+}
+
+bool Elite::WriteBenchmarkResult(const std::string& filePath, const BenchmarkResult& result)
+{
+	std::ofstream file{ filePath };
+	if (!file)
+	{
+		std::cout << "Benchmark: could not write " << filePath << "\n";
+		return false;
+	}
+
+	const TimeSummary frameTime = GetTimeSummary(result.frameTimes);
+	file << std::fixed << std::setprecision(4);
+	file << "{\n\t\"settings\": ";
+	WriteJsonString(file, result.settingsPath);
+	file << ",\n\t\"settingsHash\": \"" << ToHex(result.settingsHash) << "\""
+		<< ",\n\t\"width\": " << result.width
+		<< ",\n\t\"height\": " << result.height
+		<< ",\n\t\"frames\": " << result.frameTimes.size()
+		<< ",\n\t\"profiled\": " << (result.isProfiled ? "true" : "false")
+		<< ",\n\t\"imageHash\": \"" << ToHex(result.imageHash) << "\""
+		<< ",\n\t\"frameTime\": { \"mean\": " << frameTime.mean << ", \"p50\": " << frameTime.p50 << ", \"p95\": " << frameTime.p95
+		<< ", \"p99\": " << frameTime.p99 << ", \"max\": " << frameTime.max << " }";
+
+	//Summaries are for reading, compare only uses the per frame times below
+	file << ",\n\t\"stages\": {";
+	bool isFirst = true;
+	for (const std::pair<const std::string, std::vector<double>>& stage : result.stageTimes)
+	{
+		const TimeSummary summary = GetTimeSummary(stage.second);
+		const auto calls = result.stageCalls.find(stage.first);
+		file << (isFirst ? "\n\t\t" : ",\n\t\t");
+		WriteJsonString(file, stage.first);
+		file << ": { \"calls\": " << ((calls != result.stageCalls.end()) ? calls->second : 0) << ", \"mean\": " << summary.mean
+			<< ", \"p50\": " << summary.p50 << ", \"p95\": " << summary.p95 << ", \"max\": " << summary.max << " }";
+		isFirst = false;
+	}
+	file << (isFirst ? "}" : "\n\t}");
+
+	file << ",\n\t\"statistics\": {";
+	for (size_t i = 0; i < sizeof(StatisticsFields) / sizeof(StatisticsFields[0]); ++i)
+		file << (i == 0 ? "\n\t\t\"" : ",\n\t\t\"") << StatisticsFields[i].pName << "\": " << result.statistics.*StatisticsFields[i].pCount;
+	file << "\n\t}";
+
+	file << ",\n\t\"frameTimes\": ";
+	WriteJsonArray(file, result.frameTimes);
+	file << ",\n\t\"stageTimes\": {";
+	isFirst = true;
+	for (const std::pair<const std::string, std::vector<double>>& stage : result.stageTimes)
+	{
+		file << (isFirst ? "\n\t\t" : ",\n\t\t");
+		WriteJsonString(file, stage.first);
+		file << ": ";
+		WriteJsonArray(file, stage.second);
+		isFirst = false;
+	}
+	file << (isFirst ? "}" : "\n\t}") << "\n}\n";
+
+	std::cout << "Benchmark: wrote " << filePath << "\n";
+	return bool(file);
+}
+
+bool Elite::ReadBenchmarkResult(const std::string& filePath, BenchmarkResult& result)
+{
+	std::ifstream file{ filePath };
+	if (!file)
+	{
+		std::cout << "Benchmark: could not read " << filePath << "\n";
+		return false;
+	}
+
+	std::ostringstream contents{};
+	contents << file.rdbuf();
+	const std::string text = contents.str();
+	JsonReader reader{ text };
+	if (!reader.ReadValue("") || reader.arrays.find("frameTimes") == reader.arrays.end())
+	{
+		std::cout << "Benchmark: " << filePath << " is not a benchmark result\n";
+		return false;
+	}
+
+	auto getValue = [&reader](const std::string& name)
+	{
+		const auto value = reader.values.find(name);
+		return (value != reader.values.end()) ? value->second : std::string{};
+	};
+
+	result = BenchmarkResult{};
+	result.settingsPath = getValue("settings");
+	result.settingsHash = std::strtoull(getValue("settingsHash").c_str(), nullptr, 16);
+	result.width = uint32_t(std::strtoul(getValue("width").c_str(), nullptr, 10));
+	result.height = uint32_t(std::strtoul(getValue("height").c_str(), nullptr, 10));
+	result.isProfiled = (getValue("profiled") == "true");
+	result.imageHash = std::strtoull(getValue("imageHash").c_str(), nullptr, 16);
+	result.frameTimes = reader.arrays["frameTimes"];
+
+	const std::string stagePrefix = "stageTimes.";
+	for (const std::pair<const std::string, std::vector<double>>& array : reader.arrays)
+	{
+		if (array.first.compare(0, stagePrefix.size(), stagePrefix) != 0)
+			continue;
+		const std::string name = array.first.substr(stagePrefix.size());
+		result.stageTimes[name] = array.second;
+		result.stageCalls[name] = std::strtoull(getValue("stages." + name + ".calls").c_str(), nullptr, 10);
+	}
+
+	for (const StatisticsField& field : StatisticsFields)
+		result.statistics.*field.pCount = std::strtoull(getValue(std::string{ "statistics." } + field.pName).c_str(), nullptr, 10);
+	return true;
+}
+
+void Elite::PrintBenchmarkResult(const BenchmarkResult& result, std::ostream& stream)
+{
+	const TimeSummary frameTime = GetTimeSummary(result.frameTimes);
+	stream << "Benchmark: " << result.frameTimes.size() << " frame(s) at " << result.width << "x" << result.height
+		<< ", image hash " << ToHex(result.imageHash) << "\n";
+	stream << "Benchmark: frame ms mean " << FormatMilliseconds(frameTime.mean) << ", p50 " << FormatMilliseconds(frameTime.p50) << ", p95 " << FormatMilliseconds(frameTime.p95)
+		<< ", p99 " << FormatMilliseconds(frameTime.p99) << ", max " << FormatMilliseconds(frameTime.max) << "\n";
+
+	//Self times of the worker threads are added up, so stages can add up to more than the frame
+	std::vector<std::pair<std::string, TimeSummary>> stages{};
+	for (const std::pair<const std::string, std::vector<double>>& stage : result.stageTimes)
+		stages.push_back({ stage.first, GetTimeSummary(stage.second) });
+	std::sort(stages.begin(), stages.end(), [](const std::pair<std::string, TimeSummary>& a, const std::pair<std::string, TimeSummary>& b)
+	{
+		return a.second.mean > b.second.mean;
+	});
+	for (const std::pair<std::string, TimeSummary>& stage : stages)
+	{
+		stream << "Benchmark: " << std::left << std::setw(28) << stage.first << std::right << " self ms mean " << FormatMilliseconds(stage.second.mean)
+			<< ", p50 " << FormatMilliseconds(stage.second.p50) << ", p95 " << FormatMilliseconds(stage.second.p95) << "\n";
+	}
+}
+
+bool Elite::CompareBenchmarkResults(const BenchmarkResult& baseline, const BenchmarkResult& result, float threshold, std::ostream& stream)
+{
+	if (baseline.frameTimes.size() != result.frameTimes.size())
+	{
+		stream << "Compare: the baseline has " << baseline.frameTimes.size() << " frame(s) & this run " << result.frameTimes.size() << ", they can not be paired\n";
+		return false;
+	}
+	if (baseline.settingsHash != result.settingsHash)
+		stream << "Compare: warning, the runs used different settings files\n";
+	if (baseline.isProfiled != result.isProfiled)
+		stream << "Compare: warning, only one of the runs was profiled, its frame times include the profiler\n";
+
+	uint32_t amountOfRegressions = 0;
+	auto compare = [&](const std::string& name, const std::vector<double>& baselineTimes, const std::vector<double>& resultTimes)
+	{
+		const TimeChange change = GetTimeChange(baselineTimes, resultTimes);
+		if (!change.isValid)
+			return;
+
+		const char* pVerdict = "unchanged";
+		if (change.lower > 1.0 && change.ratio > 1.0 + threshold)
+		{
+			pVerdict = "REGRESSION";
+			++amountOfRegressions;
+		}
+		else if (change.upper < 1.0 && change.ratio < 1.0 - threshold)
+			pVerdict = "faster";
+		else if (change.lower > 1.0)
+			pVerdict = "slower, within the threshold";
+		else if (change.upper < 1.0)
+			pVerdict = "faster, within the threshold";
+
+		std::ostringstream ratio{};
+		ratio << std::fixed << std::setprecision(3) << "x" << change.ratio << " [" << change.lower << ", " << change.upper << "]";
+		stream << "Compare: " << std::left << std::setw(28) << name << std::right << " p50 " << FormatMilliseconds(GetTimeSummary(baselineTimes).p50)
+			<< " -> " << FormatMilliseconds(GetTimeSummary(resultTimes).p50) << " ms, " << ratio.str() << " " << pVerdict << "\n";
+	};
+
+	compare("frame", baseline.frameTimes, result.frameTimes);
+	if (baseline.isProfiled && result.isProfiled)
+	{
+		const double minStageTime = GetTimeSummary(baseline.frameTimes).mean * MinStageFraction;
+		for (const std::pair<const std::string, std::vector<double>>& stage : result.stageTimes)
+		{
+			const auto baselineStage = baseline.stageTimes.find(stage.first);
+			if (baselineStage == baseline.stageTimes.end())
+				stream << "Compare: " << stage.first << " is new\n";
+			else if (GetTimeSummary(baselineStage->second).mean >= minStageTime)
+				compare(stage.first, baselineStage->second, stage.second);
+		}
+	}
+
+	if (baseline.imageHash != result.imageHash)
+		stream << "Compare: the image hash changed from " << ToHex(baseline.imageHash) << " to " << ToHex(result.imageHash) << "\n";
+	for (const StatisticsField& field : StatisticsFields)
+	{
+		const uint64_t from = baseline.statistics.*field.pCount;
+		const uint64_t to = result.statistics.*field.pCount;
+		if (from != to)
+			stream << "Compare: " << field.pName << " changed from " << from << " to " << to << "\n";
+	}
+
+	stream << "Compare: " << amountOfRegressions << " regression(s) of more than " << threshold * 100.f << "% at 99% confidence\n";
+	return amountOfRegressions == 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "EMath.h"
+#include "EHelper.h"
+#include "FrameStatistics.h"
+
+namespace Elite
+{
+	//Camera pose at a time of the benchmark, pitch & yaw in degrees like the camera's mouse rotation
+	struct CameraKey
+	{
+		float time;
+		FPoint3 position;
+		float pitch;
+		float yaw;
+	};
+
+	//World rotation around y at a time of the benchmark, in degrees
+	struct RotationKey
+	{
+		float time;
+		float angle;
+	};
+
+	//Everything a benchmark run depends on, frames only differ in the time along the paths
+	struct BenchmarkSettings
+	{
+		uint32_t width;
+		uint32_t height;
+		float fov;
+		uint32_t frames;
+		uint32_t warmupFrames;
+		float timestep;
+
+		uint32_t instances;
+		bool renderTransparent;
+		bool isOcclusionCulling;
+		bool isMeshletOcclusion;
+		ShadingRateMode shadingRateMode;
+		DepthFormat depthFormat;
+
+		std::vector<CameraKey> cameraPath;
+		std::vector<RotationKey> rotationPath;
+
+		//Hash of the settings file, results of different files are not compared
+		uint64_t hash;
+	};
+
+	//One setting per line, its name followed by its values, # starts a comment
+	//Settings that are not in the file keep their defaults, unknown names are an error
+	bool LoadBenchmarkSettings(const std::string& filePath, BenchmarkSettings& settings);
+
+	//Keys are interpolated linearly in time, before the first & after the last key their pose is held
+	CameraKey GetCameraPose(const std::vector<CameraKey>& path, float time);
+	float GetWorldRotation(const std::vector<RotationKey>& path, float time);
+
+	//Measurements of one run, times are in milliseconds per measured frame
+	struct BenchmarkResult
+	{
+		std::string settingsPath;
+		uint64_t settingsHash;
+		uint32_t width;
+		uint32_t height;
+		bool isProfiled;
+		uint64_t imageHash;
+		std::vector<double> frameTimes;
+		//Self time of every profiled zone per frame, 0 in frames it did not run
+		std::map<std::string, std::vector<double>> stageTimes;
+		std::map<std::string, uint64_t> stageCalls;
+		//Counters of all measured frames added up
+		FrameStatistics statistics;
+	};
+
+	bool WriteBenchmarkResult(const std::string& filePath, const BenchmarkResult& result);
+	//Only reads the JSON that WriteBenchmarkResult writes
+	bool ReadBenchmarkResult(const std::string& filePath, BenchmarkResult& result);
+	void PrintBenchmarkResult(const BenchmarkResult& result, std::ostream& stream);
+
+	//Frames of both runs are paired, a measurement regressed when it is significantly slower (99% confidence)
+	//& the geometric mean of the per frame ratios is more than threshold (a fraction) slower
+	//Returns false when anything regressed, a changed image hash or changed counters are only reported
+	bool CompareBenchmarkResults(const BenchmarkResult& baseline, const BenchmarkResult& result, float threshold, std::ostream& stream);
+}
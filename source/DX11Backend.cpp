@@ -0,0 +1,204 @@
+#include "pch.h"
+#ifdef ELITE_BACKEND_DX11
+#include "DX11Backend.h"
+#include "Mesh.h"
+#include "Profiler.h"
+
+Elite::DX11Backend::DX11Backend(SDL_Window* pWindow, uint32_t width, uint32_t height)
+	: m_pDevice{ nullptr }
+	, m_pDeviceContext{ nullptr }
+	, m_pDXGIFactory{ nullptr }
+	, m_pSwapChain{ nullptr }
+	, m_pDepthStencilBuffer{ nullptr }
+	, m_pDepthStencilView{ nullptr }
+	, m_pRenderTargetBuffer{ nullptr }
+	, m_pRenderTargetView{ nullptr }
+	, m_IsInitialized{ false }
+	, m_pWindow{ pWindow }
+	, m_Width{ width }
+	, m_Height{ height }
+{
+	//Initialize DirectX pipeline
+	m_IsInitialized = SUCCEEDED(InitializeDirectX());
+}
+
+Elite::DX11Backend::~DX11Backend()
+{
+	if (m_pDeviceContext)
+	{
+		m_pDeviceContext->ClearState();
+		m_pDeviceContext->Flush();
+		m_pDeviceContext->Release();
+	}
+
+	if (m_pRenderTargetView)
+	{
+		m_pRenderTargetView->Release();
+	}
+	if (m_pRenderTargetBuffer)
+	{
+		m_pRenderTargetBuffer->Release();
+	}
+	if (m_pDepthStencilView)
+	{
+		m_pDepthStencilView->Release();
+	}
+	if (m_pDepthStencilBuffer)
+	{
+		m_pDepthStencilBuffer->Release();
+	}
+	if (m_pSwapChain)
+	{
+		m_pSwapChain->Release();
+	}
+	if (m_pDevice)
+	{
+		m_pDevice->Release();
+	}
+	if (m_pDXGIFactory)
+	{
+		m_pDXGIFactory->Release();
+	}
+
+	for (Mesh* pMesh : m_pMeshes)
+		delete pMesh;
+	m_pMeshes.clear();
+}
+
+void Elite::DX11Backend::AddMesh(const MeshData& mesh)
+{
+	m_pMeshes.push_back(new Mesh(m_pDevice, mesh.lods, mesh.isTransparent));
+	m_MeshIsTransparent.push_back(mesh.isTransparent);
+}
+
+void Elite::DX11Backend::SetCamera(Camera* pCamera)
+{
+	for (Mesh* pMesh : m_pMeshes)
+		pMesh->SetCamera(pCamera);
+}
+
+void Elite::DX11Backend::Update(float dT, const PipelineState& state)
+{
+	for (Mesh* pMesh : m_pMeshes)
+		pMesh->Update(dT, state.world);
+}
+
+void Elite::DX11Backend::Render(const PipelineState& state)
+{
+	ELITE_PROFILE_SCOPE("DX11Backend::Render");
+	if (!m_IsInitialized)
+		return;
+
+	//Clear Buffers
+	RGBColor clearColor = RGBColor(0.1f, 0.1f, 0.1f);
+	m_pDeviceContext->ClearRenderTargetView(m_pRenderTargetView, &clearColor.r);
+	m_pDeviceContext->ClearDepthStencilView(m_pDepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+
+	//Render
+	for (size_t i = 0; i < m_pMeshes.size(); ++i)
+	{
+		if (!m_MeshIsTransparent[i] || state.renderTransparent)
+			m_pMeshes[i]->Render(m_pDeviceContext, state.filter, state.cull, state.world, state.instances);
+	}
+
+	//Present
+	ELITE_PROFILE_SCOPE("Present");
+	m_pSwapChain->Present(0, 0);
+}
+
+HRESULT Elite::DX11Backend::InitializeDirectX()
+{
+	//Create device & device context using hardware acceleration
+	D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+	uint32_t createDeviceFlags = 0;
+#if defined(DEBUG) || defined(_DEBUG)
+	createDeviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+	HRESULT result = D3D11CreateDevice(0, D3D_DRIVER_TYPE_HARDWARE, 0, createDeviceFlags, 0, 0, D3D11_SDK_VERSION, &m_pDevice, &featureLevel, &m_pDeviceContext);
+
+	//Create DGXI Factory to create Swapchain based on hardware
+	result = CreateDXGIFactory(__uuidof(IDXGIFactory), reinterpret_cast<void**>(&m_pDXGIFactory));
+	if (FAILED(result))
+		return result;
+
+	//Create Swapchain Descriptor
+	DXGI_SWAP_CHAIN_DESC swapChainDesc{};
+	swapChainDesc.BufferDesc.Width = m_Width;
+	swapChainDesc.BufferDesc.Height = m_Height;
+	swapChainDesc.BufferDesc.RefreshRate.Numerator = 1;
+	swapChainDesc.BufferDesc.RefreshRate.Denominator = 60;
+	swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	swapChainDesc.BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
+	swapChainDesc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
+	swapChainDesc.SampleDesc.Count = 1;
+	swapChainDesc.SampleDesc.Quality = 0;
+	swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+	swapChainDesc.BufferCount = 1;
+	swapChainDesc.Windowed = true;
+	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
+	swapChainDesc.Flags = 0;
+
+	//Get the handle HWMD from the SDL backbuffer
+	SDL_SysWMinfo sysWMInfo{};
+	SDL_VERSION(&sysWMInfo.version);
+	SDL_GetWindowWMInfo(m_pWindow, &sysWMInfo);
+	swapChainDesc.OutputWindow = sysWMInfo.info.win.window;
+
+	//Create Swapchain and hook it into the handle of the SDL winwow
+	if(m_pDevice)
+		result = m_pDXGIFactory->CreateSwapChain(m_pDevice, &swapChainDesc, &m_pSwapChain);
+	if (FAILED(result))
+		return result;
+
+	//Create the Depth/Stencil Buffer and View
+	D3D11_TEXTURE2D_DESC depthStencilDesc{};
+	depthStencilDesc.Width = m_Width;
+	depthStencilDesc.Height = m_Height;
+	depthStencilDesc.MipLevels = 1;
+	depthStencilDesc.ArraySize = 1;
+	depthStencilDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
+	depthStencilDesc.SampleDesc.Count = 1;
+	depthStencilDesc.SampleDesc.Quality = 0;
+	depthStencilDesc.Usage = D3D11_USAGE_DEFAULT;
+	depthStencilDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
+	depthStencilDesc.CPUAccessFlags = 0;
+	depthStencilDesc.MiscFlags = 0;
+
+	D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc{};
+	depthStencilViewDesc.Format = depthStencilDesc.Format;
+	depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+	depthStencilViewDesc.Texture2D.MipSlice = 0;
+
+	result = m_pDevice->CreateTexture2D(&depthStencilDesc, 0, &m_pDepthStencilBuffer);
+	if (FAILED(result))
+		return result;
+
+	result = m_pDevice->CreateDepthStencilView(m_pDepthStencilBuffer, &depthStencilViewDesc, &m_pDepthStencilView);
+	if (FAILED(result))
+		return result;
+
+	//Create the RenderTargetView
+	result = m_pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&m_pRenderTargetBuffer));
+	if (FAILED(result))
+		return result;
+
+	result = m_pDevice->CreateRenderTargetView(m_pRenderTargetBuffer, 0, &m_pRenderTargetView);
+	if (FAILED(result))
+		return result;
+
+	//Bind the Views to the Output Merger Stage
+	m_pDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, m_pDepthStencilView);
+
+	//Set the Viewport
+	D3D11_VIEWPORT viewPort{};
+	viewPort.Width = static_cast<float>(m_Width);
+	viewPort.Height = static_cast<float>(m_Height);
+	viewPort.TopLeftX = 0.f;
+	viewPort.TopLeftY = 0.f;
+	viewPort.MinDepth = 0.f;
+	viewPort.MaxDepth = 1.f;
+	m_pDeviceContext->RSSetViewports(1, &viewPort);
+
+	return result;
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#ifdef ELITE_BACKEND_DX11
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+struct SDL_Window;
+
+class Mesh;
+
+namespace Elite
+{
+	//Direct3D 11 rendering into a swap chain hooked to the SDL window
+	class DX11Backend final : public RenderBackend
+	{
+	public:
+		DX11Backend(SDL_Window* pWindow, uint32_t width, uint32_t height);
+		~DX11Backend();
+
+		void AddMesh(const MeshData& mesh) override;
+		void SetCamera(Camera* pCamera) override;
+
+		void Update(float dT, const PipelineState& state) override;
+		void Render(const PipelineState& state) override;
+		void Flush() override {};
+
+		bool IsInitialized() const { return m_IsInitialized; };
+
+	private:
+		//Directx11 Initalization
+		HRESULT InitializeDirectX();
+
+		ID3D11Device* m_pDevice;
+		ID3D11DeviceContext* m_pDeviceContext;
+		IDXGIFactory* m_pDXGIFactory;
+		IDXGISwapChain* m_pSwapChain;
+		ID3D11Texture2D* m_pDepthStencilBuffer;
+		ID3D11DepthStencilView* m_pDepthStencilView;
+		ID3D11Resource* m_pRenderTargetBuffer;
+		ID3D11RenderTargetView* m_pRenderTargetView;
+
+		bool m_IsInitialized;
+
+		SDL_Window* m_pWindow;
+		uint32_t m_Width;
+		uint32_t m_Height;
+
+		//Opaque meshes are always rendered, transparent ones only when the pipeline state asks for them
+		std::vector<Mesh*> m_pMeshes;
+		std::vector<bool> m_MeshIsTransparent;
+	};
+}
+#endif
@@ -0,0 +1,215 @@
+/*=============================================================================*/
+// Copyright 2019 Elite Engine 2.0
+// Authors: Matthieu Delaere
+/*=============================================================================*/
+// EBatch.h: Transforms, projections & normalizations of whole arrays of float points & vectors
+/*=============================================================================*/
+#ifndef ELITE_MATH_BATCH
+#define ELITE_MATH_BATCH
+
+#include <type_traits>
+#include "EMath.h"
+
+namespace Elite
+{
+	//=== STRIDED SPAN ===
+	//Elements that are spread over an array of bigger structs, like the positions of an array of vertices
+	//The stride is in bytes, by default the elements are packed
+	template<typename T>
+	struct StridedSpan
+	{
+		T* pFirst;
+		size_t count;
+		size_t stride;
+
+		StridedSpan(T* pFirst, size_t count, size_t stride = sizeof(T))
+			: pFirst{ pFirst }
+			, count{ count }
+			, stride{ stride }
+		{}
+
+		//A span of writable elements can always be read
+		template<typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+		StridedSpan(const StridedSpan<U>& span)
+			: pFirst{ span.pFirst }
+			, count{ span.count }
+			, stride{ span.stride }
+		{}
+
+		inline T& operator[](size_t i) const
+		{
+			using Byte = typename std::conditional<std::is_const<T>::value, const char, char>::type;
+			return *reinterpret_cast<T*>(reinterpret_cast<Byte*>(pFirst) + i * stride);
+		}
+	};
+
+	//=== BATCH OPERATIONS ===
+	//One matrix is applied to every element, its columns stay in registers for the whole array
+	//The output can be the input itself, every element is read before it is written
+	//Results are the same as the single element operators
+#pragma region BatchOperations
+	//out = m * point, like Matrix * Point the translation is added as if w is 1
+	inline void TransformPoints(const Matrix<4, 4, float>& m, const StridedSpan<const Point<4, float>>& points, const StridedSpan<Point<4, float>>& out)
+	{
+		assert(points.count <= out.count);
+#ifdef ELITE_SSE2
+		const __m128 c0 = _mm_loadu_ps(m.data[0]);
+		const __m128 c1 = _mm_loadu_ps(m.data[1]);
+		const __m128 c2 = _mm_loadu_ps(m.data[2]);
+		const __m128 c3 = _mm_loadu_ps(m.data[3]);
+		for (size_t i = 0; i < points.count; ++i)
+		{
+			const Point<4, float>& p = points[i];
+			__m128 r = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+			r = _mm_add_ps(r, c3);
+			_mm_storeu_ps(out[i].data, r);
+		}
+#else
+		Matrix<4, 4, float> matrix = m;
+		for (size_t i = 0; i < points.count; ++i)
+			out[i] = matrix * points[i];
+#endif
+	}
+
+	//out = (m * point).xyz as a vector from the origin of the space it is transformed to
+	//Subtracting a point through the translation of m gives the directions to that point
+	inline void TransformPoints(const Matrix<4, 4, float>& m, const StridedSpan<const Point<3, float>>& points, const StridedSpan<Vector<3, float>>& out)
+	{
+		assert(points.count <= out.count);
+#ifdef ELITE_SSE2
+		const __m128 c0 = _mm_loadu_ps(m.data[0]);
+		const __m128 c1 = _mm_loadu_ps(m.data[1]);
+		const __m128 c2 = _mm_loadu_ps(m.data[2]);
+		const __m128 c3 = _mm_loadu_ps(m.data[3]);
+		for (size_t i = 0; i < points.count; ++i)
+		{
+			const Point<3, float>& p = points[i];
+			__m128 r = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+			r = _mm_add_ps(r, c3);
+
+			float* pOut = out[i].data;
+			_mm_storel_pi(reinterpret_cast<__m64*>(pOut), r);
+			_mm_store_ss(pOut + 2, _mm_movehl_ps(r, r));
+		}
+#else
+		Matrix<4, 4, float> matrix = m;
+		for (size_t i = 0; i < points.count; ++i)
+		{
+			const Point<3, float>& p = points[i];
+			out[i] = Vector<3, float>((matrix * Point<4, float>{ p.x, p.y, p.z, 1.f }).xyz);
+		}
+#endif
+	}
+
+	//out = (m * vector).xyz, directions ignore the translation
+	inline void TransformVectors(const Matrix<4, 4, float>& m, const StridedSpan<const Vector<3, float>>& vectors, const StridedSpan<Vector<3, float>>& out)
+	{
+		assert(vectors.count <= out.count);
+#ifdef ELITE_SSE2
+		const __m128 c0 = _mm_loadu_ps(m.data[0]);
+		const __m128 c1 = _mm_loadu_ps(m.data[1]);
+		const __m128 c2 = _mm_loadu_ps(m.data[2]);
+		for (size_t i = 0; i < vectors.count; ++i)
+		{
+			const Vector<3, float>& v = vectors[i];
+			__m128 r = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+
+			float* pOut = out[i].data;
+			_mm_storel_pi(reinterpret_cast<__m64*>(pOut), r);
+			_mm_store_ss(pOut + 2, _mm_movehl_ps(r, r));
+		}
+#else
+		Matrix<4, 4, float> matrix = m;
+		for (size_t i = 0; i < vectors.count; ++i)
+		{
+			const Vector<3, float>& v = vectors[i];
+			out[i] = Vector<3, float>((matrix * Vector<4, float>{ v.x, v.y, v.z, 0.f }).xyz);
+		}
+#endif
+	}
+
+	//out = m * point with x, y & z divided by w, w is kept for perspective correct interpolation
+	inline void ProjectPoints(const Matrix<4, 4, float>& m, const StridedSpan<const Point<4, float>>& points, const StridedSpan<Point<4, float>>& out)
+	{
+		assert(points.count <= out.count);
+#ifdef ELITE_SSE2
+		const __m128 c0 = _mm_loadu_ps(m.data[0]);
+		const __m128 c1 = _mm_loadu_ps(m.data[1]);
+		const __m128 c2 = _mm_loadu_ps(m.data[2]);
+		const __m128 c3 = _mm_loadu_ps(m.data[3]);
+		for (size_t i = 0; i < points.count; ++i)
+		{
+			const Point<4, float>& p = points[i];
+			__m128 r = _mm_mul_ps(c0, _mm_set1_ps(p.x));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p.y)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p.z)));
+			r = _mm_add_ps(r, c3);
+
+			const __m128 w = _mm_shuffle_ps(r, r, 0xFF);
+			Point<4, float>& o = out[i];
+			_mm_storeu_ps(o.data, _mm_div_ps(r, w));
+			o.w = _mm_cvtss_f32(w);
+		}
+#else
+		Matrix<4, 4, float> matrix = m;
+		for (size_t i = 0; i < points.count; ++i)
+		{
+			Point<4, float> p = matrix * points[i];
+			p.x /= p.w;
+			p.y /= p.w;
+			p.z /= p.w;
+			out[i] = p;
+		}
+#endif
+	}
+
+	//Same as Normalize on every vector, vectors whose length AreEqual 0 become 0
+	inline void NormalizeVectors(const StridedSpan<Vector<3, float>>& vectors)
+	{
+		size_t i = 0;
+#ifdef ELITE_SSE2
+		//Four vectors at once, one register per component
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 smallest = _mm_set1_ps(std::numeric_limits<float>::min());
+		const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+		for (; i + 4 <= vectors.count; i += 4)
+		{
+			Vector<3, float>& v0 = vectors[i];
+			Vector<3, float>& v1 = vectors[i + 1];
+			Vector<3, float>& v2 = vectors[i + 2];
+			Vector<3, float>& v3 = vectors[i + 3];
+			__m128 x = _mm_set_ps(v3.x, v2.x, v1.x, v0.x);
+			__m128 y = _mm_set_ps(v3.y, v2.y, v1.y, v0.y);
+			__m128 z = _mm_set_ps(v3.z, v2.z, v1.z, v0.z);
+
+			const __m128 sqrMagnitude = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			const __m128 magnitude = _mm_sqrt_ps(sqrMagnitude);
+			//AreEqual(m, 0) holds below FLT_MIN & for an infinite m (its relative term), a NaN length stays NaN like in Normalize
+			const __m128 isNotZero = _mm_and_ps(_mm_cmpnlt_ps(magnitude, smallest), _mm_cmpneq_ps(magnitude, infinity));
+			const __m128 invMagnitude = _mm_div_ps(one, magnitude);
+			x = _mm_and_ps(_mm_mul_ps(x, invMagnitude), isNotZero);
+			y = _mm_and_ps(_mm_mul_ps(y, invMagnitude), isNotZero);
+			z = _mm_and_ps(_mm_mul_ps(z, invMagnitude), isNotZero);
+
+			alignas(16) float components[3][4];
+			_mm_store_ps(components[0], x);
+			_mm_store_ps(components[1], y);
+			_mm_store_ps(components[2], z);
+			v0 = Vector<3, float>(components[0][0], components[1][0], components[2][0]);
+			v1 = Vector<3, float>(components[0][1], components[1][1], components[2][1]);
+			v2 = Vector<3, float>(components[0][2], components[1][2], components[2][2]);
+			v3 = Vector<3, float>(components[0][3], components[1][3], components[2][3]);
+		}
+#endif
+		for (; i < vectors.count; ++i)
+			Normalize(vectors[i]);
+	}
+#pragma endregion
+}
+#endif
@@ -23,6 +23,7 @@ namespace Elite
 		//Capture Input (absolute) Rotation & (relative) Movement
 		//*************
 		//Keyboard Input
+		const FPoint2 previousRotation = m_AbsoluteRotation;
 		const uint8_t* pKeyboardState = SDL_GetKeyboardState(0);
 		float keyboardSpeed = pKeyboardState[SDL_SCANCODE_LSHIFT] ? m_KeyboardMoveSensitivity * m_KeyboardMoveMultiplier : m_KeyboardMoveSensitivity;
 		m_RelativeTranslation.x = (pKeyboardState[SDL_SCANCODE_D] - pKeyboardState[SDL_SCANCODE_A]) * keyboardSpeed * elapsedSec;
@@ -47,11 +48,31 @@ namespace Elite
 			m_RelativeTranslation.y -= y * m_MouseMoveSensitivity * elapsedSec;
 		}
 
+		//Nothing moved, the matrices of the last update are still valid
+		if (!m_IsDirty && m_AbsoluteRotation == previousRotation && m_RelativeTranslation == FPoint3{})
+			return;
+
 		//Update LookAt (view2world & world2view matrices)
 		//*************
 		CalculateLookAt();
 	}
 
+	void Camera::SetPose(const FPoint3& position, float pitch, float yaw)
+	{
+		m_Position = position;
+		m_AbsoluteRotation = FPoint2{ pitch, yaw };
+		m_RelativeTranslation = FPoint3{};
+		CalculateLookAt();
+	}
+
+	void Camera::SetRenderMode()
+	{
+		//The projection switches right away, the view matrices on the next update
+		m_UsingDirectx11 = !m_UsingDirectx11;
+		m_IsDirty = true;
+		++m_Version;
+	}
+
 	const FMatrix4& Camera::GetProjectionMatrix() const
 	{
 		if (m_UsingDirectx11)
@@ -112,6 +133,8 @@ namespace Elite
 
 		//Construct World2View Matrix
 		m_WorldToView = Inverse(m_ViewToWorld);
+		m_IsDirty = false;
+		++m_Version;
 	}
 	void Camera::CalculateProjection()
 	{
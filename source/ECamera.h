@@ -21,7 +21,13 @@ namespace Elite
 		Camera& operator=(const Camera&) = delete;
 		Camera& operator=(Camera&&) noexcept = delete;
 
+		//Only rebuilds the matrices when the input moved the camera
 		void Update(float elapsedSec);
+		//Places the camera without any input, pitch & yaw are in degrees like the mouse rotation
+		void SetPose(const FPoint3& position, float pitch, float yaw);
+
+		//Increases every time the matrices change, so copies of them can be checked for being stale
+		uint32_t GetVersion() const { return m_Version; }
 
 		const FMatrix4& GetWorldToView() const { return m_WorldToView; }
 		const FMatrix4& GetViewToWorld() const { return m_ViewToWorld; }
@@ -33,7 +39,7 @@ namespace Elite
 		const float GetFar() const { return m_Far; }
 		const float GetNear() const { return m_Near; }
 
-		void SetRenderMode() { m_UsingDirectx11 = !m_UsingDirectx11; };
+		void SetRenderMode();
 
 	private:
 		void CalculateLookAt();
@@ -63,5 +69,8 @@ namespace Elite
 		float m_Far{};
 
 		bool m_UsingDirectx11 = false;
+
+		uint32_t m_Version{};
+		bool m_IsDirty = false;
 	};
 }
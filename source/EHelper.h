@@ -1,5 +1,9 @@
 #pragma once
 #include "pch.h"
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
 
 namespace Elite
 {
@@ -17,6 +21,43 @@ namespace Elite
 		none = 3
 	};
 
+	enum class ShadingRate
+	{
+		rate1x1 = 0,
+		rate1x2 = 1,
+		rate2x2 = 2,
+		rate4x4 = 3
+	};
+
+	enum class ShadingRateMode
+	{
+		full = 0,
+		fixed = 1,
+		adaptive = 2
+	};
+
+	enum class PresentMode
+	{
+		blit = 0,
+		windowSurface = 1,
+		offscreen = 2
+	};
+
+	enum class DepthFormat
+	{
+		float32 = 0,
+		reversedFloat32 = 1,
+		unorm24 = 2,
+		unorm16 = 3
+	};
+
+	enum class DebugView
+	{
+		none = 0,
+		overdraw = 1,
+		shadingCost = 2
+	};
+
 	struct Vertex_Input
 	{
 		Elite::FPoint4 position;
@@ -32,4 +73,36 @@ namespace Elite
 		Elite::Vertex_Input v1;
 		Elite::Vertex_Input v2;
 	};
-}
\ No newline at end of file
+
+	//Rounded to a tenth of a millisecond for printing
+	inline float ToMilliseconds(float seconds)
+	{
+		return std::round(seconds * 10000.f) / 10.f;
+	}
+
+	//Quoted, with quotes & backslashes escaped
+	inline void WriteJsonString(std::ostream& stream, const std::string& text)
+	{
+		stream << '"';
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				stream << '\\';
+			stream << c;
+		}
+		stream << '"';
+	}
+
+	//FNV-1a over the bytes, pass the hash of the previous data to hash a sequence
+	static const uint64_t HashSeed = 14695981039346656037ull;
+	inline uint64_t HashBytes(const void* pData, size_t size, uint64_t hash = HashSeed)
+	{
+		const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= pBytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
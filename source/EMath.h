@@ -55,5 +55,17 @@ namespace Elite
 	typedef Matrix<3, 3, double>	DMatrix3;
 	typedef Matrix<4, 4, float>		FMatrix4;
 	typedef Matrix<4, 4, double>	DMatrix4;
+
+	/* --- LAYOUT --- */
+	//Every type is plain data, so arrays of them are copied with memcpy & can be uploaded to the GPU as they are
+	static_assert(std::is_trivially_copyable<FVector4>::value && std::is_standard_layout<FVector4>::value, "FVector4 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FPoint4>::value && std::is_standard_layout<FPoint4>::value, "FPoint4 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FVector3>::value && std::is_standard_layout<FVector3>::value, "FVector3 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FPoint3>::value && std::is_standard_layout<FPoint3>::value, "FPoint3 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FVector2>::value && std::is_standard_layout<FVector2>::value, "FVector2 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FPoint2>::value && std::is_standard_layout<FPoint2>::value, "FPoint2 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FMatrix4>::value && std::is_standard_layout<FMatrix4>::value, "FMatrix4 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FMatrix3>::value && std::is_standard_layout<FMatrix3>::value, "FMatrix3 has to stay plain data");
+	static_assert(std::is_trivially_copyable<FMatrix2>::value && std::is_standard_layout<FMatrix2>::value, "FMatrix2 has to stay plain data");
 }
 #endif
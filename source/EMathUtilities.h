@@ -14,6 +14,18 @@
 #include <limits>
 #include <type_traits>
 
+/* --- SIMD --- */
+//The float 4-wide types & 4x4 matrices get SSE specializations when the target has SSE2 (always on x64),
+//AVX is only used when it is enabled at compile time, every other target keeps the scalar templates
+#if defined(_M_X64) || defined(__SSE2__)
+	#include <emmintrin.h>
+	#define ELITE_SSE2
+#endif
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define ELITE_AVX
+#endif
+
 namespace Elite 
 {
 	/* --- CONSTANTS --- */
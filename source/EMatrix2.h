@@ -24,40 +24,28 @@ namespace Elite
 #pragma region Constructors
 		Matrix<2, 2, T>() = default;
 		//Every "row" of values passed here is a row in our matrix!
-		Matrix<2, 2, T>(T _00, T _01,
+		constexpr Matrix<2, 2, T>(T _00, T _01,
 						T _10, T _11)
-		{
-			data[0][0] = _00; data[0][1] = _10;
-			data[1][0] = _01; data[1][1] = _11;
-		}
+			: data{ { _00, _10 },
+					{ _01, _11 } }
+		{}
 		//Every vector passed here is a column in our matrix!
-		Matrix<2, 2, T>(const Vector<2, T>& a, const Vector<2, T>& b)
-		{
-			data[0][0] = a.x; data[0][1] = a.y;
-			data[1][0] = b.x; data[1][1] = b.y;
-		}
-		Matrix<2, 2, T>(const Matrix<2, 2, T>& m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1];
-		}
-		Matrix<2, 2, T>(Matrix<2, 2, T>&& m) noexcept
-		{
-			data[0][0] = std::move(m.data[0][0]); data[0][1] = std::move(m.data[0][1]);
-			data[1][0] = std::move(m.data[1][0]); data[1][1] = std::move(m.data[1][1]);
-		}
+		constexpr Matrix<2, 2, T>(const Vector<2, T>& a, const Vector<2, T>& b)
+			: data{ { a.x, a.y },
+					{ b.x, b.y } }
+		{}
 #pragma endregion
 
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
-		inline Matrix<2, 2, T> operator+(const Matrix<2, 2, T>& m) const
+		constexpr Matrix<2, 2, T> operator+(const Matrix<2, 2, T>& m) const
 		{ 
 			return Matrix<2, 2, T>(
 				data[0][0] + m.data[0][0], data[1][0] + m.data[1][0],
 				data[0][1] + m.data[0][1], data[1][1] + m.data[1][1]);
 		}
 
-		inline Matrix<2, 2, T> operator-(const Matrix<2, 2, T>& m) const
+		constexpr Matrix<2, 2, T> operator-(const Matrix<2, 2, T>& m) const
 		{ 
 			return Matrix<2, 2, T>(
 				data[0][0] - m.data[0][0], data[1][0] - m.data[1][0],
@@ -65,7 +53,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<2, 2, T> operator*(U scale) const
+		constexpr Matrix<2, 2, T> operator*(U scale) const
 		{
 			const T s = static_cast<T>(scale);
 			return Matrix<2, 2, T>(
@@ -74,7 +62,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<2, 2, T> operator/(U scale) const
+		constexpr Matrix<2, 2, T> operator/(U scale) const
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			return Matrix<2, 2, T>(
@@ -104,21 +92,14 @@ namespace Elite
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Matrix<2, 2, T>& operator=(const Matrix<2, 2, T>& m)
-		{ 
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1];
-			return *this; 
-		}
-
-		inline Matrix<2, 2, T>& operator+=(const Matrix<2, 2, T>& m)
+		constexpr Matrix<2, 2, T>& operator+=(const Matrix<2, 2, T>& m)
 		{ 
 			data[0][0] += m.data[0][0]; data[0][1] += m.data[0][1];
 			data[1][0] += m.data[1][0]; data[1][1] += m.data[1][1];
 			return *this; 
 		}
 
-		inline Matrix<2, 2, T>& operator-=(const Matrix<2, 2, T>& m)
+		constexpr Matrix<2, 2, T>& operator-=(const Matrix<2, 2, T>& m)
 		{ 
 			data[0][0] -= m.data[0][0]; data[0][1] -= m.data[0][1];
 			data[1][0] -= m.data[1][0]; data[1][1] -= m.data[1][1];
@@ -126,7 +107,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<2, 2, T>& operator*=(U scale)
+		constexpr Matrix<2, 2, T>& operator*=(U scale)
 		{
 			const T s = static_cast<T>(scale);
 			data[0][0] *= s; data[0][1] *= s;
@@ -135,7 +116,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<2, 2, T>& operator/=(U scale)
+		constexpr Matrix<2, 2, T>& operator/=(U scale)
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			data[0][0] *= revS; data[0][1] *= revS;
@@ -163,13 +144,13 @@ namespace Elite
 		//=== Member Access Operators ===
 #pragma region MemberAccessOperators
 		//Access parameter order still happens as row,column indexing (standard in programming)
-		inline T operator()(uint8_t r, uint8_t c) const
+		constexpr T operator()(uint8_t r, uint8_t c) const
 		{
 			assert((r < 2 && c < 2) && "ERROR: indices of Matrix2x2 () const operator are out of bounds!");
 			return (data[c][r]);
 		}
 
-		inline T& operator()(uint8_t r, uint8_t c)
+		constexpr T& operator()(uint8_t r, uint8_t c)
 		{
 			assert((r < 2 && c < 2) && "ERROR: indices of Matrix2x2 () operator are out of bounds!");
 			return (data[c][r]);
@@ -190,7 +171,7 @@ namespace Elite
 #pragma endregion
 
 		//=== Static Functions ===
-		static Matrix<2, 2, T> Identity();
+		static constexpr Matrix<2, 2, T> Identity();
 	};
 
 	//--- VECMATRIX3 FUNCTIONS ---
@@ -199,7 +180,7 @@ namespace Elite
 
 #pragma region GlobalFunctions
 	template<typename T>
-	inline Matrix<2, 2, T> Matrix<2, 2, T>::Identity()
+	constexpr Matrix<2, 2, T> Matrix<2, 2, T>::Identity()
 	{
 		return Matrix<2, 2, T>(
 			1,0,
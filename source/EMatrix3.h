@@ -24,56 +24,34 @@ namespace Elite
 #pragma region Constructors
 		Matrix<3, 3, T>() = default;
 		//Every "row" of values passed here is a row in our matrix!
-		Matrix<3, 3, T>(T _00, T _01, T _02,
+		constexpr Matrix<3, 3, T>(T _00, T _01, T _02,
 						T _10, T _11, T _12,
 						T _20, T _21, T _22)
-		{
-			data[0][0] = _00; data[0][1] = _10; data[0][2] = _20;
-			data[1][0] = _01; data[1][1] = _11; data[1][2] = _21;
-			data[2][0] = _02; data[2][1] = _12; data[2][2] = _22;
-		}
+			: data{ { _00, _10, _20 },
+					{ _01, _11, _21 },
+					{ _02, _12, _22 } }
+		{}
 		//Every vector passed here is a column in our matrix!
-		Matrix<3, 3, T>(const Vector<3, T>& a, const Vector<3, T>& b, const Vector<3, T>& c)
-		{
-			data[0][0] = a.x; data[0][1] = a.y; data[0][2] = a.z;
-			data[1][0] = b.x; data[1][1] = b.y; data[1][2] = b.z;
-			data[2][0] = c.x; data[2][1] = c.y; data[2][2] = c.z;
-		}
-		Matrix<3, 3, T>(const Matrix<2, 2, T>& m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = 0;
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = 0;
-			data[2][0] = 0; data[2][1] = 0; data[2][2] = 1;
-		}
-		Matrix<3, 3, T>(const Matrix<3, 3, T>& m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2];
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2];
-		}
-		Matrix<3, 3, T>(const Matrix<4, 4, T>& m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2];
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2];
-		}
-		Matrix<3, 3, T>(Matrix<3, 3, T>&& m) noexcept
-		{
-			data[0][0] = std::move(m.data[0][0]); data[0][1] = std::move(m.data[0][1]); data[0][2] = std::move(m.data[0][2]);
-			data[1][0] = std::move(m.data[1][0]); data[1][1] = std::move(m.data[1][1]); data[1][2] = std::move(m.data[1][2]);
-			data[2][0] = std::move(m.data[2][0]); data[2][1] = std::move(m.data[2][1]); data[2][2] = std::move(m.data[2][2]);
-		}
-		Matrix<3, 3, T>(Matrix<4, 4, T>&& m) noexcept
-		{
-			data[0][0] = std::move(m.data[0][0]); data[0][1] = std::move(m.data[0][1]); data[0][2] = std::move(m.data[0][2]);
-			data[1][0] = std::move(m.data[1][0]); data[1][1] = std::move(m.data[1][1]); data[1][2] = std::move(m.data[1][2]);
-			data[2][0] = std::move(m.data[2][0]); data[2][1] = std::move(m.data[2][1]); data[2][2] = std::move(m.data[2][2]);
-		}
+		constexpr Matrix<3, 3, T>(const Vector<3, T>& a, const Vector<3, T>& b, const Vector<3, T>& c)
+			: data{ { a.x, a.y, a.z },
+					{ b.x, b.y, b.z },
+					{ c.x, c.y, c.z } }
+		{}
+		constexpr Matrix<3, 3, T>(const Matrix<2, 2, T>& m)
+			: data{ { m.data[0][0], m.data[0][1], 0 },
+					{ m.data[1][0], m.data[1][1], 0 },
+					{ 0, 0, 1 } }
+		{}
+		constexpr Matrix<3, 3, T>(const Matrix<4, 4, T>& m)
+			: data{ { m.data[0][0], m.data[0][1], m.data[0][2] },
+					{ m.data[1][0], m.data[1][1], m.data[1][2] },
+					{ m.data[2][0], m.data[2][1], m.data[2][2] } }
+		{}
 #pragma endregion
 
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
-		inline Matrix<3, 3, T> operator+(const Matrix<3, 3, T>& m) const
+		constexpr Matrix<3, 3, T> operator+(const Matrix<3, 3, T>& m) const
 		{ 
 			return Matrix<3, 3, T>(
 				data[0][0] + m.data[0][0], data[1][0] + m.data[1][0], data[2][0] + m.data[2][0],
@@ -81,7 +59,7 @@ namespace Elite
 				data[0][2] + m.data[0][2], data[1][2] + m.data[1][2], data[2][2] + m.data[2][2]);
 		}
 
-		inline Matrix<3, 3, T> operator-(const Matrix<3, 3, T>& m) const
+		constexpr Matrix<3, 3, T> operator-(const Matrix<3, 3, T>& m) const
 		{ 
 			return Matrix<3, 3, T>(
 				data[0][0] - m.data[0][0], data[1][0] - m.data[1][0], data[2][0] - m.data[2][0],
@@ -90,7 +68,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<3, 3, T> operator*(U scale) const
+		constexpr Matrix<3, 3, T> operator*(U scale) const
 		{
 			const T s = static_cast<T>(scale);
 			return Matrix<3, 3, T>(
@@ -100,7 +78,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<3, 3, T> operator/(U scale) const
+		constexpr Matrix<3, 3, T> operator/(U scale) const
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			return Matrix<3, 3, T>(
@@ -146,15 +124,7 @@ namespace Elite
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Matrix<3, 3, T>& operator=(const Matrix<3, 3, T>& m)
-		{ 
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2];
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2];
-			return *this; 
-		}
-
-		inline Matrix<3, 3, T>& operator+=(const Matrix<3, 3, T>& m)
+		constexpr Matrix<3, 3, T>& operator+=(const Matrix<3, 3, T>& m)
 		{ 
 			data[0][0] += m.data[0][0]; data[0][1] += m.data[0][1]; data[0][2] += m.data[0][2];
 			data[1][0] += m.data[1][0]; data[1][1] += m.data[1][1]; data[1][2] += m.data[1][2];
@@ -162,7 +132,7 @@ namespace Elite
 			return *this; 
 		}
 
-		inline Matrix<3, 3, T>& operator-=(const Matrix<3, 3, T>& m)
+		constexpr Matrix<3, 3, T>& operator-=(const Matrix<3, 3, T>& m)
 		{ 
 			data[0][0] -= m.data[0][0]; data[0][1] -= m.data[0][1]; data[0][2] -= m.data[0][2];
 			data[1][0] -= m.data[1][0]; data[1][1] -= m.data[1][1]; data[1][2] -= m.data[1][2];
@@ -171,7 +141,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<3, 3, T>& operator*=(U scale)
+		constexpr Matrix<3, 3, T>& operator*=(U scale)
 		{
 			const T s = static_cast<T>(scale);
 			data[0][0] *= s; data[0][1] *= s; data[0][2] *= s;
@@ -181,7 +151,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<3, 3, T>& operator/=(U scale)
+		constexpr Matrix<3, 3, T>& operator/=(U scale)
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			data[0][0] *= revS; data[0][1] *= revS; data[0][2] *= revS;
@@ -210,13 +180,13 @@ namespace Elite
 		//=== Member Access Operators ===
 #pragma region MemberAccessOperators
 		//Access parameter order still happens as row,column indexing (standard in programming)
-		inline T operator()(uint8_t r, uint8_t c) const
+		constexpr T operator()(uint8_t r, uint8_t c) const
 		{
 			assert((r < 3 && c < 3) && "ERROR: indices of Matrix3x3 () const operator are out of bounds!");
 			return (data[c][r]);
 		}
 
-		inline T& operator()(uint8_t r, uint8_t c)
+		constexpr T& operator()(uint8_t r, uint8_t c)
 		{
 			assert((r < 3 && c < 3) && "ERROR: indices of Matrix3x3 () operator are out of bounds!");
 			return (data[c][r]);
@@ -237,7 +207,7 @@ namespace Elite
 #pragma endregion
 
 		//=== Static Functions ===
-		static Matrix<3, 3, T> Identity();
+		static constexpr Matrix<3, 3, T> Identity();
 	};
 
 	//--- VECMATRIX3 FUNCTIONS ---
@@ -246,7 +216,7 @@ namespace Elite
 
 #pragma region GlobalFunctions
 	template<typename T>
-	inline Matrix<3, 3, T> Matrix<3, 3, T>::Identity()
+	constexpr Matrix<3, 3, T> Matrix<3, 3, T>::Identity()
 	{
 		return Matrix<3, 3, T>(
 			1,0,0,
@@ -24,64 +24,39 @@ namespace Elite
 #pragma region Constructors
 		Matrix<4, 4, T>() = default;
 		//Every "row" of values passed here is a row in our matrix!
-		Matrix<4, 4, T>(T _00, T _01, T _02, T _03,
+		constexpr Matrix<4, 4, T>(T _00, T _01, T _02, T _03,
 			T _10, T _11, T _12, T _13,
 			T _20, T _21, T _22, T _23,
 			T _30, T _31, T _32, T _33)
-		{
-			data[0][0] = _00; data[0][1] = _10; data[0][2] = _20; data[0][3] = _30;
-			data[1][0] = _01; data[1][1] = _11; data[1][2] = _21; data[1][3] = _31;
-			data[2][0] = _02; data[2][1] = _12; data[2][2] = _22; data[2][3] = _32;
-			data[3][0] = _03; data[3][1] = _13; data[3][2] = _23; data[3][3] = _33;
-		}
+			: data{ { _00, _10, _20, _30 },
+					{ _01, _11, _21, _31 },
+					{ _02, _12, _22, _32 },
+					{ _03, _13, _23, _33 } }
+		{}
 		//Every vector passed here is a column in our matrix!
-		Matrix<4, 4, T>(const Vector<4, T> & a, const Vector<4, T> & b, const Vector<4, T> & c, const Vector<4, T> & d)
-		{
-			data[0][0] = a.x; data[0][1] = a.y; data[0][2] = a.z; data[0][3] = a.w;
-			data[1][0] = b.x; data[1][1] = b.y; data[1][2] = b.z; data[1][3] = b.w;
-			data[2][0] = c.x; data[2][1] = c.y; data[2][2] = c.z; data[2][3] = c.w;
-			data[3][0] = d.x; data[3][1] = d.y; data[3][2] = d.z; data[3][3] = d.w;
-		}
-		Matrix<4, 4, T>(const Matrix<3, 3, T> & m, const Vector<3, T> & t)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2]; data[0][3] = 0;
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2]; data[1][3] = 0;
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2]; data[2][3] = 0;
-			data[3][0] = t.x; data[3][1] = t.y; data[3][2] = t.z; data[3][3] = 1;
-		}
-		Matrix<4, 4, T>(const Matrix<3, 3, T> & m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2]; data[0][3] = 0;
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2]; data[1][3] = 0;
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2]; data[2][3] = 0;
-			data[3][0] = 0; data[3][1] = 0; data[3][2] = 0; data[3][3] = 1;
-		}
-		Matrix<4, 4, T>(const Matrix<4, 4, T> & m)
-		{
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2]; data[0][3] = m.data[0][3];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2]; data[1][3] = m.data[1][3];
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2]; data[2][3] = m.data[2][3];
-			data[3][0] = m.data[3][0]; data[3][1] = m.data[3][1]; data[3][2] = m.data[3][2]; data[3][3] = m.data[3][3];
-		}
-		Matrix<4, 4, T>(Matrix<4, 4, T> && m) noexcept
-		{
-			data[0][0] = std::move(m.data[0][0]); data[0][1] = std::move(m.data[0][1]);
-			data[0][2] = std::move(m.data[0][2]); data[0][3] = std::move(m.data[0][3]);
-
-			data[1][0] = std::move(m.data[1][0]); data[1][1] = std::move(m.data[1][1]);
-			data[1][2] = std::move(m.data[1][2]); data[1][3] = std::move(m.data[1][3]);
-
-			data[2][0] = std::move(m.data[2][0]); data[2][1] = std::move(m.data[2][1]);
-			data[2][2] = std::move(m.data[2][2]); data[2][3] = std::move(m.data[2][3]);
-
-			data[3][0] = std::move(m.data[3][0]); data[3][1] = std::move(m.data[3][1]);
-			data[3][2] = std::move(m.data[3][2]); data[3][3] = std::move(m.data[3][3]);
-		}
+		constexpr Matrix<4, 4, T>(const Vector<4, T> & a, const Vector<4, T> & b, const Vector<4, T> & c, const Vector<4, T> & d)
+			: data{ { a.x, a.y, a.z, a.w },
+					{ b.x, b.y, b.z, b.w },
+					{ c.x, c.y, c.z, c.w },
+					{ d.x, d.y, d.z, d.w } }
+		{}
+		constexpr Matrix<4, 4, T>(const Matrix<3, 3, T> & m, const Vector<3, T> & t)
+			: data{ { m.data[0][0], m.data[0][1], m.data[0][2], 0 },
+					{ m.data[1][0], m.data[1][1], m.data[1][2], 0 },
+					{ m.data[2][0], m.data[2][1], m.data[2][2], 0 },
+					{ t.x, t.y, t.z, 1 } }
+		{}
+		constexpr Matrix<4, 4, T>(const Matrix<3, 3, T> & m)
+			: data{ { m.data[0][0], m.data[0][1], m.data[0][2], 0 },
+					{ m.data[1][0], m.data[1][1], m.data[1][2], 0 },
+					{ m.data[2][0], m.data[2][1], m.data[2][2], 0 },
+					{ 0, 0, 0, 1 } }
+		{}
 #pragma endregion
 
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
-		inline Matrix<4, 4, T> operator+(const Matrix<4, 4, T>& m) const
+		constexpr Matrix<4, 4, T> operator+(const Matrix<4, 4, T>& m) const
 		{ 
 			return Matrix<4, 4, T>(
 				data[0][0] + m.data[0][0], data[1][0] + m.data[1][0], data[2][0] + m.data[2][0], data[3][0] + m.data[3][0],
@@ -90,7 +65,7 @@ namespace Elite
 				data[0][3] + m.data[0][3], data[1][3] + m.data[1][3], data[2][3] + m.data[2][3], data[3][3] + m.data[3][3]);
 		}
 
-		inline Matrix<4, 4, T> operator-(const Matrix<4, 4, T>& m) const
+		constexpr Matrix<4, 4, T> operator-(const Matrix<4, 4, T>& m) const
 		{ 
 			return Matrix<4, 4, T>(
 				data[0][0] - m.data[0][0], data[1][0] - m.data[1][0], data[2][0] - m.data[2][0], data[3][0] - m.data[3][0],
@@ -100,7 +75,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<4, 4, T> operator*(U scale) const
+		constexpr Matrix<4, 4, T> operator*(U scale) const
 		{
 			const T s = static_cast<T>(scale);
 			return Matrix<4, 4, T>(
@@ -111,7 +86,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<4, 4, T> operator/(U scale) const
+		constexpr Matrix<4, 4, T> operator/(U scale) const
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			return Matrix<4, 4, T>(
@@ -172,16 +147,7 @@ namespace Elite
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Matrix<4, 4, T>& operator=(const Matrix<4, 4, T>& m)
-		{ 
-			data[0][0] = m.data[0][0]; data[0][1] = m.data[0][1]; data[0][2] = m.data[0][2]; data[0][3] = m.data[0][3];
-			data[1][0] = m.data[1][0]; data[1][1] = m.data[1][1]; data[1][2] = m.data[1][2]; data[1][3] = m.data[1][3];
-			data[2][0] = m.data[2][0]; data[2][1] = m.data[2][1]; data[2][2] = m.data[2][2]; data[2][3] = m.data[2][3];
-			data[3][0] = m.data[3][0]; data[3][1] = m.data[3][1]; data[3][2] = m.data[3][2]; data[3][3] = m.data[3][3];
-			return *this; 
-		}
-
-		inline Matrix<4, 4, T>& operator+=(const Matrix<4, 4, T>& m)
+		constexpr Matrix<4, 4, T>& operator+=(const Matrix<4, 4, T>& m)
 		{ 
 			data[0][0] += m.data[0][0]; data[0][1] += m.data[0][1]; data[0][2] += m.data[0][2]; data[0][3] += m.data[0][3];
 			data[1][0] += m.data[1][0]; data[1][1] += m.data[1][1]; data[1][2] += m.data[1][2]; data[1][3] += m.data[1][3];
@@ -190,7 +156,7 @@ namespace Elite
 			return *this; 
 		}
 
-		inline Matrix<4, 4, T>& operator-=(const Matrix<4, 4, T>& m)
+		constexpr Matrix<4, 4, T>& operator-=(const Matrix<4, 4, T>& m)
 		{ 
 			data[0][0] -= m.data[0][0]; data[0][1] -= m.data[0][1]; data[0][2] -= m.data[0][2]; data[0][3] -= m.data[0][3];
 			data[1][0] -= m.data[1][0]; data[1][1] -= m.data[1][1]; data[1][2] -= m.data[1][2]; data[1][3] -= m.data[1][3];
@@ -200,7 +166,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<4, 4, T>& operator*=(U scale)
+		constexpr Matrix<4, 4, T>& operator*=(U scale)
 		{
 			const T s = static_cast<T>(scale);
 			data[0][0] *= s; data[0][1] *= s; data[0][2] *= s; data[0][3] *= s;
@@ -211,7 +177,7 @@ namespace Elite
 		}
 
 		template<typename U>
-		inline Matrix<4, 4, T>& operator/=(U scale)
+		constexpr Matrix<4, 4, T>& operator/=(U scale)
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			data[0][0] *= revS; data[0][1] *= revS; data[0][2] *= revS;	data[0][3] *= revS;
@@ -241,13 +207,13 @@ namespace Elite
 		//=== Member Access Operators ===
 #pragma region MemberAccessOperators
 		//Access parameter order still happens as row,column indexing (standard in programming)
-		inline T operator()(uint8_t r, uint8_t c) const
+		constexpr T operator()(uint8_t r, uint8_t c) const
 		{
 			assert((r < 4 && c < 4) && "ERROR: indices of Matrix4x4 () const operator are out of bounds!");
 			return (data[c][r]);
 		}
 
-		inline T& operator()(uint8_t r, uint8_t c)
+		constexpr T& operator()(uint8_t r, uint8_t c)
 		{
 			assert((r < 4 && c < 4) && "ERROR: indices of Matrix4x4 () operator are out of bounds!");
 			return (data[c][r]);
@@ -268,7 +234,7 @@ namespace Elite
 #pragma endregion
 
 		//=== Static Functions ===
-		static Matrix<4, 4, T> Identity();
+		static constexpr Matrix<4, 4, T> Identity();
 	};
 
 	//--- VECMATRIX3 FUNCTIONS ---
@@ -277,7 +243,7 @@ namespace Elite
 
 #pragma region GlobalFunctions
 	template<typename T>
-	inline Matrix<4, 4, T> Matrix<4, 4, T>::Identity()
+	constexpr Matrix<4, 4, T> Matrix<4, 4, T>::Identity()
 	{
 		return Matrix<4, 4, T>(
 			1, 0, 0, 0,
@@ -378,5 +344,129 @@ namespace Elite
 			0, 0, 0, 1);
 	}
 #pragma endregion
+
+	//--- FLOAT SIMD SPECIALIZATIONS ---
+	//Columns are stored contiguously, so every column is one register & every result column is a sum of scaled columns
+	//Transpose stays scalar, 16 moves beat the shuffles of a register transpose
+#ifdef ELITE_SSE2
+#pragma region SIMDSpecializations
+	template<>
+	inline Matrix<4, 4, float> Matrix<4, 4, float>::operator*(const Matrix<4, 4, float>& rm) const
+	{
+		Matrix<4, 4, float> result;
+#ifdef ELITE_AVX
+		//Two result columns at once, every 128 bit lane broadcasts from its own column of rm
+		const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(data[0]));
+		const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(data[1]));
+		const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(data[2]));
+		const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(data[3]));
+		for (uint8_t c = 0; c < 4; c += 2)
+		{
+			const __m256 r = _mm256_loadu_ps(rm.data[c]);
+			__m256 column = _mm256_mul_ps(c0, _mm256_permute_ps(r, 0x00));
+			column = _mm256_add_ps(column, _mm256_mul_ps(c1, _mm256_permute_ps(r, 0x55)));
+			column = _mm256_add_ps(column, _mm256_mul_ps(c2, _mm256_permute_ps(r, 0xAA)));
+			column = _mm256_add_ps(column, _mm256_mul_ps(c3, _mm256_permute_ps(r, 0xFF)));
+			_mm256_storeu_ps(result.data[c], column);
+		}
+#else
+		const __m128 c0 = _mm_loadu_ps(data[0]);
+		const __m128 c1 = _mm_loadu_ps(data[1]);
+		const __m128 c2 = _mm_loadu_ps(data[2]);
+		const __m128 c3 = _mm_loadu_ps(data[3]);
+		for (uint8_t c = 0; c < 4; ++c)
+		{
+			const __m128 r = _mm_loadu_ps(rm.data[c]);
+			__m128 column = _mm_mul_ps(c0, _mm_shuffle_ps(r, r, 0x00));
+			column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_shuffle_ps(r, r, 0x55)));
+			column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_shuffle_ps(r, r, 0xAA)));
+			column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_shuffle_ps(r, r, 0xFF)));
+			_mm_storeu_ps(result.data[c], column);
+		}
+#endif
+		return result;
+	}
+
+	template<>
+	inline Vector<4, float> Matrix<4, 4, float>::operator*(const Vector<4, float>& v)
+	{
+		__m128 r = _mm_mul_ps(_mm_loadu_ps(data[0]), _mm_set1_ps(v.x));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(data[1]), _mm_set1_ps(v.y)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(data[2]), _mm_set1_ps(v.z)));
+
+		Vector<4, float> result;
+		_mm_storeu_ps(result.data, r);
+		result.w = 0.f;
+		return result;
+	}
+
+	template<>
+	inline Point<4, float> Matrix<4, 4, float>::operator*(const Point<4, float>& p)
+	{
+		__m128 r = _mm_mul_ps(_mm_loadu_ps(data[0]), _mm_set1_ps(p.x));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(data[1]), _mm_set1_ps(p.y)));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(data[2]), _mm_set1_ps(p.z)));
+		r = _mm_add_ps(r, _mm_loadu_ps(data[3]));
+
+		Point<4, float> result;
+		_mm_storeu_ps(result.data, r);
+		return result;
+	}
+
+	inline Matrix<4, 4, float> Inverse(const Matrix<4, 4, float>& m)
+	{
+		//Same FGED1 inverse as the template, the xyz of a column & its bottom row value share one register
+		//The w lanes of every cross product & of u and v cancel out to 0, so 4-wide dots are 3D dots
+		auto cross = [](__m128 a, __m128 b)
+		{
+			const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 r = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+			return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+		};
+		auto dot = [](__m128 a, __m128 b)
+		{
+			__m128 r = _mm_mul_ps(a, b);
+			r = _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)));
+			r = _mm_add_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)));
+			return _mm_cvtss_f32(r);
+		};
+
+		const __m128 a = _mm_loadu_ps(m.data[0]);
+		const __m128 b = _mm_loadu_ps(m.data[1]);
+		const __m128 c = _mm_loadu_ps(m.data[2]);
+		const __m128 d = _mm_loadu_ps(m.data[3]);
+		const __m128 x = _mm_shuffle_ps(a, a, 0xFF);
+		const __m128 y = _mm_shuffle_ps(b, b, 0xFF);
+		const __m128 z = _mm_shuffle_ps(c, c, 0xFF);
+		const __m128 w = _mm_shuffle_ps(d, d, 0xFF);
+
+		__m128 s = cross(a, b);
+		__m128 t = cross(c, d);
+		__m128 u = _mm_sub_ps(_mm_mul_ps(a, y), _mm_mul_ps(b, x));
+		__m128 v = _mm_sub_ps(_mm_mul_ps(c, w), _mm_mul_ps(d, z));
+
+		const float det = dot(s, v) + dot(t, u);
+		assert((!AreEqual(det, 0.f)) && "ERROR: determinant is 0, there is no INVERSE!");
+		const __m128 invDet = _mm_set1_ps(1.0f / det);
+
+		s = _mm_mul_ps(s, invDet); t = _mm_mul_ps(t, invDet); u = _mm_mul_ps(u, invDet); v = _mm_mul_ps(v, invDet);
+
+		__m128 r0 = _mm_add_ps(cross(b, v), _mm_mul_ps(t, y));
+		__m128 r1 = _mm_sub_ps(cross(v, a), _mm_mul_ps(t, x));
+		__m128 r2 = _mm_add_ps(cross(d, u), _mm_mul_ps(s, w));
+		__m128 r3 = _mm_sub_ps(cross(u, c), _mm_mul_ps(s, z));
+
+		//The rows become columns, the last column is the translation
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		Matrix<4, 4, float> result;
+		_mm_storeu_ps(result.data[0], r0);
+		_mm_storeu_ps(result.data[1], r1);
+		_mm_storeu_ps(result.data[2], r2);
+		_mm_storeu_ps(result.data[3], _mm_setr_ps(-dot(b, t), dot(a, t), -dot(d, s), dot(c, s)));
+		return result;
+	}
+#pragma endregion
+#endif
 }
 #endif
\ No newline at end of file
@@ -30,24 +30,20 @@ namespace Elite
 		//=== Constructors ===
 #pragma region Constructors
 		Point<3, T>() = default;
-		Point<3, T>(T _x, T _y, T _z = 1)
+		constexpr Point<3, T>(T _x, T _y, T _z = 1)
 			: x(_x), y(_y), z(_z) {}
-		Point<3, T>(const Point<3, T>& p)
-			: x(p.x), y(p.y), z(p.z) {}
-		Point<3, T>(const Point<2, T>& p, T _z = 1)
+		constexpr Point<3, T>(const Point<2, T>& p, T _z = 1)
 			: x(p.x), y(p.y), z(_z) {}
-		Point<3, T>(Point<3, T>&& p) noexcept
-			:x(std::move(p.x)), y(std::move(p.y)), z(std::move(p.z)) {}
-		explicit Point<3, T>(const Vector<3, T>& v)
+		constexpr explicit Point<3, T>(const Vector<3, T>& v)
 			: x(v.x), y(v.y), z(v.z) {}
-		explicit Point<3, T>(const Point<4, T>& p)
+		constexpr explicit Point<3, T>(const Point<4, T>& p)
 			: x(p.x), y(p.y), z(p.z) {}
 #pragma endregion
 
 		//=== Conversion Operator ===
 #pragma region ConversionOperator
 		template<typename U>
-		operator Point<3, U>() const //Implicit conversion to different types of Point3
+		constexpr operator Point<3, U>() const //Implicit conversion to different types of Point3
 		{
 			return Point<3, U>(
 				static_cast<U>(this->x),
@@ -59,27 +55,24 @@ namespace Elite
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
 		template<typename U>
-		inline Point<3, T> operator+(const Vector<3, U>& v) const
+		constexpr Point<3, T> operator+(const Vector<3, U>& v) const
 		{ return Point<3, T>(x + static_cast<T>(v.x), y + static_cast<T>(v.y), z + static_cast<T>(v.z)); }
 
 		template<typename U>
-		inline Point<3, T> operator-(const Vector<3, U>& v) const
+		constexpr Point<3, T> operator-(const Vector<3, U>& v) const
 		{ return Point<3, T>(x - static_cast<T>(v.x), y - static_cast<T>(v.y), z - static_cast<T>(v.z)); }
 
 		template<typename U>
-		inline Vector<3, T> operator-(const Point<3, U>& p) const
+		constexpr Vector<3, T> operator-(const Point<3, U>& p) const
 		{ return Vector<3, T>(x - static_cast<T>(p.x), y - static_cast<T>(p.y), z - static_cast<T>(p.z)); }
 #pragma endregion
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Point<3, T>& operator=(const Point<3, T>& p)
-		{ x = p.x; y = p.y; z = p.z; return *this; }
-
-		inline Point<3, T>& operator+=(const Vector<3, T>& v)
+		constexpr Point<3, T>& operator+=(const Vector<3, T>& v)
 		{ x += v.x; y += v.y; z += v.z; return *this; }
 
-		inline Point<3, T>& operator-=(const Vector<3, T>& v)
+		constexpr Point<3, T>& operator-=(const Vector<3, T>& v)
 		{ x -= v.x; y -= v.y; z -= v.z; return *this; }
 #pragma endregion
 
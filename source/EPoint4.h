@@ -31,24 +31,20 @@ namespace Elite
 		//=== Constructors ===
 #pragma region Constructors
 		Point<4, T>() = default;
-		Point<4, T>(T _x, T _y, T _z, T _w = 1) //W component of Point is usually 1
+		constexpr Point<4, T>(T _x, T _y, T _z, T _w = 1) //W component of Point is usually 1
 			: x(_x), y(_y), z(_z), w(_w) {}
-		Point<4, T>(const Point<2, T> p, T _z, T _w = 1)
+		constexpr Point<4, T>(const Point<2, T> p, T _z, T _w = 1)
 			: x(p.x), y(p.y), z(_z), w(_w) {}
-		Point<4, T>(const Point<3, T> p, T _w = 1)
+		constexpr Point<4, T>(const Point<3, T> p, T _w = 1)
 			: x(p.x), y(p.y), z(p.z), w(_w) {}
-		Point<4, T>(const Point<4, T>& p)
-			: x(p.x), y(p.y), z(p.z), w(p.w) {}
-		Point<4, T>(Point<4, T>&& p) noexcept
-			:x(std::move(p.x)), y(std::move(p.y)), z(std::move(p.z)), w(std::move(p.w)) {}
-		explicit Point<4, T>(const Vector<4, T>& v)
+		constexpr explicit Point<4, T>(const Vector<4, T>& v)
 			: x(v.x), y(v.y), z(v.z), w(v.w) {}
 #pragma endregion
 
 		//=== Conversion Operator ===
 #pragma region ConversionOperator
 		template<typename U>
-		operator Point<4, U>() const //Implicit conversion to different types of Point3
+		constexpr operator Point<4, U>() const //Implicit conversion to different types of Point3
 		{
 			return Point<4, U>(
 				static_cast<U>(this->x),
@@ -61,30 +57,27 @@ namespace Elite
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
 		template<typename U>
-		inline Point<4, T> operator+(const Vector<4, U>& v) const
+		constexpr Point<4, T> operator+(const Vector<4, U>& v) const
 		{ return Point<4, T>(x + static_cast<T>(v.x), y + static_cast<T>(v.y), 
 			z + static_cast<T>(v.z), w + static_cast<T>(v.w)); }
 
 		template<typename U>
-		inline Point<4, T> operator-(const Vector<4, U>& v) const
+		constexpr Point<4, T> operator-(const Vector<4, U>& v) const
 		{ return Point<4, T>(x - static_cast<T>(v.x), y - static_cast<T>(v.y), 
 			z - static_cast<T>(v.z), w - static_cast<T>(v.w)); }
 
 		template<typename U>
-		inline Vector<4, T> operator-(const Point<4, U>& p) const
+		constexpr Vector<4, T> operator-(const Point<4, U>& p) const
 		{ return Vector<4, T>(x - static_cast<T>(p.x), y - static_cast<T>(p.y), 
 			z - static_cast<T>(p.z), w - static_cast<T>(p.w)); }
 #pragma endregion
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Point<4, T>& operator=(const Point<4, T>& p)
-		{ x = p.x; y = p.y; z = p.z; w = p.w; return *this; }
-
-		inline Point<4, T>& operator+=(const Vector<4, T>& v)
+		constexpr Point<4, T>& operator+=(const Vector<4, T>& v)
 		{ x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
 
-		inline Point<4, T>& operator-=(const Vector<4, T>& v)
+		constexpr Point<4, T>& operator-=(const Vector<4, T>& v)
 		{ x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
 #pragma endregion
 
@@ -23,46 +23,38 @@ namespace Elite
 
 		//=== Constructors & Destructor ===
 		RGBColor() = default;
-		RGBColor(float _r, float _g, float _b) :r(_r), g(_g), b(_b) {}
-		RGBColor(const RGBColor& c) : r(c.r), g(c.g), b(c.b) {}
-		RGBColor(RGBColor&& c) noexcept : r(std::move(c.r)), g(std::move(c.g)), b(std::move(c.b)) {}
+		constexpr RGBColor(float _r, float _g, float _b) :r(_r), g(_g), b(_b) {}
 		~RGBColor() = default;
 
-		//=== Operators ===
-		RGBColor& operator=(const RGBColor& c)
-		{ r = c.r; g = c.g; b = c.b; return *this; }
-		RGBColor& operator=(RGBColor&& c) noexcept
-		{ r = std::move(c.r); g = std::move(c.g); b = std::move(c.b); return *this;	}
-
 		//=== Arithmetic Operators ===
-		inline RGBColor operator+(const RGBColor& c) const
+		constexpr RGBColor operator+(const RGBColor& c) const
 		{ return RGBColor(r + c.r, g + c.g, b + c.b); }
-		inline RGBColor operator-(const RGBColor& c) const 
+		constexpr RGBColor operator-(const RGBColor& c) const 
 		{ return RGBColor(r - c.r, g - c.g, b - c.b); }
-		inline RGBColor operator*(const RGBColor& c) const 
+		constexpr RGBColor operator*(const RGBColor& c) const 
 		{ return RGBColor(r * c.r, g * c.g, b * c.b); }
-		inline RGBColor operator/(float f) const
+		constexpr RGBColor operator/(float f) const
 		{
 			float rev = 1.0f / f;
 			return RGBColor(r * rev, g * rev, b * rev);
 		}
-		inline RGBColor operator*(float f) const
+		constexpr RGBColor operator*(float f) const
 		{ return RGBColor(r * f, g * f, b * f);	}
-		inline RGBColor operator/(const RGBColor& c) const
+		constexpr RGBColor operator/(const RGBColor& c) const
 		{ return RGBColor(r / c.r, g / c.g, b / c.b); }
 
 		//=== Compound Assignment Operators ===
-		inline RGBColor& operator+=(const RGBColor& c)
+		constexpr RGBColor& operator+=(const RGBColor& c)
 		{ r += c.r; g += c.g; b += c.b; return *this; }
-		inline RGBColor& operator-=(const RGBColor& c)
+		constexpr RGBColor& operator-=(const RGBColor& c)
 		{ r -= c.r; g -= c.g; b -= c.b; return *this; }
-		inline RGBColor& operator*=(const RGBColor& c)
+		constexpr RGBColor& operator*=(const RGBColor& c)
 		{ r *= c.r; g *= c.g; b *= c.b; return *this; }
-		inline RGBColor& operator/=(const RGBColor& c)
+		constexpr RGBColor& operator/=(const RGBColor& c)
 		{ r /= c.r; g /= c.g; b /= c.b; return *this; }
-		inline RGBColor& operator*=(float f)
+		constexpr RGBColor& operator*=(float f)
 		{ r *= f; g *= f; b *= f; return *this; }
-		inline RGBColor& operator/=(float f)
+		constexpr RGBColor& operator/=(float f)
 		{
 			float rev = 1.0f / f;
 			r *= rev; g *= rev; b *= rev; return *this;
@@ -90,8 +82,10 @@ namespace Elite
 		}
 	};
 
+	static_assert(std::is_trivially_copyable<RGBColor>::value && std::is_standard_layout<RGBColor>::value, "RGBColor has to stay plain data");
+
 	//=== Global RGBColor Functions ===
-	inline RGBColor Max(const RGBColor& c1, const RGBColor& c2)
+	constexpr RGBColor Max(const RGBColor& c1, const RGBColor& c2)
 	{
 		RGBColor c = c1;
 		if (c2.r > c.r) c.r = c2.r;
@@ -100,7 +94,7 @@ namespace Elite
 		return c;
 	}
 
-	inline RGBColor Min(const RGBColor& c1, const RGBColor& c2)
+	constexpr RGBColor Min(const RGBColor& c1, const RGBColor& c2)
 	{
 		RGBColor c = c1;
 		if (c2.r < c.r) c.r = c2.r;
@@ -134,9 +128,9 @@ namespace Elite
 	{
 		RGBColor result = c;
 		float gamma = 1 / 2.2f;
-		result.r = std::powf(result.r, gamma);
-		result.g = std::powf(result.g, gamma);
-		result.b = std::powf(result.b, gamma);
+		result.r = powf(result.r, gamma);
+		result.g = powf(result.g, gamma);
+		result.b = powf(result.b, gamma);
 		result.MaxToOne();
 		return result;
 	}
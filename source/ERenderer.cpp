@@ -3,39 +3,108 @@
 //Project includes
 #include "ERenderer.h"
 #include "EOBJParser.h"
-#include "Mesh.h"
-#include "EBRDF.h"
+#include "EBatch.h"
+#include "DX11Backend.h"
+#include "Profiler.h"
 
-Elite::Renderer::Renderer(SDL_Window * pWindow)
+Elite::Renderer::Renderer(SDL_Window * pWindow, uint32_t width, uint32_t height)
 	: m_pWindow{ pWindow }
-	, m_Width{}
-	, m_Height{}
-	, m_IsInitialized{ false }
-	, m_TextureDiffuse{ "Resources/vehicle_diffuse.png" }
-	, m_TextureNormal{ "Resources/vehicle_normal.png" }
-	, m_TextureGlossiness{ "Resources/vehicle_gloss.png" }
-	, m_TexureSpecularMap{ "Resources/vehicle_specular.png" }
+	, m_Width{ width }
+	, m_Height{ height }
+	, m_pSoftwareBackend{ nullptr }
+	, m_pDX11Backend{ nullptr }
+	, m_pActiveBackend{ nullptr }
+	, m_pCamera{ nullptr }
+	, m_OcclusionBuffer{ 0, 0 }
+	, m_Occluder{}
+	, m_IsOcclusionCulling{ true }
+	, m_Scene{}
+	, m_State{}
+	, m_Rotating{ false }
+	, m_Timer{}
+	, m_CameraVersion{}
+	, m_IsSceneDirty{ true }
+	, m_IsFrameDirty{ true }
 {
 	//Initialize Window
-	int width, height = 0;
-	SDL_GetWindowSize(pWindow, &width, &height);
-	m_Width = static_cast<uint32_t>(width);
-	m_Height = static_cast<uint32_t>(height);
+	if (pWindow)
+	{
+		int windowWidth, windowHeight = 0;
+		SDL_GetWindowSize(pWindow, &windowWidth, &windowHeight);
+		m_Width = static_cast<uint32_t>(windowWidth);
+		m_Height = static_cast<uint32_t>(windowHeight);
+	}
+
+	//Occluders only have to hide whole objects, half the resolution is plenty
+	m_OcclusionBuffer.Resize(m_Width / 2, m_Height / 2);
 
 	//Initialize Software Rasterizer
-	m_pFrontBuffer = SDL_GetWindowSurface(pWindow);
-	m_pBackBuffer = SDL_CreateRGBSurface(0, m_Width, m_Height, 32, 0, 0, 0, 0);
-	m_pBackBufferPixels = (uint32_t*)m_pBackBuffer->pixels;
+	m_pSoftwareBackend = new SoftwareBackend(pWindow, m_Width, m_Height);
+	m_pActiveBackend = m_pSoftwareBackend;
 
-	//Initialize DirectX pipeline
-	InitializeDirectX();
-	m_IsInitialized = true;
-	std::cout << "DirectX is ready\n";
+	//Initialize DirectX pipeline, there is no device to render with when headless
+#ifdef ELITE_BACKEND_DX11
+	if (pWindow)
+	{
+		DX11Backend* pDX11Backend = new DX11Backend(pWindow, m_Width, m_Height);
+		if (pDX11Backend->IsInitialized())
+		{
+			m_pDX11Backend = pDX11Backend;
+			std::cout << "DirectX is ready\n";
+		}
+		else
+		{
+			delete pDX11Backend;
+		}
+	}
+#endif
+
+	LoadMeshes();
+
+	//Initialize WorldMatrix & pipeline state
+	m_State.world[0] = { 1.f, 0.f, 0.f, 0.f };
+	m_State.world[1] = { 0.f, 1.f, 0.f, 0.f };
+	m_State.world[2] = { 0.f, 0.f, 1.f, 0.f };
+	m_State.world[3] = { 0.f, 0.f, -50.f, 1.f };
+	SetInstances({});
+	m_State.filter = Filtering::point;
+	m_State.cull = CullMode::back;
+	m_State.renderTransparent = false;
 
+	//Information output
+	std::cout << "Rotation: starting without rotating\n";
+	std::cout << "Cull mode: starting with backface culling\n";
+	std::cout << "Render mode: starting with software rasterizer\n";
+	std::cout << "Sample mode: starting with point filtering\n";
+	std::cout << "Fire mesh: starting without fire mesh\n";
+	std::cout << "Resolution governor: starting at native resolution\n";
+	std::cout << "Shading rate: starting with full rate shading\n";
+	std::cout << "Frame latency: starting with synchronous presenting\n";
+	std::cout << "Present mode: starting with blitting to the window surface\n";
+	std::cout << "Depth format: starting with 32 bit float\n";
+	std::cout << "Meshlet occlusion: starting with testing meshlets against the depth buffer\n";
+	std::cout << "Occlusion buffer: starting with culling objects behind the closest objects\n";
+	std::cout << "Debug view: starting with the shaded frame\n";
+}
+
+Elite::Renderer::~Renderer()
+{
+	delete m_pDX11Backend;
+	m_pDX11Backend = nullptr;
+
+	delete m_pSoftwareBackend;
+	m_pSoftwareBackend = nullptr;
+}
+
+void Elite::Renderer::LoadMeshes()
+{
 	std::vector<Elite::Vertex_Input> vertices;
 	std::vector<uint32_t> indices;
 	Elite::ParseOBJ("Resources/vehicle.obj", vertices, indices);
 
+	//Triangles share their vertices, so tangents are averaged & the mesh can be simplified
+	WeldVertices(vertices, indices);
+
 	//Calculate tangents
 	for (uint32_t i = 0; i < indices.size(); i += 3)
 	{
@@ -62,393 +131,217 @@ Elite::Renderer::Renderer(SDL_Window * pWindow)
 		vertices[index2].tangent += tangent;
 	}
 
+	for (auto& v : vertices)
+		v.tangent = Reject(v.tangent, v.normal);
+	NormalizeVectors(StridedSpan<FVector3>{ &vertices.front().tangent, vertices.size(), sizeof(Vertex_Input) });
+
+	AABB bounds{ FPoint3{ FLT_MAX, FLT_MAX, FLT_MAX }, FPoint3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } };
 	for (auto& v : vertices)
 	{
-		v.tangent = GetNormalized(Reject(v.tangent, v.normal));
 		v.position.z = -v.position.z;
 		v.normal.z = -v.normal.z;
 		v.tangent.z = -v.tangent.z;
+
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			bounds.min[i] = std::min(bounds.min[i], v.position[i]);
+			bounds.max[i] = std::max(bounds.max[i], v.position[i]);
+		}
 	}
 
-	//Vehicle Mesh
-	m_pMesh = new Mesh(m_pDevice, vertices, indices);
+	//Vehicle Mesh, the levels of detail are cached next to the obj
+	MeshData vehicle{ LoadLODChain("Resources/vehicle.obj.lod", vertices, indices), false };
+	m_pSoftwareBackend->AddMesh(vehicle);
+	if (m_pDX11Backend)
+		m_pDX11Backend->AddMesh(vehicle);
 
-	//Store vertices vehicle
-	m_Vertices = vertices;
-	m_Indices = indices;
-	m_TransformedVertices.resize(m_Vertices.size());
+	const MeshLOD& coarsest = vehicle.lods.back();
+	m_Occluder.positions.clear();
+	for (const Vertex_Input& v : coarsest.vertices)
+		m_Occluder.positions.push_back(v.position.xyz);
+	m_Occluder.indices = coarsest.indices;
+	m_Occluder.error = coarsest.error;
 
 	//Fire Mesh
 	Elite::ParseOBJ("Resources/fireFX.obj", vertices, indices);
-	m_pCombustion = new Mesh(m_pDevice, vertices, indices, true);
+	const MeshData fire{ { MeshLOD{ vertices, indices, 0.f } }, true };
+	m_pSoftwareBackend->AddMesh(fire);
+	if (m_pDX11Backend)
+		m_pDX11Backend->AddMesh(fire);
 
-	//Initialize WorldMatrix
-	m_World[0] = { 1.f, 0.f, 0.f, 0.f };
-	m_World[1] = { 0.f, 1.f, 0.f, 0.f };
-	m_World[2] = { 0.f, 0.f, 1.f, 0.f };
-	m_World[3] = { 0.f, 0.f, -50.f, 1.f };
+	for (const Vertex_Input& v : vertices)
+	{
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			bounds.min[i] = std::min(bounds.min[i], v.position[i]);
+			bounds.max[i] = std::max(bounds.max[i], v.position[i]);
+		}
+	}
 
-	//Initialize Depth Buffer
-	m_DepthBuffer.resize(m_Height * m_Width);
-	std::fill(m_DepthBuffer.begin(), m_DepthBuffer.end(), FLT_MAX);
+	//Every scene node draws all meshes, so its bounds have to hold all of them
+	m_Scene.SetModelBounds(bounds);
 
-	//Information output
-	std::cout << "Rotation: starting without rotating\n";
-	std::cout << "Cull mode: starting with backface culling\n";
-	std::cout << "Render mode: starting with software rasterizer\n";
-	std::cout << "Sample mode: starting with point filtering\n";
-	std::cout << "Fire mesh: starting without fire mesh\n";
+	std::vector<float> lodErrors{};
+	for (const MeshLOD& lod : vehicle.lods)
+		lodErrors.push_back(lod.error);
+	m_Scene.SetLodErrors(lodErrors);
 }
 
-Elite::Renderer::~Renderer()
+bool Elite::Renderer::Render()
 {
-	if (m_pDeviceContext)
+	ELITE_PROFILE_SCOPE("Renderer::Render");
+	if (m_pCamera->GetVersion() != m_CameraVersion || m_Scene.IsDirty())
+		m_IsSceneDirty = true;
+	//Frames that still wait behind the frame latency are shown once nothing new is rendered
+	if (!m_IsSceneDirty && !m_IsFrameDirty)
 	{
-		m_pDeviceContext->ClearState();
-		m_pDeviceContext->Flush();
-		m_pDeviceContext->Release();
+		m_pActiveBackend->Flush();
+		return false;
 	}
 
-	if (m_pRenderTargetView)
-	{
-		m_pRenderTargetView->Release();
-	}
-	if (m_pRenderTargetBuffer)
-	{
-		m_pRenderTargetBuffer->Release();
-	}
-	if (m_pDepthStencilView)
-	{
-		m_pDepthStencilView->Release();
-	}
-	if (m_pDepthStencilBuffer)
+	//The scene is culled in its own space, so rotating the world never refits the hierarchy
+	if (m_IsSceneDirty)
 	{
-		m_pDepthStencilBuffer->Release();
-	}
-	if (m_pSwapChain)
-	{
-		m_pSwapChain->Release();
-	}
-	if (m_pDevice)
-	{
-		m_pDevice->Release();
-	}
-	if (m_pDXGIFactory)
-	{
-		m_pDXGIFactory->Release();
+		m_Scene.Update();
+		const FMatrix4 sceneToClip = (m_pActiveBackend == m_pSoftwareBackend)
+			? SoftwareBackend::GetClipMatrix(m_pCamera->GetWorldToView(), m_pCamera->GetProjectionMatrix(), m_State.world)
+			: m_pCamera->GetProjectionMatrix() * m_pCamera->GetWorldToView() * m_State.world;
+		CullScene(sceneToClip, float(GetRenderHeight()), m_State.instances);
 	}
 
-	delete m_pMesh;
-	m_pMesh = nullptr;
+	m_pActiveBackend->Render(m_State);
 
-	delete m_pCombustion;
-	m_pCombustion = nullptr;
+	m_CameraVersion = m_pCamera->GetVersion();
+	m_IsSceneDirty = false;
+	m_IsFrameDirty = false;
+	return true;
 }
 
-void Elite::Renderer::Render()
+void Elite::Renderer::CullScene(const FMatrix4& sceneToClip, float viewportHeight, std::vector<InstanceData>& visible)
 {
-	if (m_UsingDirectx11)
+	ELITE_PROFILE_SCOPE("CullScene");
+	m_Scene.Cull(sceneToClip, viewportHeight, visible);
+	if (!m_IsOcclusionCulling || visible.size() <= 1)
+		return;
+
+	//The visible objects closest to the camera hide the most, measured by the clip w of their origin
+	std::vector<std::pair<float, uint32_t>> distances{};
+	for (uint32_t i = 0; i < visible.size(); ++i)
 	{
-		if (!m_IsInitialized)
-			return;
-
-		//Clear Buffers
-		RGBColor clearColor = RGBColor(0.1f, 0.1f, 0.1f);
-		m_pDeviceContext->ClearRenderTargetView(m_pRenderTargetView, &clearColor.r);
-		m_pDeviceContext->ClearDepthStencilView(m_pDepthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
-
-		//Render
-		m_pMesh->Render(m_pDeviceContext, m_Filter, m_Cull, m_World);
-		if(m_UsingFireMesh)
-			m_pCombustion->Render(m_pDeviceContext, m_Filter, m_Cull, m_World);
-
-		//Present
-		m_pSwapChain->Present(0, 0);
+		const FVector4& origin = visible[i].world[3];
+		distances.push_back({ sceneToClip[0][3] * origin.x + sceneToClip[1][3] * origin.y + sceneToClip[2][3] * origin.z + sceneToClip[3][3], i });
 	}
-	else
-	{
-		//Clear Buffers
-		SDL_LockSurface(m_pBackBuffer);
-		SDL_FillRect(m_pBackBuffer, NULL, 0x191919);
+	const uint32_t amountOfOccluders = std::min(uint32_t(distances.size()), MaxOccluders);
+	std::partial_sort(distances.begin(), distances.begin() + amountOfOccluders, distances.end());
 
-		//Render
-		ProjectionStage();
-		RasterizerStage();
-
-		//Reset Depth Buffer
-		std::fill(m_DepthBuffer.begin(), m_DepthBuffer.end(), FLT_MAX);
-
-		//Clean up
-		SDL_UnlockSurface(m_pBackBuffer);
-		SDL_BlitSurface(m_pBackBuffer, 0, m_pFrontBuffer, 0);
-		SDL_UpdateWindowSurface(m_pWindow);
+	FMatrix4 clipMatrix = sceneToClip;
+	{
+		ELITE_PROFILE_SCOPE("RenderOccluders");
+		m_OcclusionBuffer.Clear();
+		for (uint32_t i = 0; i < amountOfOccluders; ++i)
+			m_OcclusionBuffer.RenderOccluder(m_Occluder, clipMatrix * visible[distances[i].second].world);
 	}
-}
 
-void Elite::Renderer::ProjectionStage()
-{
-	for (int i{}; i < m_Vertices.size(); i++)
-	{	
-		FMatrix4 ONB = (m_pCamera->GetWorldToView());
-		FMatrix4 worldViewProjectionMatrix = m_pCamera->GetProjectionMatrix() * (ONB) * m_World;
-
-		//Transform vertices
-		Vertex_Input transFormedVertix{};
-		transFormedVertix.position = worldViewProjectionMatrix * m_Vertices[i].position;
-		transFormedVertix.uv = m_Vertices[i].uv;
-		transFormedVertix.normal = Elite::FVector3((m_World * Elite::FVector4{ m_Vertices[i].normal.x, m_Vertices[i].normal.y, m_Vertices[i].normal.z, 1.f }).xyz);
-		transFormedVertix.tangent = Elite::FVector3((m_World * Elite::FVector4{ m_Vertices[i].tangent.x, m_Vertices[i].tangent.y, m_Vertices[i].tangent.z, 1.f }).xyz);
-		transFormedVertix.viewDirection = Elite::FVector3((m_World * m_Vertices[i].position - ONB[3]).xyz);
-
-		//Make the mesh visible
-		transFormedVertix.position.w *= 10;
-
-		//Perspective divide
-		transFormedVertix.position.x = transFormedVertix.position.x / transFormedVertix.position.w;
-		transFormedVertix.position.y = transFormedVertix.position.y / transFormedVertix.position.w;
-		transFormedVertix.position.z = transFormedVertix.position.z / transFormedVertix.position.w;
-
-		transFormedVertix.viewDirection = GetNormalized(transFormedVertix.viewDirection);
-
-		m_TransformedVertices[i] = (transFormedVertix);
-	}
+	m_Scene.Cull(sceneToClip, viewportHeight, visible, &m_OcclusionBuffer);
 }
 
-void Elite::Renderer::RasterizerStage()
+void Elite::Renderer::SetInstances(const std::vector<InstanceData>& instances)
 {
-	for (int i{}; i < m_Indices.size(); i+=3)
-	{
-		std::vector<Elite::Vertex_Input> NDCVertices = { m_TransformedVertices[m_Indices[i]], m_TransformedVertices[m_Indices[i + 1]], m_TransformedVertices[m_Indices[i + 2]] };
-
-		//Frustum culling
-		bool culling = false;
-		for (int i{}; i < NDCVertices.size(); i++)
-		{
-			if (NDCVertices[i].position.x < -1.0f || NDCVertices[i].position.x > 1.0f)
-			{
-				culling = true;
-			}
-			if (NDCVertices[i].position.y < -1.0f || NDCVertices[i].position.y > 1.0f)
-			{
-				culling = true;
-			}
-			if (NDCVertices[i].position.z < 0.0f || NDCVertices[i].position.z > 1.0f)
-			{
-				culling = true;
-			}
-
-			//Rasterization stage
-			NDCVertices[i].position.x = ((NDCVertices[i].position.x + 1) / 2.0f) * m_Width;
-			NDCVertices[i].position.y = ((1 - NDCVertices[i].position.y) / 2.0f) * m_Height;
-		}
-
-		if (!culling)
-		{
-			//Bounding Box
-			Elite::FPoint2 topLeft = Elite::FPoint2{ std::min(std::min(NDCVertices[0].position.x, NDCVertices[1].position.x), NDCVertices[2].position.x),
-				std::min(std::min(NDCVertices[0].position.y, NDCVertices[1].position.y), NDCVertices[2].position.y) };
-
-			Elite::FPoint2 bottomRight = Elite::FPoint2{ std::max(std::max(NDCVertices[0].position.x, NDCVertices[1].position.x), NDCVertices[2].position.x),
-				std::max(std::max(NDCVertices[0].position.y, NDCVertices[1].position.y), NDCVertices[2].position.y) };
-
-			topLeft.x = Elite::Clamp(topLeft.x, 0.f, float(m_Width));
-			topLeft.y = Elite::Clamp(topLeft.y, 0.f, float(m_Height));
-			bottomRight.x = Elite::Clamp(bottomRight.x, 0.f, float(m_Width));
-			bottomRight.y = Elite::Clamp(bottomRight.y, 0.f, float(m_Height));
-
-			for (uint32_t r = uint32_t(topLeft.y); r < bottomRight.y; ++r)
-			{
-				for (uint32_t c = uint32_t(topLeft.x); c < bottomRight.x; ++c)
-				{
-					Elite::Vertex_Input pixel{};
-					pixel.position = { float(c), float(r), 0, 0 };
-
-					if (IsInTriangle(pixel, NDCVertices))
-					{
-						if (pixel.position.z < m_DepthBuffer[c + (r * m_Width)])
-						{
-							m_DepthBuffer[c + (r * m_Width)] = pixel.position.z;
-							Elite::RGBColor finalColor{};
-							finalColor += PixelShading(pixel);
-
-							finalColor.MaxToOne();
-							m_pBackBufferPixels[c + (r * m_Width)] = SDL_MapRGB(m_pBackBuffer->format,
-								static_cast<uint8_t>(uint8_t(finalColor.r * 255)),
-								static_cast<uint8_t>(uint8_t(finalColor.g * 255)),
-								static_cast<uint8_t>(uint8_t(finalColor.b * 255)));
-						}
-
-					}
-				}
-			}
-		}
-	}
+	//Without instances the meshes are drawn once, at the world matrix
+	m_Scene.Clear();
+	if (instances.empty())
+		m_Scene.AddNode(FMatrix4::Identity(), RGBColor{ 1.f, 1.f, 1.f });
+	for (const InstanceData& instance : instances)
+		m_Scene.AddNode(instance.world, instance.tint);
+	m_Scene.Update();
+	m_IsSceneDirty = true;
 }
 
-bool Elite::Renderer::IsInTriangle(Elite::Vertex_Input& pointToHit, const std::vector<Elite::Vertex_Input>& ndcPoints) const
+void Elite::Renderer::Update(float dT)
 {
-	//Baycentric
-	Elite::FVector2 pointToSideA = FVector2((pointToHit.position - ndcPoints[0].position));
-	Elite::FVector2 pointToSideB = FVector2((pointToHit.position - ndcPoints[1].position));
-	Elite::FVector2 pointToSideC = FVector2((pointToHit.position - ndcPoints[2].position));
-
-	const Elite::FVector2 edgeA{ ndcPoints[1].position - ndcPoints[0].position };
-	const Elite::FVector2 edgeB{ ndcPoints[2].position - ndcPoints[1].position };
-	const Elite::FVector2 edgeC{ ndcPoints[0].position - ndcPoints[2].position };
-
-	float W0 = Elite::Cross(pointToSideB, edgeB);
-	float W1 = Elite::Cross(pointToSideC, edgeC);
-	float W2 = Elite::Cross(pointToSideA, edgeA);
-
-	//Cull mode
-	if (m_Cull == CullMode::back)
-	{
-		if (W2 < 0 || W1 < 0 || W0 < 0)
-		{
-			return false;
-		}
-	}
-	else if (m_Cull == CullMode::front)
-	{
-		if (W2 > 0 || W1 > 0 || W0 > 0)
-		{
-			return false;
-		}
-	}
-	else if (m_Cull == CullMode::none)
+	if (m_Rotating)
 	{
-		if (!((W2 < 0 && W1 < 0 && W0 < 0) || (W2 > 0 && W1 > 0 && W0 > 0)))
-		{
-			return false;
-		}
+		m_Timer += dT;
+		SetWorldRotation(m_Timer);
 	}
 
-	//Interpolate between vertex values
-	W0 = abs(W0 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
-	W1 = abs(W1 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
-	W2 = abs(W2 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
-
-	auto interpolatedZ = (1 / (((1 / (ndcPoints[0].position.z)) * W0) + ((1 / (ndcPoints[1].position.z)) * W1) + ((1 / (ndcPoints[2].position.z)) * W2)));
-	pointToHit.position.z = interpolatedZ;
-
-	auto interpolatedW = (1 / (((1 / (ndcPoints[0].position.w)) * W0) + ((1 / (ndcPoints[1].position.w)) * W1) + ((1 / (ndcPoints[2].position.w)) * W2)));
-
-	pointToHit.uv = (((ndcPoints[0].uv / ndcPoints[0].position.w) * W0) + ((ndcPoints[1].uv / ndcPoints[1].position.w) * W1)
-		+ ((ndcPoints[2].uv / ndcPoints[2].position.w) * W2)) * interpolatedW;
-
-	pointToHit.normal = ndcPoints[0].normal * W0 + ndcPoints[1].normal * W1 + ndcPoints[2].normal * W2;
-	pointToHit.normal = GetNormalized(pointToHit.normal);
-
-	pointToHit.tangent = ndcPoints[0].tangent * W0 + ndcPoints[1].tangent * W1 + ndcPoints[2].tangent * W2;
-
-	pointToHit.viewDirection = ndcPoints[0].viewDirection * W0 + ndcPoints[1].viewDirection * W1 + ndcPoints[2].viewDirection * W2;
-	pointToHit.viewDirection = GetNormalized(pointToHit.viewDirection);
-	return true;
+	//Only the software rasterizer is governed, DirectX always renders at window size
+	//Levels of detail are picked for the render height, so a new resolution needs a new cull
+	const uint32_t renderWidth = GetRenderWidth();
+	const uint32_t renderHeight = GetRenderHeight();
+	m_pActiveBackend->Update(dT, m_State);
+	if (GetRenderWidth() != renderWidth || GetRenderHeight() != renderHeight)
+		m_IsSceneDirty = true;
 }
 
-Elite::RGBColor Elite::Renderer::PixelShading(const Elite::Vertex_Input& v) const
+void Elite::Renderer::SetWorldRotation(float angle)
 {
-	//Direction light
-	FVector3 lightDir = { 0.577f, -0.577f, -0.577f };
-	Elite::RGBColor lightColor = { 1.f,1.f,1.f };
-	float intensity = 7.f;
-
-	float observedArea{};
-
-	//Calculate normals in tangent space
-	Elite::RGBColor normalRgb = m_TextureNormal.Sample(v.uv);
-	Elite::FVector3 normal{ normalRgb.r, normalRgb.g, normalRgb.b };
-	Elite::FVector3 binormal = Cross(v.tangent, v.normal);
-	Elite::FMatrix3 tangentSpaceAxis = FMatrix3(v.tangent, binormal, v.normal);
-
-	normal.x = 2.f * normal.x - 1.f;
-	normal.y = 2.f * normal.y - 1.f;
-	normal.z = 2.f * normal.z - 1.f;
-
-	normal = tangentSpaceAxis * normal;
-	normal = GetNormalized(normal);
-
-	//Calculate cosine law
-	observedArea = Elite::Dot(normal, -lightDir);
-	observedArea = Clamp(observedArea, 0.f, 1.f);
-	observedArea /= float(M_PI);
-
-	//Calculate Phong
-	float shininess = 25.f;
-	auto phongColor = BRDF::Phong(m_TexureSpecularMap.Sample(v.uv), shininess * m_TextureGlossiness.Sample(v.uv).r, lightDir, v.viewDirection, v.normal);
-	auto diffuseColor = m_TextureDiffuse.Sample(v.uv);
-	auto ambientColor = Elite::RGBColor{ 0.025f, 0.025f, 0.025f };
-
-	diffuseColor += phongColor + ambientColor;
-	diffuseColor.MaxToOne();
-
-	auto finalColor = lightColor * intensity * diffuseColor * observedArea;
-	return finalColor;
+	const FMatrix4 rotation = Elite::MakeRotationY(angle);
+	m_State.world[0] = rotation[0];
+	m_State.world[1] = rotation[1];
+	m_State.world[2] = rotation[2];
+	m_IsSceneDirty = true;
 }
 
-void Elite::Renderer::Update(float dT)
+void Elite::Renderer::SetCamera(Camera* pCamera)
 {
-	if (m_Rotating)
-	{
-		m_Timer += dT;
-		Elite::FMatrix4 rotation{};
-
-		rotation = Elite::MakeRotationY((m_Timer));
-
-		m_World[0] = rotation[0];
-		m_World[1] = rotation[1];
-		m_World[2] = rotation[2];
-	}
+	m_pCamera = pCamera;
+	m_IsSceneDirty = true;
+	m_pSoftwareBackend->SetCamera(pCamera);
+	if (m_pDX11Backend)
+		m_pDX11Backend->SetCamera(pCamera);
+}
 
-	m_pMesh->Update(dT, m_World);
-	m_pCombustion->Update(dT, m_World);
+uint32_t Elite::Renderer::GetRenderWidth() const
+{
+	return (m_pActiveBackend == m_pSoftwareBackend) ? m_pSoftwareBackend->GetRenderWidth() : m_Width;
 }
 
-void Elite::Renderer::SetCamera(Camera* pCamera)
+uint32_t Elite::Renderer::GetRenderHeight() const
 {
-	m_pCamera = pCamera;
-	m_pMesh->SetCamera(pCamera);
-	m_pCombustion->SetCamera(pCamera);
+	return (m_pActiveBackend == m_pSoftwareBackend) ? m_pSoftwareBackend->GetRenderHeight() : m_Height;
 }
 
 void Elite::Renderer::ToggleCullMode()
 {
-	if (m_Cull == CullMode::back)
+	if (m_State.cull == CullMode::back)
 	{
-		m_Cull = CullMode::front;
+		m_State.cull = CullMode::front;
 		std::cout << "CullMode: changed to front culling\n";
 	}
-	else if (m_Cull == CullMode::front)
+	else if (m_State.cull == CullMode::front)
 	{
-		m_Cull = CullMode::none;
+		m_State.cull = CullMode::none;
 		std::cout << "CullMode: changed to no culling\n";
 	}
-	else if (m_Cull == CullMode::none)
+	else if (m_State.cull == CullMode::none)
 	{
-		m_Cull = CullMode::back;
+		m_State.cull = CullMode::back;
 		std::cout << "CullMode: changed to back culling\n";
 	}
+	m_IsFrameDirty = true;
 }
 
 void Elite::Renderer::ToggleSample()
 {
-	if (m_UsingDirectx11)
+	if (m_pActiveBackend == m_pDX11Backend)
 	{
-		if (m_Filter == Filtering::point)
+		if (m_State.filter == Filtering::point)
 		{
-			m_Filter = Filtering::linear;
+			m_State.filter = Filtering::linear;
 			std::cout << "Sample State: changed to linear sampling\n";
 		}
-		else if (m_Filter == Filtering::linear)
+		else if (m_State.filter == Filtering::linear)
 		{
-			m_Filter = Filtering::anisotropic;
+			m_State.filter = Filtering::anisotropic;
 			std::cout << "Sample State: changed to anisotropic sampling\n";
 		}
-		else if (m_Filter == Filtering::anisotropic)
+		else if (m_State.filter == Filtering::anisotropic)
 		{
-			m_Filter = Filtering::point;
+			m_State.filter = Filtering::point;
 			std::cout << "Sample State: changed to point sampling\n";
 		}
+		m_IsFrameDirty = true;
 	}
 }
 
@@ -463,121 +356,40 @@ void Elite::Renderer::ToggleRotation()
 
 void Elite::Renderer::ToggleFireMesh()
 {
-	if (m_UsingDirectx11)
-	{
-		m_UsingFireMesh = !m_UsingFireMesh;
-		if(m_UsingFireMesh)
-			std::cout << "Fire Mesh: rendering fire mesh\n";
-		else
-			std::cout << "Fire Mesh: not rendering fire mesh\n";
-	}
+	m_State.renderTransparent = !m_State.renderTransparent;
+	m_IsFrameDirty = true;
+	if(m_State.renderTransparent)
+		std::cout << "Fire Mesh: rendering fire mesh\n";
+	else
+		std::cout << "Fire Mesh: not rendering fire mesh\n";
 }
 
-void Elite::Renderer::ToggleRenderMode()
+void Elite::Renderer::ToggleOcclusionCulling()
 {
-	m_UsingDirectx11 = !m_UsingDirectx11;
-	m_pCamera->SetRenderMode();
-	if (m_UsingDirectx11)
-		std::cout << "Render mode: changed to Directx11\n";
+	m_IsOcclusionCulling = !m_IsOcclusionCulling;
+	m_IsSceneDirty = true;
+	if (m_IsOcclusionCulling)
+		std::cout << "Occlusion buffer: changed to culling objects behind the closest objects\n";
 	else
-		std::cout << "Render mode: changed to Software Rasterizer\n";
+		std::cout << "Occlusion buffer: changed to frustum culling only\n";
 }
 
-HRESULT Elite::Renderer::InitializeDirectX()
+void Elite::Renderer::ToggleRenderMode()
 {
-	//Create device & device context using hardware acceleration
-	D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
-	uint32_t createDeviceFlags = 0;
-#if defined(DEBUG) || defined(_DEBUG)
-	createDeviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
-#endif
-	HRESULT result = D3D11CreateDevice(0, D3D_DRIVER_TYPE_HARDWARE, 0, createDeviceFlags, 0, 0, D3D11_SDK_VERSION, &m_pDevice, &featureLevel, &m_pDeviceContext);
-
-	//Create DGXI Factory to create Swapchain based on hardware
-	result = CreateDXGIFactory(__uuidof(IDXGIFactory), reinterpret_cast<void**>(&m_pDXGIFactory));
-	if (FAILED(result))
-		return result;
-
-	//Create Swapchain Descriptor
-	DXGI_SWAP_CHAIN_DESC swapChainDesc{};
-	swapChainDesc.BufferDesc.Width = m_Width;
-	swapChainDesc.BufferDesc.Height = m_Height;
-	swapChainDesc.BufferDesc.RefreshRate.Numerator = 1;
-	swapChainDesc.BufferDesc.RefreshRate.Denominator = 60;
-	swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-	swapChainDesc.BufferDesc.ScanlineOrdering = DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED;
-	swapChainDesc.BufferDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
-	swapChainDesc.SampleDesc.Count = 1;
-	swapChainDesc.SampleDesc.Quality = 0;
-	swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-	swapChainDesc.BufferCount = 1;
-	swapChainDesc.Windowed = true;
-	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-	swapChainDesc.Flags = 0;
-
-	//Get the handle HWMD from the SDL backbuffer
-	SDL_SysWMinfo sysWMInfo{};
-	SDL_VERSION(&sysWMInfo.version);
-	SDL_GetWindowWMInfo(m_pWindow, &sysWMInfo);
-	swapChainDesc.OutputWindow = sysWMInfo.info.win.window;
-
-	//Create Swapchain and hook it into the handle of the SDL winwow
-	if(m_pDevice)
-		result = m_pDXGIFactory->CreateSwapChain(m_pDevice, &swapChainDesc, &m_pSwapChain);
-	if (FAILED(result))
-		return result;
-
-	//Create the Depth/Stencil Buffer and View
-	D3D11_TEXTURE2D_DESC depthStencilDesc{};
-	depthStencilDesc.Width = m_Width;
-	depthStencilDesc.Height = m_Height;
-	depthStencilDesc.MipLevels = 1;
-	depthStencilDesc.ArraySize = 1;
-	depthStencilDesc.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-	depthStencilDesc.SampleDesc.Count = 1;
-	depthStencilDesc.SampleDesc.Quality = 0;
-	depthStencilDesc.Usage = D3D11_USAGE_DEFAULT;
-	depthStencilDesc.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-	depthStencilDesc.CPUAccessFlags = 0;
-	depthStencilDesc.MiscFlags = 0;
-
-	D3D11_DEPTH_STENCIL_VIEW_DESC depthStencilViewDesc{};
-	depthStencilViewDesc.Format = depthStencilDesc.Format;
-	depthStencilViewDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-	depthStencilViewDesc.Texture2D.MipSlice = 0;
-
-	result = m_pDevice->CreateTexture2D(&depthStencilDesc, 0, &m_pDepthStencilBuffer);
-	if (FAILED(result))
-		return result;
-
-	result = m_pDevice->CreateDepthStencilView(m_pDepthStencilBuffer, &depthStencilViewDesc, &m_pDepthStencilView);
-	if (FAILED(result))
-		return result;
-
-	//Create the RenderTargetView
-	result = m_pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&m_pRenderTargetBuffer));
-	if (FAILED(result))
-		return result;
-
-	result = m_pDevice->CreateRenderTargetView(m_pRenderTargetBuffer, 0, &m_pRenderTargetView);
-	if (FAILED(result))
-		return result;
-
-	//Bind the Views to the Output Merger Stage
-	m_pDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, m_pDepthStencilView);
-
-	//Set the Viewport
-	D3D11_VIEWPORT viewPort{};
-	viewPort.Width = static_cast<float>(m_Width);
-	viewPort.Height = static_cast<float>(m_Height);
-	viewPort.TopLeftX = 0.f;
-	viewPort.TopLeftY = 0.f;
-	viewPort.MinDepth = 0.f;
-	viewPort.MaxDepth = 1.f;
-	m_pDeviceContext->RSSetViewports(1, &viewPort);
-
-	return result;
-}
-
+	if (!m_pDX11Backend)
+	{
+		std::cout << "Render mode: DirectX is not available\n";
+		return;
+	}
 
+	//Queued frames must not be presented over the other backend's output
+	m_pActiveBackend->Flush();
 
+	m_pActiveBackend = (m_pActiveBackend == m_pSoftwareBackend) ? m_pDX11Backend : m_pSoftwareBackend;
+	m_pCamera->SetRenderMode();
+	m_IsSceneDirty = true;
+	if (m_pActiveBackend == m_pDX11Backend)
+		std::cout << "Render mode: changed to Directx11\n";
+	else
+		std::cout << "Render mode: changed to Software Rasterizer\n";
+}
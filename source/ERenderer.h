@@ -8,21 +8,23 @@
 #define	ELITE_RAYTRACING_RENDERER
 
 #include <cstdint>
+#include <string>
 #include <vector>
 #include "ECamera.h"
-#include "Texture.h"
+#include "RenderBackend.h"
+#include "SoftwareBackend.h"
+#include "Scene.h"
+#include "OcclusionBuffer.h"
 
 struct SDL_Window;
-struct SDL_Surface;
-
-class Mesh;
 
 namespace Elite
 {
 	class Renderer final
 	{
 	public:
-		Renderer(SDL_Window* pWindow);
+		//Without a window the renderer runs headless: software rasterizer only, rendered offscreen at width x height
+		Renderer(SDL_Window* pWindow, uint32_t width = 0, uint32_t height = 0);
 		~Renderer();
 
 		Renderer(const Renderer&) = delete;
@@ -30,78 +32,93 @@ namespace Elite
 		Renderer& operator=(const Renderer&) = delete;
 		Renderer& operator=(Renderer&&) noexcept = delete;
 
-		void Render();
+		//Returns false when nothing changed since the last frame, that frame is still on screen & nothing is rendered
+		//When only settings changed that do not move anything, the culled instances of the last frame are drawn again
+		bool Render();
+		//Frustum culls the scene, then culls it again behind the closest visible objects when occlusion culling is on
+		void CullScene(const FMatrix4& sceneToClip, float viewportHeight, std::vector<InstanceData>& visible);
 
 		void Update(float dT);
 
 		void SetCamera(Camera* pCamera);
+		//Forces the next frame to be rendered, e.g. when the window was covered
+		void Invalidate() { m_IsFrameDirty = true; };
+		//Replaces the scene with one node per instance, placed relative to the rotating world matrix
+		void SetInstances(const std::vector<InstanceData>& instances);
 		void ToggleRenderMode();
 		void ToggleCullMode();
 		void ToggleSample();
 		void ToggleRotation();
 		void ToggleFireMesh();
+		void ToggleOcclusionCulling();
+		void ToggleResolutionGovernor() { m_pSoftwareBackend->ToggleResolutionGovernor(); m_IsSceneDirty = true; };
+		void ToggleShadingRate() { m_pSoftwareBackend->ToggleShadingRate(); m_IsFrameDirty = true; };
+		void ToggleFrameLatency() { m_pSoftwareBackend->ToggleFrameLatency(); m_IsFrameDirty = true; };
+		void TogglePresentMode() { m_pSoftwareBackend->TogglePresentMode(); m_IsFrameDirty = true; };
+		void ToggleDepthFormat() { m_pSoftwareBackend->ToggleDepthFormat(); m_IsFrameDirty = true; };
+		void ToggleMeshletOcclusion() { m_pSoftwareBackend->ToggleMeshletOcclusion(); m_IsFrameDirty = true; };
+		void ToggleDebugView() { m_pSoftwareBackend->ToggleDebugView(); m_IsFrameDirty = true; };
+		void SetPresentMode(PresentMode presentMode) { m_pSoftwareBackend->SetPresentMode(presentMode); m_IsFrameDirty = true; };
+		void SetDebugView(DebugView debugView) { m_pSoftwareBackend->SetDebugView(debugView); m_IsFrameDirty = true; };
+		void SetShadingRateMode(ShadingRateMode shadingRateMode) { m_pSoftwareBackend->SetShadingRateMode(shadingRateMode); m_IsFrameDirty = true; };
+		void SetDepthFormat(DepthFormat depthFormat) { m_pSoftwareBackend->SetDepthFormat(depthFormat); m_IsFrameDirty = true; };
+		//Rotates the world around y to an angle in radians, the rotation toggle keeps turning it from its own timer
+		void SetWorldRotation(float angle);
+
+		//Counters of the last frame the software rasterizer rendered
+		//Overwritten fragments, covered pixels & overdraw are only counted with pixel statistics or a debug view
+		const FrameStatistics& GetFrameStatistics() const { return m_pSoftwareBackend->GetFrameStatistics(); };
+		void SetPixelStatistics(bool isEnabled) { m_pSoftwareBackend->SetPixelStatistics(isEnabled); };
+
+		uint32_t GetRenderWidth() const;
+		uint32_t GetRenderHeight() const;
+
+		//Last finished software frame in the back buffer format, no copy is made
+		const uint32_t* GetFramePixels() const { return m_pSoftwareBackend->GetFramePixels(); };
+		uint32_t GetFrameWidth() const { return m_Width; };
+		uint32_t GetFrameHeight() const { return m_Height; };
+		bool SaveFrame(const std::string& filePath) const { return m_pSoftwareBackend->SaveFrame(filePath); };
+		bool IsHeadless() const { return m_pWindow == nullptr; };
+
+		//Read only access for rendering batches of frames on other threads
+		const SoftwareBackend& GetSoftwareBackend() const { return *m_pSoftwareBackend; };
+		const PipelineState& GetPipelineState() const { return m_State; };
+		//Only the nodes in the camera frustum are handed to the backend every frame
+		Scene& GetScene() { return m_Scene; };
+		uint32_t GetAmountOfVisibleObjects() const { return uint32_t(m_State.instances.size()); };
 
 	private:
-		//Directx11 Initalization
-		HRESULT InitializeDirectX();
-
-		ID3D11Device* m_pDevice;
-		ID3D11DeviceContext* m_pDeviceContext;
-		IDXGIFactory* m_pDXGIFactory;
-		IDXGISwapChain* m_pSwapChain;
-		ID3D11Texture2D* m_pDepthStencilBuffer;
-		ID3D11DepthStencilView* m_pDepthStencilView;
-		ID3D11Resource* m_pRenderTargetBuffer;
-		ID3D11RenderTargetView* m_pRenderTargetView;
-
-		bool m_IsInitialized;
+		void LoadMeshes();
 
 		//Basic Window
 		SDL_Window* m_pWindow;
 		uint32_t m_Width;
 		uint32_t m_Height;
 
-		//Software Rasterizer
-		SDL_Surface* m_pFrontBuffer = nullptr;
-		SDL_Surface* m_pBackBuffer = nullptr;
-		uint32_t* m_pBackBufferPixels = nullptr;
-		std::vector<float> m_DepthBuffer{};
-
-		void ProjectionStage();
-		void RasterizerStage();
-
-		bool IsInTriangle(Elite::Vertex_Input& pointToHit, const std::vector<Elite::Vertex_Input>& ndcPoints) const;
-		Elite::RGBColor PixelShading(const Elite::Vertex_Input& v) const;
-
-		//Vertices
-		std::vector<Elite::Vertex_Input> m_Vertices;
-		std::vector<Elite::Vertex_Input> m_TransformedVertices;
-		std::vector<uint32_t> m_Indices;
-
-		std::vector<Elite::Triangle> m_Triangles;
-		std::vector<Elite::Triangle> m_TransformedTriangles;
-
-		//Textures
-		Elite::Texture m_TextureDiffuse;
-		Elite::Texture m_TextureNormal;
-		Elite::Texture m_TexureSpecularMap;
-		Elite::Texture m_TextureGlossiness;
-
-		//Meshes
-		Mesh* m_pMesh;
-		Mesh* m_pCombustion;
+		//Backends, DirectX is only available when it is compiled in & there is a window
+		SoftwareBackend* m_pSoftwareBackend;
+		RenderBackend* m_pDX11Backend;
+		RenderBackend* m_pActiveBackend;
 
 		//Camera
 		Camera* m_pCamera;
 
+		//Occlusion culling, the closest objects are drawn with their coarsest level of detail
+		static const uint32_t MaxOccluders = 16;
+		OcclusionBuffer m_OcclusionBuffer;
+		Occluder m_Occluder;
+		bool m_IsOcclusionCulling;
+
 		//Other
-		Elite::Filtering m_Filter;
-		Elite::CullMode m_Cull;
-		bool m_UsingFireMesh;
+		Scene m_Scene;
+		PipelineState m_State;
 		bool m_Rotating;
-		bool m_UsingDirectx11;
 		float m_Timer;
-		Elite::FMatrix4 m_World;
+
+		//Change tracking, a dirty scene is culled again, a dirty frame only drawn again
+		uint32_t m_CameraVersion;
+		bool m_IsSceneDirty;
+		bool m_IsFrameDirty;
 	};
 }
 
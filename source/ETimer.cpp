@@ -1,6 +1,23 @@
 #include "pch.h"
 #include "ETimer.h"
 #include "SDL.h"
+#include <iomanip>
+#include <string>
+
+namespace
+{
+	//Upper edges of the histogram buckets in milliseconds, the last bucket holds everything slower
+	const uint32_t HistogramEdges[]{ 1, 2, 4, 8, 12, 16, 20, 25, 33, 50, 66, 100, 150, 200, 300, 500, 1000 };
+	const uint32_t AmountOfHistogramBuckets = sizeof(HistogramEdges) / sizeof(HistogramEdges[0]) + 1;
+	const uint32_t HistogramBarLength = 40;
+
+	//Nearest rank, the smallest frame time that at least the fraction of the frames is at or below
+	float GetPercentile(const std::vector<uint64_t>& sortedFrameTimes, float fraction, float secondsPerCount)
+	{
+		const uint32_t rank = uint32_t(std::ceil(Elite::Clamp(fraction, 0.f, 1.f) * float(sortedFrameTimes.size())));
+		return float(sortedFrameTimes[std::max(rank, 1u) - 1] * secondsPerCount);
+	}
+}
 
 Elite::Timer::Timer()
 	: m_BaseTime{}
@@ -20,7 +37,17 @@ Elite::Timer::Timer()
 
 	, m_IsStopped{ true }
 	, m_ForceElapsedUpperBound{ false }
+
+	, m_FrameTimes(FrameTimeWindow, 0)
+	, m_FrameTimeIndex{}
+	, m_AmountOfFrameTimes{}
+	, m_HitchThreshold{}
+	, m_AmountOfHitches{}
+	, m_TotalAmountOfHitches{}
+	, m_IsHitch{ false }
 {
+	//Two missed refreshes at 60 Hz
+	SetHitchThreshold(1.f / 30.f);
 }
 
 void Elite::Timer::Reset()
@@ -33,6 +60,12 @@ void Elite::Timer::Reset()
 	m_FPSTimer = 0.0f;
 	m_FPSCount = 0;
 	m_IsStopped = false;
+
+	m_FrameTimeIndex = 0;
+	m_AmountOfFrameTimes = 0;
+	m_AmountOfHitches = 0;
+	m_TotalAmountOfHitches = 0;
+	m_IsHitch = false;
 }
 
 void Elite::Timer::Start()
@@ -49,8 +82,9 @@ void Elite::Timer::Start()
 	}
 }
 
-void Elite::Timer::Update()
+void Elite::Timer::Update(bool isFrameRecorded)
 {
+	m_IsHitch = false;
 	if (m_IsStopped)
 	{
 		m_FPS = 0;
@@ -62,9 +96,28 @@ void Elite::Timer::Update()
 	uint64_t currentTime = SDL_GetPerformanceCounter();
 	m_CurrentTime = currentTime;
 
-	m_ElapsedTime = (float)((m_CurrentTime - m_PreviousTime) * m_SecondsPerCount);
+	const uint64_t frameTime = m_CurrentTime - m_PreviousTime;
+	m_ElapsedTime = (float)(frameTime * m_SecondsPerCount);
 	m_PreviousTime = m_CurrentTime;
 
+	//The raw ticks are recorded, the oldest frame drops out of the window once it is full
+	if (isFrameRecorded)
+	{
+		if (m_AmountOfFrameTimes == FrameTimeWindow && m_FrameTimes[m_FrameTimeIndex] > m_HitchThreshold)
+			--m_AmountOfHitches;
+
+		m_FrameTimes[m_FrameTimeIndex] = frameTime;
+		m_FrameTimeIndex = (m_FrameTimeIndex + 1) % FrameTimeWindow;
+		m_AmountOfFrameTimes = std::min(m_AmountOfFrameTimes + 1, FrameTimeWindow);
+
+		m_IsHitch = frameTime > m_HitchThreshold;
+		if (m_IsHitch)
+		{
+			++m_AmountOfHitches;
+			++m_TotalAmountOfHitches;
+		}
+	}
+
 	if (m_ElapsedTime < 0.0f)
 		m_ElapsedTime = 0.0f;
 
@@ -96,3 +149,80 @@ void Elite::Timer::Stop()
 		m_IsStopped = true;
 	}
 }
+
+void Elite::Timer::SetHitchThreshold(float seconds)
+{
+	m_HitchThreshold = uint64_t(std::max(seconds, 0.f) / m_SecondsPerCount);
+
+	//The hitches still in the window are counted again against the new threshold
+	m_AmountOfHitches = 0;
+	for (uint32_t i = 0; i < m_AmountOfFrameTimes; ++i)
+		m_AmountOfHitches += (m_FrameTimes[i] > m_HitchThreshold) ? 1 : 0;
+}
+
+std::vector<uint64_t> Elite::Timer::GetSortedFrameTimes() const
+{
+	//Before the window is full the frames are at its start, afterwards order does not matter
+	std::vector<uint64_t> frameTimes{ m_FrameTimes.begin(), m_FrameTimes.begin() + m_AmountOfFrameTimes };
+	std::sort(frameTimes.begin(), frameTimes.end());
+	return frameTimes;
+}
+
+float Elite::Timer::GetFrameTimePercentile(float fraction) const
+{
+	if (m_AmountOfFrameTimes == 0)
+		return 0.f;
+
+	return GetPercentile(GetSortedFrameTimes(), fraction, m_SecondsPerCount);
+}
+
+Elite::FrameTimeSummary Elite::Timer::GetFrameTimeSummary() const
+{
+	FrameTimeSummary summary{ 0.f, 0.f, 0.f, 0.f, m_AmountOfFrameTimes, m_AmountOfHitches };
+	if (m_AmountOfFrameTimes == 0)
+		return summary;
+
+	const std::vector<uint64_t> frameTimes = GetSortedFrameTimes();
+	summary.p50 = GetPercentile(frameTimes, 0.5f, m_SecondsPerCount);
+	summary.p95 = GetPercentile(frameTimes, 0.95f, m_SecondsPerCount);
+	summary.p99 = GetPercentile(frameTimes, 0.99f, m_SecondsPerCount);
+	summary.max = float(frameTimes.back() * m_SecondsPerCount);
+	return summary;
+}
+
+void Elite::Timer::PrintFrameTimeHistogram(std::ostream& stream) const
+{
+	const FrameTimeSummary summary = GetFrameTimeSummary();
+	stream << "Frame times: " << summary.amountOfFrames << " frame(s), p50 " << ToMilliseconds(summary.p50) << " ms, p95 " << ToMilliseconds(summary.p95)
+		<< " ms, p99 " << ToMilliseconds(summary.p99) << " ms, max " << ToMilliseconds(summary.max) << " ms, "
+		<< summary.amountOfHitches << " hitch(es) over " << ToMilliseconds(GetHitchThreshold()) << " ms\n";
+	if (summary.amountOfFrames == 0)
+		return;
+
+	uint32_t buckets[AmountOfHistogramBuckets]{};
+	for (uint32_t i = 0; i < m_AmountOfFrameTimes; ++i)
+	{
+		const float milliseconds = float(m_FrameTimes[i] * m_SecondsPerCount) * 1000.f;
+		uint32_t bucket = 0;
+		while (bucket < AmountOfHistogramBuckets - 1 && milliseconds >= float(HistogramEdges[bucket]))
+			++bucket;
+		++buckets[bucket];
+	}
+
+	//Only the buckets between the fastest & the slowest frame are printed
+	uint32_t first = 0;
+	uint32_t last = AmountOfHistogramBuckets - 1;
+	while (buckets[first] == 0)
+		++first;
+	while (buckets[last] == 0)
+		--last;
+	const uint32_t largest = *std::max_element(buckets, buckets + AmountOfHistogramBuckets);
+
+	for (uint32_t bucket = first; bucket <= last; ++bucket)
+	{
+		const std::string lower = (bucket == 0) ? "" : std::to_string(HistogramEdges[bucket - 1]);
+		const std::string upper = (bucket == AmountOfHistogramBuckets - 1) ? "" : std::to_string(HistogramEdges[bucket]);
+		stream << "Frame times: " << std::setw(5) << lower << " - " << std::setw(5) << upper << " ms " << std::setw(6) << buckets[bucket] << " "
+			<< std::string(size_t((uint64_t(buckets[bucket]) * HistogramBarLength + largest - 1) / largest), '#') << "\n";
+	}
+}
@@ -9,9 +9,22 @@
 
 //Standard includes
 #include <cstdint>
+#include <ostream>
+#include <vector>
 
 namespace Elite
 {
+	//Frame times of the recorded window in seconds, percentiles are the nearest recorded frame time
+	struct FrameTimeSummary
+	{
+		float p50;
+		float p95;
+		float p99;
+		float max;
+		uint32_t amountOfFrames;
+		uint32_t amountOfHitches;
+	};
+
 	class Timer
 	{
 	public:
@@ -23,9 +36,13 @@ namespace Elite
 		Timer& operator=(const Timer&) = delete;
 		Timer& operator=(Timer&&) noexcept = delete;
 
+		//Raw frame times of the last FrameTimeWindow recorded frames are kept, in performance counter ticks
+		static const uint32_t FrameTimeWindow = 1024;
+
 		void Reset();
 		void Start();
-		void Update();
+		//Frames that are not recorded still advance the time, but stay out of the frame times (e.g. idle frames that rendered nothing)
+		void Update(bool isFrameRecorded = true);
 		void Stop();
 
 		uint32_t GetFPS() const { return m_FPS; };
@@ -33,6 +50,22 @@ namespace Elite
 		float GetTotal() const { return m_TotalTime; };
 		bool IsRunning() const { return !m_IsStopped; };
 
+		//Frame time in seconds that the fraction (0 to 1) of the recorded frames took at most, 0 without recorded frames
+		//Sorts a copy of the window, so it is meant to be asked now & then, not every frame
+		float GetFrameTimePercentile(float fraction) const;
+		FrameTimeSummary GetFrameTimeSummary() const;
+
+		//Recorded frames that take longer than the threshold (in seconds) are hitches, the elapsed time upper bound does not hide them
+		void SetHitchThreshold(float seconds);
+		float GetHitchThreshold() const { return float(m_HitchThreshold * m_SecondsPerCount); };
+		bool IsHitch() const { return m_IsHitch; };
+		//Hitches in the recorded window & since the last reset
+		uint32_t GetAmountOfHitches() const { return m_AmountOfHitches; };
+		uint64_t GetTotalAmountOfHitches() const { return m_TotalAmountOfHitches; };
+
+		//Amount of recorded frames per frame time bucket, from below 1 ms to 1 s & more
+		void PrintFrameTimeHistogram(std::ostream& stream) const;
+
 	private:
 		uint64_t m_BaseTime;
 		uint64_t m_PausedTime;
@@ -51,6 +84,17 @@ namespace Elite
 
 		bool m_IsStopped;
 		bool m_ForceElapsedUpperBound;
+
+		//Ring buffer of frame times, the hitches in it are counted as frames come in & drop out
+		std::vector<uint64_t> m_FrameTimes;
+		uint32_t m_FrameTimeIndex;
+		uint32_t m_AmountOfFrameTimes;
+		uint64_t m_HitchThreshold;
+		uint32_t m_AmountOfHitches;
+		uint64_t m_TotalAmountOfHitches;
+		bool m_IsHitch;
+
+		std::vector<uint64_t> GetSortedFrameTimes() const;
 	};
 }
 
@@ -30,24 +30,20 @@ namespace Elite
 		//=== Constructors ===
 #pragma region Constructors
 		Vector<2, T>() = default;
-		Vector<2, T>(T _x, T _y)
+		constexpr Vector<2, T>(T _x, T _y)
 			: x(_x), y(_y) {}
-		Vector<2, T>(const Vector<2, T>& v)
-			: x(v.x), y(v.y) {}
-		Vector<2, T>(Vector<2, T>&& v) noexcept
-			: x(std::move(v.x)), y(std::move(v.y)) {}
-		explicit Vector<2, T>(const Point<2, T>& p)
+		constexpr explicit Vector<2, T>(const Point<2, T>& p)
 			: x(p.x), y(p.y) {}
-		explicit Vector<2, T>(const Vector<3, T>& v)
+		constexpr explicit Vector<2, T>(const Vector<3, T>& v)
 			: x(v.x), y(v.y) {}
-		explicit Vector<2, T>(const Vector<4, T>& v)
+		constexpr explicit Vector<2, T>(const Vector<4, T>& v)
 			: x(v.x), y(v.y) {}
 #pragma endregion
 
 		//=== Conversion Operator ===
 #pragma region ConversionOperator
 		template<typename U>
-		operator Vector<2, U>() const //Implicit conversion to different types of Vector2
+		constexpr operator Vector<2, U>() const //Implicit conversion to different types of Vector2
 		{
 			return Vector<2, U>(
 				static_cast<U>(this->x),
@@ -58,17 +54,17 @@ namespace Elite
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
 		template<typename U>
-		inline Vector<2, T> operator+(const Vector<2, U>& v) const
+		constexpr Vector<2, T> operator+(const Vector<2, U>& v) const
 		{ return Vector<2, T>(x + static_cast<T>(v.x), y + static_cast<T>(v.y)); }
 
 		template<typename U>
-		inline Vector<2, T> operator-(const Vector<2, U>& v) const
+		constexpr Vector<2, T> operator-(const Vector<2, U>& v) const
 		{ return Vector<2, T>(x - static_cast<T>(v.x), y - static_cast<T>(v.y)); }
 
-		inline Vector<2, T> operator*(T scale) const
+		constexpr Vector<2, T> operator*(T scale) const
 		{ return Vector<2, T>(x * scale, y * scale); }
 
-		inline Vector<2, T> operator/(T scale) const
+		constexpr Vector<2, T> operator/(T scale) const
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			return Vector<2, T>(x * revS, y * revS);
@@ -77,19 +73,16 @@ namespace Elite
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Vector<2, T>& operator=(const Vector<2, T>& v)
-		{ x = v.x; y = v.y; return *this; }
-
-		inline Vector<2, T>& operator+=(const Vector<2, T>& v)
+		constexpr Vector<2, T>& operator+=(const Vector<2, T>& v)
 		{ x += v.x; y += v.y; return *this; }
 
-		inline Vector<2, T>& operator-=(const Vector<2, T>& v)
+		constexpr Vector<2, T>& operator-=(const Vector<2, T>& v)
 		{ x -= v.x; y -= v.y; return *this; }
 
-		inline Vector<2, T>& operator*=(T scale)
+		constexpr Vector<2, T>& operator*=(T scale)
 		{ x *= scale; y *= scale; return *this; }
 
-		inline Vector<2, T>& operator/=(T scale)
+		constexpr Vector<2, T>& operator/=(T scale)
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			x *= revS; y *= revS; return *this;
@@ -98,7 +91,7 @@ namespace Elite
 
 		//=== Unary Operators ===
 #pragma region UnaryOperators
-		inline Vector<2, T> operator-() const
+		constexpr Vector<2, T> operator-() const
 		{ return Vector<2, T>(-x, -y); }
 #pragma endregion
 
@@ -127,13 +120,13 @@ namespace Elite
 #pragma endregion
 
 		//=== Static Functions ===
-		static Vector<2, T> ZeroVector();
+		static constexpr Vector<2, T> ZeroVector();
 	};
 
 	//--- VECTOR3 FUNCTIONS ---
 #pragma region GlobalOperators
 	template<typename T, typename U>
-	inline Vector<2, T> operator*(U scale, const Vector<2, T>& v)
+	constexpr Vector<2, T> operator*(U scale, const Vector<2, T>& v)
 	{ 
 		T s = static_cast<T>(scale);
 		return Vector<2, T>(v.x * s, v.y * s); 
@@ -142,23 +135,23 @@ namespace Elite
 
 #pragma region GlobalFunctions
 	template<typename T>
-	inline Vector<2, T> Vector<2, T>::ZeroVector()
+	constexpr Vector<2, T> Vector<2, T>::ZeroVector()
 	{
 		T z = static_cast<T>(0);
 		return Vector<2, T>(z, z);
 	}
 
 	template<typename T>
-	inline T Dot(const Vector<2, T>& v1, const Vector<2, T>& v2)
+	constexpr T Dot(const Vector<2, T>& v1, const Vector<2, T>& v2)
 	{ return v1.x * v2.x + v1.y * v2.y; }
 
 	template<typename T>
-	inline T Cross(const Vector<2, T>& v1, const Vector<2, T>& v2)
+	constexpr T Cross(const Vector<2, T>& v1, const Vector<2, T>& v2)
 	{ return v1.x * v2.y - v1.y * v2.x;	}
 
 	//Returns 2D vector rotated 90 degrees counter-clockwise (where y-axis is up)
 	template<typename T>
-	inline Vector<2, T> Perpendicular(const Vector<2, T>& v)
+	constexpr Vector<2, T> Perpendicular(const Vector<2, T>& v)
 	{ return Vector<2, T>(-v.y, v.x); }
 
 	template<typename T>
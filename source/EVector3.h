@@ -32,24 +32,20 @@ namespace Elite
 		//=== Constructors ===
 #pragma region Constructors
 		Vector<3, T>() = default;
-		Vector<3, T>(T _x, T _y, T _z = 0)
+		constexpr Vector<3, T>(T _x, T _y, T _z = 0)
 			: x(_x), y(_y), z(_z) {}
-		Vector<3, T>(const Vector<3, T>& v)
-			: x(v.x), y(v.y), z(v.z) {}
-		Vector<3, T>(const Vector<2, T>& v, T _z = 0)
+		constexpr Vector<3, T>(const Vector<2, T>& v, T _z = 0)
 			: x(v.x), y(v.y), z(_z) {}
-		Vector<3, T>(Vector<3, T>&& v) noexcept
-			:x(std::move(v.x)), y(std::move(v.y)), z(std::move(v.z)) {}
-		explicit Vector<3, T>(const Point<3, T>& p)
+		constexpr explicit Vector<3, T>(const Point<3, T>& p)
 			: x(p.x), y(p.y), z(p.z) {}
-		explicit Vector<3, T>(const Vector<4, T>& v)
+		constexpr explicit Vector<3, T>(const Vector<4, T>& v)
 			: x(v.x), y(v.y), z(v.z) {}
 #pragma endregion
 
 		//=== Conversion Operator ===
 #pragma region ConversionOperator
 		template<typename U>
-		operator Vector<3, U>() const //Implicit conversion to different types of Vector3
+		constexpr operator Vector<3, U>() const //Implicit conversion to different types of Vector3
 		{
 			return Vector<3, U>(
 				static_cast<U>(this->x),
@@ -61,17 +57,17 @@ namespace Elite
 		//=== Arithmetic Operators ===
 #pragma region ArithmeticOperators
 		template<typename U>
-		inline Vector<3, T> operator+(const Vector<3, U>& v) const
+		constexpr Vector<3, T> operator+(const Vector<3, U>& v) const
 		{ return Vector<3, T>(x + static_cast<T>(v.x), y + static_cast<T>(v.y), z + static_cast<T>(v.z)); }
 
 		template<typename U>
-		inline Vector<3, T> operator-(const Vector<3, U>& v) const
+		constexpr Vector<3, T> operator-(const Vector<3, U>& v) const
 		{ return Vector<3, T>(x - static_cast<T>(v.x), y - static_cast<T>(v.y), z - static_cast<T>(v.z)); }
 
-		inline Vector<3, T> operator*(T scale) const
+		constexpr Vector<3, T> operator*(T scale) const
 		{ return Vector<3, T>(x * scale, y * scale, z * scale);	}
 
-		inline Vector<3, T> operator/(T scale) const
+		constexpr Vector<3, T> operator/(T scale) const
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			return Vector<3, T>(x * revS, y * revS, z * revS);
@@ -80,19 +76,16 @@ namespace Elite
 
 		//=== Compound Assignment Operators ===
 #pragma region CompoundAssignmentOperators
-		inline Vector<3, T>& operator=(const Vector<3, T>& v)
-		{ x = v.x; y = v.y; z = v.z; return *this; }
-
-		inline Vector<3, T>& operator+=(const Vector<3, T>& v)
+		constexpr Vector<3, T>& operator+=(const Vector<3, T>& v)
 		{ x += v.x; y += v.y; z += v.z; return *this; }
 
-		inline Vector<3, T>& operator-=(const Vector<3, T>& v)
+		constexpr Vector<3, T>& operator-=(const Vector<3, T>& v)
 		{ x -= v.x; y -= v.y; z -= v.z; return *this; }
 
-		inline Vector<3, T>& operator*=(T scale)
+		constexpr Vector<3, T>& operator*=(T scale)
 		{ x *= scale; y *= scale; z *= scale; return *this; }
 
-		inline Vector<3, T>& operator/=(T scale)
+		constexpr Vector<3, T>& operator/=(T scale)
 		{
 			const T revS = static_cast<T>(1.0f / scale);
 			x *= revS; y *= revS; z *= revS; return *this;
@@ -101,7 +94,7 @@ namespace Elite
 
 		//=== Unary Operators ===
 #pragma region UnaryOperators
-		inline Vector<3, T> operator-() const
+		constexpr Vector<3, T> operator-() const
 		{ return Vector<3, T>(-x, -y, -z); }
 #pragma endregion
 
@@ -130,13 +123,13 @@ namespace Elite
 #pragma endregion
 
 		//=== Static Functions ===
-		static Vector<3, T> ZeroVector();
+		static constexpr Vector<3, T> ZeroVector();
 	};
 
 	//--- VECTOR3 FUNCTIONS ---
 #pragma region GlobalOperators
 	template<typename T, typename U>
-	inline Vector<3, T> operator*(U scale, const Vector<3, T>& v)
+	constexpr Vector<3, T> operator*(U scale, const Vector<3, T>& v)
 	{ 
 		T s = static_cast<T>(scale);
 		return Vector<3, T>(v.x * s, v.y * s, v.z * s); 
@@ -145,18 +138,18 @@ namespace Elite
 
 #pragma region GlobalFunctions
 	template<typename T>
-	inline Vector<3, T> Vector<3, T>::ZeroVector()
+	constexpr Vector<3, T> Vector<3, T>::ZeroVector()
 	{ 
 		T z = static_cast<T>(0);
 		return Vector<3, T>(z, z, z); 
 	}
 
 	template<typename T>
-	inline T Dot(const Vector<3, T>& v1, const Vector<3, T>& v2)
+	constexpr T Dot(const Vector<3, T>& v1, const Vector<3, T>& v2)
 	{ return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
 
 	template<typename T>
-	inline Vector<3, T> Cross(const Vector<3, T>& v1, const Vector<3, T>& v2)
+	constexpr Vector<3, T> Cross(const Vector<3, T>& v1, const Vector<3, T>& v2)
 	{
 		return Vector<3, T>{
 			v1.y * v2.z - v1.z * v2.y,
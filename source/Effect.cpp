@@ -1,4 +1,5 @@
 #include "pch.h"
+#ifdef ELITE_BACKEND_DX11
 #include "Effect.h"
 #include "ECamera.h"
 
@@ -148,4 +149,5 @@ void Effect::SetMatrices(const Elite::FMatrix4& worldViewProj, const Elite::FMat
 
 	if (m_pMatViewInverseVariable->IsValid())
 		m_pMatViewInverseVariable->SetMatrix(reinterpret_cast<float*>(&viewInverseMatrix));
-}
\ No newline at end of file
+}
+#endif
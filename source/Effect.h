@@ -1,4 +1,5 @@
 #pragma once
+#ifdef ELITE_BACKEND_DX11
 #include "EMath.h"
 #include <sstream>
 #include <vector>
@@ -30,4 +31,4 @@ private:
 	ID3DX11EffectShaderResourceVariable* m_pGlosinessMapVariable;
 	ID3DX11EffectShaderResourceVariable* m_pSpecularMapVariable;
 };
-
+#endif
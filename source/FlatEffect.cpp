@@ -1,4 +1,5 @@
 #include "pch.h"
+#ifdef ELITE_BACKEND_DX11
 #include "FlatEffect.h"
 
 FlatEffect::FlatEffect(ID3D11Device* pDevice, const std::wstring& assetFile)
@@ -68,3 +69,4 @@ void FlatEffect::SetMatrices(const Elite::FMatrix4& worldViewProj, const Elite::
 		m_pMatWorldViewProjVariable->SetMatrix(reinterpret_cast<float*>(&worldViewProjectionMatrixTmp));
 
 }
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#ifdef ELITE_BACKEND_DX11
 #include "BaseEffect.h"
 
 class FlatEffect final : public BaseEffect
@@ -21,4 +22,4 @@ public:
 
 private:
 };
-
+#endif
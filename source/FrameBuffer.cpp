@@ -0,0 +1,215 @@
+#include "pch.h"
+#include "FrameBuffer.h"
+
+Elite::FrameBuffer::FrameBuffer(const SDL_PixelFormat* pFormat, DepthFormat depthFormat)
+	: m_RedLane{}
+	, m_GreenLane{}
+	, m_BlueLane{}
+	, m_Width{}
+	, m_Height{}
+	, m_TilesX{}
+	, m_TilesY{}
+	, m_pColorBuffer{ nullptr }
+	, m_ClearColor{}
+	, m_DepthFormat{ depthFormat }
+	, m_pDepth{ nullptr }
+	, m_FrameEpoch{}
+	, m_pTileIsClear{ nullptr }
+{
+	SetFormat(pFormat);
+}
+
+void Elite::FrameBuffer::SetFormat(const SDL_PixelFormat* pFormat)
+{
+	m_RedLane = uint32_t(pFormat->Rshift / 8);
+	m_GreenLane = uint32_t(pFormat->Gshift / 8);
+	m_BlueLane = uint32_t(pFormat->Bshift / 8);
+
+	//Force the clear color to be repacked in the new channel order
+	m_ClearColor = 0;
+	for (std::vector<bool>& tileIsClear : m_TileIsClearPerBuffer)
+		std::fill(tileIsClear.begin(), tileIsClear.end(), false);
+}
+
+void Elite::FrameBuffer::SetDepthFormat(DepthFormat depthFormat)
+{
+	m_DepthFormat = depthFormat;
+	AllocateDepth();
+}
+
+void Elite::FrameBuffer::Resize(uint32_t width, uint32_t height, const std::vector<uint32_t*>& colorBuffers)
+{
+	m_Width = width;
+	m_Height = height;
+	m_TilesX = (width + TileSize - 1) / TileSize;
+	m_TilesY = (height + TileSize - 1) / TileSize;
+	m_ColorBuffers = colorBuffers;
+
+	AllocateDepth();
+
+	//Contents of the new color memory are unknown, every tile has to be cleared once
+	m_TileIsClearPerBuffer.assign(m_ColorBuffers.size(), std::vector<bool>(m_TilesX * m_TilesY, false));
+	SetColorBuffer(m_ColorBuffers.front());
+}
+
+void Elite::FrameBuffer::AllocateDepth()
+{
+	const size_t depthSize = size_t(m_TilesX) * m_TilesY * TileSize * TileSize * GetDepthTexelSize();
+	m_DepthStorage.assign(depthSize + CacheLineSize, 0);
+	m_pDepth = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(m_DepthStorage.data()) + (CacheLineSize - 1)) & ~uintptr_t(CacheLineSize - 1));
+
+	//Depth of every tile is stale now
+	m_FrameEpoch = 0;
+	m_TileEpochs.assign(m_TilesX * m_TilesY, 0);
+}
+
+int32_t Elite::FrameBuffer::EncodeDepth(float depth) const
+{
+	depth = Clamp(depth, 0.f, 1.f);
+
+	int32_t bits{};
+	switch (m_DepthFormat)
+	{
+	case DepthFormat::float32:
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return bits;
+	case DepthFormat::reversedFloat32:
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return ~bits;
+	case DepthFormat::unorm24:
+		return int32_t(depth * 16777215.f + 0.5f);
+	case DepthFormat::unorm16:
+		return int32_t(depth * 65535.f + 0.5f) - 32768;
+	}
+	return bits;
+}
+
+int32_t Elite::FrameBuffer::GetDepthClearKey() const
+{
+	//Far plane, reversed formats store the far plane as 0
+	switch (m_DepthFormat)
+	{
+	case DepthFormat::float32:
+		return EncodeDepth(1.f) + 1;
+	case DepthFormat::reversedFloat32:
+		return EncodeDepth(0.f);
+	case DepthFormat::unorm24:
+		return 16777215;
+	case DepthFormat::unorm16:
+		return 32767;
+	}
+	return 0;
+}
+
+void Elite::FrameBuffer::SetColorBuffer(uint32_t* pColorBuffer)
+{
+	const auto it = std::find(m_ColorBuffers.begin(), m_ColorBuffers.end(), pColorBuffer);
+	assert((it != m_ColorBuffers.end()) && "ERROR: color buffer was not passed to FrameBuffer::Resize!");
+
+	m_pColorBuffer = pColorBuffer;
+	m_pTileIsClear = &m_TileIsClearPerBuffer[it - m_ColorBuffers.begin()];
+}
+
+void Elite::FrameBuffer::Clear(const RGBColor& clearColor)
+{
+	const uint32_t packedColor = PackColor(clearColor);
+	if (packedColor != m_ClearColor)
+	{
+		m_ClearColor = packedColor;
+		for (std::vector<bool>& tileIsClear : m_TileIsClearPerBuffer)
+			std::fill(tileIsClear.begin(), tileIsClear.end(), false);
+	}
+
+	//Epoch 0 is reserved for "never touched"
+	++m_FrameEpoch;
+	if (m_FrameEpoch == 0)
+	{
+		std::fill(m_TileEpochs.begin(), m_TileEpochs.end(), 0);
+		m_FrameEpoch = 1;
+	}
+}
+
+void Elite::FrameBuffer::Resolve()
+{
+	for (uint32_t tileY = 0; tileY < m_TilesY; ++tileY)
+	{
+		for (uint32_t tileX = 0; tileX < m_TilesX; ++tileX)
+		{
+			const uint32_t tileIndex = tileX + (tileY * m_TilesX);
+			if (m_TileEpochs[tileIndex] != m_FrameEpoch && !(*m_pTileIsClear)[tileIndex])
+			{
+				FillTileColor(tileX, tileY, m_ClearColor);
+				(*m_pTileIsClear)[tileIndex] = true;
+			}
+		}
+	}
+}
+
+bool Elite::FrameBuffer::IsOccluded(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY, float depth) const
+{
+	if (minX >= maxX || minY >= maxY)
+		return true;
+
+	for (uint32_t tileY = minY / TileSize; tileY <= (maxY - 1) / TileSize; ++tileY)
+	{
+		for (uint32_t tileX = minX / TileSize; tileX <= (maxX - 1) / TileSize; ++tileX)
+		{
+			if (m_TileEpochs[tileX + (tileY * m_TilesX)] != m_FrameEpoch)
+				return false;
+		}
+	}
+
+	//Keys are monotonic in depth for every format, so one key compare per pixel is enough
+	const int32_t key = EncodeDepth(depth);
+	for (uint32_t y = minY; y < maxY; ++y)
+	{
+		for (uint32_t x = minX; x < maxX; ++x)
+		{
+			const uint8_t* pDepth = GetDepthQuad(x, y);
+			const int32_t stored = (m_DepthFormat == DepthFormat::unorm16) ? *reinterpret_cast<const int16_t*>(pDepth) : *reinterpret_cast<const int32_t*>(pDepth);
+			if (stored >= key)
+				return false;
+		}
+	}
+	return true;
+}
+
+void Elite::FrameBuffer::InitializeTile(uint32_t tileIndex)
+{
+	m_TileEpochs[tileIndex] = m_FrameEpoch;
+
+	const uint32_t tileX = tileIndex % m_TilesX;
+	const uint32_t tileY = tileIndex / m_TilesX;
+
+	//Depth is only cleared for tiles that are actually rendered to, the whole block is contiguous
+	uint8_t* pDepth = GetDepthQuad(tileX * TileSize, tileY * TileSize);
+	if (m_DepthFormat == DepthFormat::unorm16)
+	{
+		int16_t* pKeys = reinterpret_cast<int16_t*>(pDepth);
+		std::fill(pKeys, pKeys + (TileSize * TileSize), int16_t(GetDepthClearKey()));
+	}
+	else
+	{
+		int32_t* pKeys = reinterpret_cast<int32_t*>(pDepth);
+		std::fill(pKeys, pKeys + (TileSize * TileSize), GetDepthClearKey());
+	}
+
+	if (!(*m_pTileIsClear)[tileIndex])
+		FillTileColor(tileX, tileY, m_ClearColor);
+
+	//The rasterizer is about to draw into this tile
+	(*m_pTileIsClear)[tileIndex] = false;
+}
+
+void Elite::FrameBuffer::FillTileColor(uint32_t tileX, uint32_t tileY, uint32_t color)
+{
+	const uint32_t startX = tileX * TileSize;
+	const uint32_t endX = std::min(startX + TileSize, m_Width);
+	const uint32_t endY = std::min((tileY + 1) * TileSize, m_Height);
+
+	for (uint32_t r = tileY * TileSize; r < endY; ++r)
+	{
+		uint32_t* pColor = m_pColorBuffer + (r * m_Width);
+		std::fill(pColor + startX, pColor + endX, color);
+	}
+}
@@ -0,0 +1,196 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <cstring>
+#include "EMathUtilities.h"
+#include "ERGBColor.h"
+#include "EHelper.h"
+
+struct SDL_PixelFormat;
+
+namespace Elite
+{
+	//Color & depth target of the software rasterizer, cleared lazily per tile
+	class FrameBuffer final
+	{
+	public:
+		static const uint32_t TileSize = 16;
+		static const uint32_t CacheLineSize = 64;
+
+		FrameBuffer(const SDL_PixelFormat* pFormat, DepthFormat depthFormat = DepthFormat::float32);
+		~FrameBuffer() = default;
+
+		FrameBuffer(const FrameBuffer&) = delete;
+		FrameBuffer(FrameBuffer&&) noexcept = delete;
+		FrameBuffer& operator=(const FrameBuffer&) = delete;
+		FrameBuffer& operator=(FrameBuffer&&) noexcept = delete;
+
+		//The color memory is owned by the caller (back buffers or intermediate buffer), depth is owned here
+		void Resize(uint32_t width, uint32_t height, const std::vector<uint32_t*>& colorBuffers);
+
+		//Channel order of the packed colors, has to match the color buffers
+		void SetFormat(const SDL_PixelFormat* pFormat);
+
+		//Reallocates the depth tiles, reversed formats expect 1 at the near plane and 0 at the far plane
+		void SetDepthFormat(DepthFormat depthFormat);
+		DepthFormat GetDepthFormat() const { return m_DepthFormat; };
+		bool IsDepthReversed() const { return m_DepthFormat == DepthFormat::reversedFloat32; };
+
+		//Selects which of the color buffers passed to Resize is rendered to, each keeps its own clear state
+		void SetColorBuffer(uint32_t* pColorBuffer);
+
+		//Starts a new frame, nothing is written until a tile is touched or the frame is resolved
+		void Clear(const RGBColor& clearColor);
+
+		//Has to be called before the rasterizer reads or writes a tile
+		inline void TouchTile(uint32_t tileX, uint32_t tileY)
+		{
+			const uint32_t tileIndex = tileX + (tileY * m_TilesX);
+			if (m_TileEpochs[tileIndex] != m_FrameEpoch)
+				InitializeTile(tileIndex);
+		}
+
+		//Clears the tiles that still hold last frame's pixels but were not touched this frame
+		void Resolve();
+
+		//Depth tests 4 pixels of a row in a touched tile, x has to be a multiple of 4
+		//Only pixels with their bit set in coverage are tested, returns the bits of the pixels that passed and got their depth written
+		//Transparent pixels are tested without writing their depth
+		inline uint32_t DepthTestQuad(uint32_t x, uint32_t y, const float depths[4], uint32_t coverage, bool isDepthWritten = true)
+		{
+			uint8_t* pDepth = GetDepthQuad(x, y);
+
+			//Depth is stored as signed keys where the smaller key is closer, for every format
+#ifdef ELITE_SSE2
+			const __m128 depth = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(depths), _mm_setzero_ps()), _mm_set1_ps(1.f));
+			const __m128i laneBits = _mm_set_epi32(8, 4, 2, 1);
+			const __m128i coverageMask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(int(coverage)), laneBits), laneBits);
+
+			if (m_DepthFormat == DepthFormat::unorm16)
+			{
+				//Biased by 32768 so the keys fit & compare as signed 16 bit values
+				__m128i keys = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(depth, _mm_set1_ps(65535.f))), _mm_set1_epi32(32768));
+				keys = _mm_packs_epi32(keys, keys);
+				const __m128i stored = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pDepth));
+				const __m128i passed = _mm_and_si128(_mm_cmplt_epi16(keys, stored), _mm_packs_epi32(coverageMask, coverageMask));
+				if (isDepthWritten)
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(pDepth), _mm_or_si128(_mm_and_si128(passed, keys), _mm_andnot_si128(passed, stored)));
+				return uint32_t(_mm_movemask_ps(_mm_castsi128_ps(_mm_unpacklo_epi16(passed, passed))));
+			}
+
+			__m128i keys{};
+			if (m_DepthFormat == DepthFormat::float32)
+				keys = _mm_castps_si128(depth);
+			else if (m_DepthFormat == DepthFormat::reversedFloat32)
+				keys = _mm_xor_si128(_mm_castps_si128(depth), _mm_set1_epi32(-1));
+			else
+				keys = _mm_cvtps_epi32(_mm_mul_ps(depth, _mm_set1_ps(16777215.f)));
+
+			const __m128i stored = _mm_load_si128(reinterpret_cast<const __m128i*>(pDepth));
+			const __m128i passed = _mm_and_si128(_mm_cmplt_epi32(keys, stored), coverageMask);
+			if (isDepthWritten)
+				_mm_store_si128(reinterpret_cast<__m128i*>(pDepth), _mm_or_si128(_mm_and_si128(passed, keys), _mm_andnot_si128(passed, stored)));
+			return uint32_t(_mm_movemask_ps(_mm_castsi128_ps(passed)));
+#else
+			uint32_t passed = 0;
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				if (!(coverage & (1 << i)))
+					continue;
+
+				const int32_t key = EncodeDepth(depths[i]);
+				if (m_DepthFormat == DepthFormat::unorm16)
+				{
+					int16_t* pKey = reinterpret_cast<int16_t*>(pDepth) + i;
+					if (key < *pKey)
+					{
+						if (isDepthWritten)
+							*pKey = int16_t(key);
+						passed |= 1 << i;
+					}
+				}
+				else
+				{
+					int32_t* pKey = reinterpret_cast<int32_t*>(pDepth) + i;
+					if (key < *pKey)
+					{
+						if (isDepthWritten)
+							*pKey = key;
+						passed |= 1 << i;
+					}
+				}
+			}
+			return passed;
+#endif
+		}
+
+		//True when every pixel of the rectangle [minX, maxX) x [minY, maxY) already holds something closer than depth
+		//Tiles that were not touched this frame count as empty, so they never occlude
+		bool IsOccluded(uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY, float depth) const;
+
+		inline uint32_t PackColor(const RGBColor& color) const
+		{
+			//Same as RGBColor::MaxToOne
+			const float maxValue = std::max(color.r, std::max(color.g, color.b));
+			const float scale = (maxValue > 1.f) ? 255.f / maxValue : 255.f;
+			return (uint32_t(uint8_t(color.r * scale)) << (m_RedLane * 8))
+				| (uint32_t(uint8_t(color.g * scale)) << (m_GreenLane * 8))
+				| (uint32_t(uint8_t(color.b * scale)) << (m_BlueLane * 8));
+		}
+
+		inline RGBColor UnpackColor(uint32_t packedColor) const
+		{
+			return RGBColor{ float((packedColor >> (m_RedLane * 8)) & 0xFF) / 255.f, float((packedColor >> (m_GreenLane * 8)) & 0xFF) / 255.f,
+				float((packedColor >> (m_BlueLane * 8)) & 0xFF) / 255.f };
+		}
+
+		uint32_t* GetColorBuffer() const { return m_pColorBuffer; };
+
+		uint32_t GetWidth() const { return m_Width; };
+		uint32_t GetHeight() const { return m_Height; };
+		uint32_t GetTilesX() const { return m_TilesX; };
+		uint32_t GetTilesY() const { return m_TilesY; };
+
+	private:
+		void InitializeTile(uint32_t tileIndex);
+		void FillTileColor(uint32_t tileX, uint32_t tileY, uint32_t color);
+		void AllocateDepth();
+
+		int32_t EncodeDepth(float depth) const;
+		int32_t GetDepthClearKey() const;
+		uint32_t GetDepthTexelSize() const { return (m_DepthFormat == DepthFormat::unorm16) ? 2 : 4; };
+
+		//Every tile stores its depth in its own block of TileSize * TileSize texels, rows of a tile are contiguous
+		inline uint8_t* GetDepthQuad(uint32_t x, uint32_t y) const
+		{
+			const uint32_t tileIndex = (x / TileSize) + ((y / TileSize) * m_TilesX);
+			const uint32_t texelIndex = (x % TileSize) + ((y % TileSize) * TileSize);
+			return m_pDepth + (((tileIndex * TileSize * TileSize) + texelIndex) * GetDepthTexelSize());
+		}
+
+		uint32_t m_RedLane;
+		uint32_t m_GreenLane;
+		uint32_t m_BlueLane;
+
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_TilesX;
+		uint32_t m_TilesY;
+
+		uint32_t* m_pColorBuffer;
+		std::vector<uint32_t*> m_ColorBuffers;
+		uint32_t m_ClearColor;
+
+		//Tile blocks are 1 or 2 KB, so aligning the start aligns every tile to a cache line
+		DepthFormat m_DepthFormat;
+		std::vector<uint8_t> m_DepthStorage;
+		uint8_t* m_pDepth;
+
+		//A tile whose epoch differs from the frame epoch has not been touched this frame, its depth is stale
+		uint32_t m_FrameEpoch;
+		std::vector<uint32_t> m_TileEpochs;
+		//Tiles whose color still equals the clear color do not have to be cleared again, tracked per color buffer
+		std::vector<std::vector<bool>> m_TileIsClearPerBuffer;
+		std::vector<bool>* m_pTileIsClear;
+	};
+}
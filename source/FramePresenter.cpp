@@ -0,0 +1,151 @@
+#include "pch.h"
+#include "FramePresenter.h"
+#include "Profiler.h"
+
+Elite::FramePresenter::FramePresenter(SDL_Window* pWindow, uint32_t width, uint32_t height, PresentMode presentMode, uint32_t frameLatency)
+	: m_pWindow{ pWindow }
+	, m_pFrontBuffer{ pWindow ? SDL_GetWindowSurface(pWindow) : nullptr }
+	, m_Width{ width }
+	, m_Height{ height }
+	, m_RequestedFrameLatency{ frameLatency }
+	, m_FrameLatency{ 0 }
+	, m_PresentMode{ presentMode }
+	, m_pLastFrame{ nullptr }
+{
+	ValidatePresentMode();
+	CreateBackBuffers();
+}
+
+Elite::FramePresenter::~FramePresenter()
+{
+	DestroyBackBuffers();
+}
+
+SDL_Surface* Elite::FramePresenter::AcquireBackBuffer()
+{
+	while (m_FreeBuffers.empty() && !m_QueuedBuffers.empty())
+		PresentOldest();
+
+	SDL_Surface* pBackBuffer = m_FreeBuffers.front();
+	m_FreeBuffers.pop_front();
+	return pBackBuffer;
+}
+
+void Elite::FramePresenter::Present(SDL_Surface* pBackBuffer)
+{
+	Queue(pBackBuffer);
+	PresentQueued();
+}
+
+void Elite::FramePresenter::Queue(SDL_Surface* pBackBuffer)
+{
+	m_QueuedBuffers.push_back(pBackBuffer);
+}
+
+void Elite::FramePresenter::PresentQueued()
+{
+	//Without latency the frame is presented right away
+	while (m_QueuedBuffers.size() > m_FrameLatency)
+		PresentOldest();
+}
+
+void Elite::FramePresenter::Flush()
+{
+	while (!m_QueuedBuffers.empty())
+		PresentOldest();
+}
+
+void Elite::FramePresenter::SetFrameLatency(uint32_t frameLatency)
+{
+	DestroyBackBuffers();
+	m_RequestedFrameLatency = frameLatency;
+	CreateBackBuffers();
+}
+
+void Elite::FramePresenter::SetPresentMode(PresentMode presentMode)
+{
+	DestroyBackBuffers();
+	m_PresentMode = presentMode;
+	ValidatePresentMode();
+	CreateBackBuffers();
+}
+
+void Elite::FramePresenter::CreateBackBuffers()
+{
+	m_pLastFrame = nullptr;
+
+	//The window surface is rendered to directly, so it can not wait while the next frame is drawn into it
+	//Offscreen frames are only read back, there is nothing to wait for
+	m_FrameLatency = (m_PresentMode == PresentMode::blit) ? m_RequestedFrameLatency : 0;
+	if (m_PresentMode == PresentMode::windowSurface)
+	{
+		m_BackBuffers.push_back(m_pFrontBuffer);
+		m_FreeBuffers.push_back(m_pFrontBuffer);
+		return;
+	}
+
+	//One buffer to render into, one for every frame that may be waiting & one for the frame that is being presented meanwhile
+	const uint32_t amountOfBuffers = (m_PresentMode == PresentMode::blit) ? m_FrameLatency + 2 : 1;
+	for (uint32_t i = 0; i < amountOfBuffers; ++i)
+	{
+		SDL_Surface* pBackBuffer = SDL_CreateRGBSurface(0, m_Width, m_Height, 32, 0, 0, 0, 0);
+		m_BackBuffers.push_back(pBackBuffer);
+		m_FreeBuffers.push_back(pBackBuffer);
+	}
+}
+
+void Elite::FramePresenter::DestroyBackBuffers()
+{
+	Flush();
+
+	//The window surface is owned by the window
+	if (m_PresentMode != PresentMode::windowSurface)
+	{
+		for (SDL_Surface* pBackBuffer : m_BackBuffers)
+			SDL_FreeSurface(pBackBuffer);
+	}
+
+	m_BackBuffers.clear();
+	m_FreeBuffers.clear();
+	m_QueuedBuffers.clear();
+}
+
+void Elite::FramePresenter::PresentOldest()
+{
+	SDL_Surface* pBackBuffer = m_QueuedBuffers.front();
+	m_QueuedBuffers.pop_front();
+
+	if (m_PresentMode == PresentMode::windowSurface)
+		SDL_UpdateWindowSurface(m_pWindow);
+	else if (m_PresentMode == PresentMode::blit)
+		Blit(pBackBuffer);
+
+	m_pLastFrame = pBackBuffer;
+	m_FreeBuffers.push_back(pBackBuffer);
+}
+
+void Elite::FramePresenter::Blit(SDL_Surface* pBackBuffer)
+{
+	ELITE_PROFILE_SCOPE("Blit");
+	SDL_BlitSurface(pBackBuffer, 0, m_pFrontBuffer, 0);
+	SDL_UpdateWindowSurface(m_pWindow);
+}
+
+void Elite::FramePresenter::ValidatePresentMode()
+{
+	//Without a window there is nothing to present to
+	if (!m_pWindow)
+		m_PresentMode = PresentMode::offscreen;
+	else if (m_PresentMode == PresentMode::windowSurface && !CanRenderToWindowSurface())
+		m_PresentMode = PresentMode::blit;
+}
+
+bool Elite::FramePresenter::CanRenderToWindowSurface() const
+{
+	//The rasterizer writes tightly packed 32 bit pixels
+	return m_pFrontBuffer
+		&& m_pFrontBuffer->format->BytesPerPixel == 4
+		&& uint32_t(m_pFrontBuffer->pitch) == m_Width * 4
+		&& uint32_t(m_pFrontBuffer->w) == m_Width
+		&& uint32_t(m_pFrontBuffer->h) == m_Height;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include "EHelper.h"
+
+struct SDL_Window;
+struct SDL_Surface;
+
+namespace Elite
+{
+	//Owns the software back buffers and presents them to the window, up to frame latency finished frames wait in a queue
+	//SDL only allows the window surface to be touched on the thread that owns the window, so every present runs on the calling thread
+	//Blitting keeps one more back buffer, so the next frame can be rendered on another thread while the previous one is presented
+	//In window surface mode the window surface itself is the back buffer, in offscreen mode nothing is presented
+	class FramePresenter final
+	{
+	public:
+		FramePresenter(SDL_Window* pWindow, uint32_t width, uint32_t height, PresentMode presentMode = PresentMode::blit, uint32_t frameLatency = 0);
+		~FramePresenter();
+
+		FramePresenter(const FramePresenter&) = delete;
+		FramePresenter(FramePresenter&&) noexcept = delete;
+		FramePresenter& operator=(const FramePresenter&) = delete;
+		FramePresenter& operator=(FramePresenter&&) noexcept = delete;
+
+		//Presents the oldest queued frame when no back buffer is free, at most frameLatency frames are waiting to be presented
+		SDL_Surface* AcquireBackBuffer();
+		//Queues the finished frame, the oldest one is presented once more than frameLatency are waiting
+		void Present(SDL_Surface* pBackBuffer);
+		//Same as Present, split so the frames can be presented while the next one is being rendered
+		void Queue(SDL_Surface* pBackBuffer);
+		void PresentQueued();
+
+		//Presents every queued frame, called when no new frame follows
+		void Flush();
+
+		//Recreates the back buffers, so pointers to their pixels are no longer valid afterwards
+		//The requested latency is kept over present mode changes, modes that can not queue frames use 0 meanwhile
+		void SetFrameLatency(uint32_t frameLatency);
+		uint32_t GetFrameLatency() const { return m_FrameLatency; };
+		uint32_t GetRequestedFrameLatency() const { return m_RequestedFrameLatency; };
+
+		//Falls back to blitting when the window surface can not be rendered to directly
+		void SetPresentMode(PresentMode presentMode);
+		PresentMode GetPresentMode() const { return m_PresentMode; };
+
+		//Last finished frame, no copy is made
+		const SDL_Surface* GetLastFrame() const { return m_pLastFrame; };
+
+		const std::vector<SDL_Surface*>& GetBackBuffers() const { return m_BackBuffers; };
+
+	private:
+		void CreateBackBuffers();
+		void DestroyBackBuffers();
+		void PresentOldest();
+		void Blit(SDL_Surface* pBackBuffer);
+		void ValidatePresentMode();
+		bool CanRenderToWindowSurface() const;
+
+		SDL_Window* m_pWindow;
+		SDL_Surface* m_pFrontBuffer;
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_RequestedFrameLatency;
+		uint32_t m_FrameLatency;
+		PresentMode m_PresentMode;
+
+		std::vector<SDL_Surface*> m_BackBuffers;
+		SDL_Surface* m_pLastFrame;
+		std::deque<SDL_Surface*> m_FreeBuffers;
+		std::deque<SDL_Surface*> m_QueuedBuffers;
+	};
+}
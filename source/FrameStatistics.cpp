@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "FrameStatistics.h"
+
+namespace
+{
+	const uint32_t HeatmapMaxLayers = 8;
+
+	//Black for nothing, dark to bright blue up to 1, then through cyan, green & yellow to red at the maximum
+	Elite::RGBColor GetHeatmapColor(float value)
+	{
+		if (value <= 1.f)
+			return Elite::RGBColor{ 0.f, 0.f, 0.25f + 0.75f * value } * float(value > 0.f);
+
+		const Elite::RGBColor ramp[5]{ { 0.f, 0.f, 1.f }, { 0.f, 1.f, 1.f }, { 0.f, 1.f, 0.f }, { 1.f, 1.f, 0.f }, { 1.f, 0.f, 0.f } };
+		const float position = Elite::Clamp((value - 1.f) / float(HeatmapMaxLayers - 1), 0.f, 1.f) * 4.f;
+		const uint32_t index = std::min(uint32_t(position), 3u);
+		const float t = position - float(index);
+		return ramp[index] * (1.f - t) + ramp[index + 1] * t;
+	}
+}
+
+Elite::FrameStatistics& Elite::FrameStatistics::operator+=(const FrameStatistics& other)
+{
+	instances += other.instances;
+	meshletsTested += other.meshletsTested;
+	meshletsCulled += other.meshletsCulled;
+	trianglesTested += other.trianglesTested;
+	trianglesFrustumCulled += other.trianglesFrustumCulled;
+	trianglesBackFaceCulled += other.trianglesBackFaceCulled;
+	trianglesRasterized += other.trianglesRasterized;
+	fragmentsTested += other.fragmentsTested;
+	fragmentsPassed += other.fragmentsPassed;
+	shadingInvocations += other.shadingInvocations;
+	fragmentsOverwritten += other.fragmentsOverwritten;
+	pixelsCovered += other.pixelsCovered;
+	pixels += other.pixels;
+	return *this;
+}
+
+float Elite::FrameStatistics::GetAverageOverdraw() const
+{
+	return (pixelsCovered > 0) ? float(double(fragmentsPassed) / double(pixelsCovered)) : 0.f;
+}
+
+void Elite::CountPixelStatistics(const PixelStatistics& pixelStatistics, FrameStatistics& statistics)
+{
+	//Only the last opaque layer of a pixel is seen, every one before it was overwritten
+	uint64_t pixelsCovered = 0;
+	uint64_t fragmentsOverwritten = 0;
+	for (uint32_t layers : pixelStatistics.layers)
+	{
+		const uint32_t opaqueLayers = layers & 0xFFFF;
+		pixelsCovered += (layers != 0);
+		fragmentsOverwritten += (opaqueLayers > 1) ? opaqueLayers - 1 : 0;
+	}
+	statistics.pixelsCovered = pixelsCovered;
+	statistics.fragmentsOverwritten = fragmentsOverwritten;
+}
+
+void Elite::WriteHeatmap(DebugView view, const PixelStatistics& pixelStatistics, const FrameBuffer& frameBuffer)
+{
+	const size_t amountOfPixels = size_t(frameBuffer.GetWidth()) * frameBuffer.GetHeight();
+	if (view == DebugView::none || pixelStatistics.layers.size() < amountOfPixels)
+		return;
+
+	//Both views are whole sixteenths of a layer, so every color is packed once up front
+	const uint32_t amountOfSteps = HeatmapMaxLayers * PixelStatistics::ShadingCostUnit + 1;
+	uint32_t palette[amountOfSteps];
+	for (uint32_t i = 0; i < amountOfSteps; ++i)
+		palette[i] = frameBuffer.PackColor(GetHeatmapColor(float(i) / float(PixelStatistics::ShadingCostUnit)));
+
+	uint32_t* pPixels = frameBuffer.GetColorBuffer();
+	for (size_t i = 0; i < amountOfPixels; ++i)
+	{
+		const uint32_t layers = pixelStatistics.layers[i];
+		const uint32_t step = (view == DebugView::overdraw)
+			? ((layers & 0xFFFF) + (layers >> 16)) * PixelStatistics::ShadingCostUnit
+			: pixelStatistics.shadingCost[i];
+		pPixels[i] = palette[std::min(step, amountOfSteps - 1)];
+	}
+}
+
+void Elite::WriteFrameStatisticsHeader(std::ostream& stream)
+{
+	stream << "frame,instances,meshlets_tested,meshlets_culled,"
+		<< "triangles_tested,triangles_frustum_culled,triangles_backface_culled,triangles_rasterized,"
+		<< "fragments_tested,fragments_passed,fragments_overwritten,shading_invocations,"
+		<< "pixels,pixels_covered,average_overdraw\n";
+}
+
+void Elite::WriteFrameStatistics(std::ostream& stream, uint32_t frame, const FrameStatistics& statistics)
+{
+	stream << frame << ',' << statistics.instances << ',' << statistics.meshletsTested << ',' << statistics.meshletsCulled << ','
+		<< statistics.trianglesTested << ',' << statistics.trianglesFrustumCulled << ',' << statistics.trianglesBackFaceCulled << ',' << statistics.trianglesRasterized << ','
+		<< statistics.fragmentsTested << ',' << statistics.fragmentsPassed << ',' << statistics.fragmentsOverwritten << ',' << statistics.shadingInvocations << ','
+		<< statistics.pixels << ',' << statistics.pixelsCovered << ',' << statistics.GetAverageOverdraw() << '\n';
+}
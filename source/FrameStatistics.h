@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "EHelper.h"
+#include "FrameBuffer.h"
+
+namespace Elite
+{
+	//What the software rasterizer did in one frame, every thread counts into its own & they are added when the frame is done
+	struct FrameStatistics
+	{
+		uint64_t instances;
+		uint64_t meshletsTested;
+		uint64_t meshletsCulled;
+
+		//Triangles of the visible meshlets, the ones that are in none of the three counts covered no pixel center
+		uint64_t trianglesTested;
+		uint64_t trianglesFrustumCulled;
+		uint64_t trianglesBackFaceCulled;
+		uint64_t trianglesRasterized;
+
+		//Covered pixels that reached the depth test & the ones that passed it, transparent fragments included
+		uint64_t fragmentsTested;
+		uint64_t fragmentsPassed;
+		uint64_t shadingInvocations;
+
+		//Only counted with pixel statistics, overwritten fragments passed the depth test but were covered by a closer opaque one later
+		uint64_t fragmentsOverwritten;
+		uint64_t pixelsCovered;
+		uint64_t pixels;
+
+		FrameStatistics& operator+=(const FrameStatistics& other);
+
+		//Passed fragments per covered pixel, 0 without pixel statistics
+		float GetAverageOverdraw() const;
+	};
+
+	//Per pixel counts of one frame, only kept while they are asked for since every passed fragment writes them
+	struct PixelStatistics
+	{
+		//Passed opaque fragments in the lower 16 bits, passed transparent ones in the upper 16 bits
+		std::vector<uint32_t> layers;
+		//Pixel shader invocations in sixteenths, a 4x4 shading block adds 1 to each of its pixels
+		std::vector<uint16_t> shadingCost;
+
+		static const uint16_t ShadingCostUnit = 16;
+	};
+
+	//Fills in the counts that need every pixel, once the frame is done
+	void CountPixelStatistics(const PixelStatistics& pixelStatistics, FrameStatistics& statistics);
+
+	//Overwrites the color buffer of the frame buffer with a heatmap of overdraw or shading cost
+	//Blue is one layer or shade per pixel, red is 8 or more
+	void WriteHeatmap(DebugView view, const PixelStatistics& pixelStatistics, const FrameBuffer& frameBuffer);
+
+	//One comma separated row per frame, the header names the columns in the same order
+	void WriteFrameStatisticsHeader(std::ostream& stream);
+	void WriteFrameStatistics(std::ostream& stream, uint32_t frame, const FrameStatistics& statistics);
+}
+
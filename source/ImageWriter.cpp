@@ -0,0 +1,74 @@
+#include "pch.h"
+#include "ImageWriter.h"
+#include <fstream>
+#include <vector>
+#include <SDL_image.h>
+
+namespace
+{
+	std::string GetExtension(const std::string& filePath)
+	{
+		const size_t dotPosition = filePath.find_last_of('.');
+		if (dotPosition == std::string::npos)
+			return "";
+
+		std::string extension = filePath.substr(dotPosition);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return char(tolower(c)); });
+		return extension;
+	}
+
+	bool WritePPM(const std::string& filePath, SDL_Surface* pSurface)
+	{
+		std::ofstream file{ filePath, std::ios::binary };
+		if (!file)
+			return false;
+
+		file << "P6\n" << pSurface->w << " " << pSurface->h << "\n255\n";
+
+		//Rows are converted one at a time, the surface can be in any 32 bit channel order
+		std::vector<uint8_t> row(size_t(pSurface->w) * 3);
+		for (int r = 0; r < pSurface->h; ++r)
+		{
+			const uint32_t* pPixels = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pSurface->pixels) + (r * pSurface->pitch));
+			for (int c = 0; c < pSurface->w; ++c)
+				SDL_GetRGB(pPixels[c], pSurface->format, &row[c * 3], &row[c * 3 + 1], &row[c * 3 + 2]);
+
+			file.write(reinterpret_cast<const char*>(row.data()), row.size());
+		}
+
+		return bool(file);
+	}
+}
+
+bool Elite::WriteImage(const std::string& filePath, SDL_Surface* pSurface)
+{
+	if (!pSurface)
+		return false;
+
+	const std::string extension = GetExtension(filePath);
+	bool isWritten = false;
+
+	SDL_LockSurface(pSurface);
+	if (extension == ".png")
+		isWritten = IMG_SavePNG(pSurface, filePath.c_str()) == 0;
+	else if (extension == ".bmp")
+		isWritten = SDL_SaveBMP(pSurface, filePath.c_str()) == 0;
+	else
+		isWritten = WritePPM(filePath, pSurface);
+	SDL_UnlockSurface(pSurface);
+
+	if (!isWritten)
+		std::cout << "ERROR: could not write image " << filePath << "\n";
+	return isWritten;
+}
+
+std::string Elite::GetNumberedFilePath(const std::string& filePath, uint32_t frameNumber)
+{
+	char number[16]{};
+	snprintf(number, sizeof(number), "_%04u", frameNumber);
+
+	const size_t dotPosition = filePath.find_last_of('.');
+	if (dotPosition == std::string::npos)
+		return filePath + number;
+	return filePath.substr(0, dotPosition) + number + filePath.substr(dotPosition);
+}
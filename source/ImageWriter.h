@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct SDL_Surface;
+
+namespace Elite
+{
+	//Writes a surface to disk, the format is picked from the extension (.png, .bmp, anything else is written as binary .ppm)
+	bool WriteImage(const std::string& filePath, SDL_Surface* pSurface);
+
+	//Inserts the frame number in front of the extension, "frame.png" becomes "frame_0003.png"
+	std::string GetNumberedFilePath(const std::string& filePath, uint32_t frameNumber);
+}
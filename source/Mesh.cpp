@@ -1,12 +1,16 @@
 #include "pch.h"
+#ifdef ELITE_BACKEND_DX11
 #include "Mesh.h"
 #include "Effect.h"
 #include "FlatEffect.h"
 #include "BaseEffect.h"
 #include "EHelper.h"
+#include <cstddef>
+#include <cstring>
 
-Mesh::Mesh(ID3D11Device* pDevice, std::vector<Elite::Vertex_Input> vertices, std::vector<uint32_t> indices, bool flat)
-	:m_Flat{flat}
+Mesh::Mesh(ID3D11Device* pDevice, const std::vector<Elite::MeshLOD>& lods, bool flat)
+	:m_pDevice{pDevice}
+	,m_Flat{flat}
 	,m_Timer{0.f}
 {
 	m_World = Elite::FMatrix4();
@@ -29,29 +33,49 @@ Mesh::Mesh(ID3D11Device* pDevice, std::vector<Elite::Vertex_Input> vertices, std
 
 	//Create Vertex Layout
 	HRESULT result = S_OK;
-	static const uint32_t numElements{ 4 };
+	static const uint32_t numElements{ 9 };
 	D3D11_INPUT_ELEMENT_DESC vertexDesc[numElements]{};
 
+	//Vertices are PackedVertex, the GPU converts the integers & halves to floats
 	vertexDesc[0].SemanticName = "POSITION";
-	vertexDesc[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	vertexDesc[0].AlignedByteOffset = 0;
+	vertexDesc[0].Format = DXGI_FORMAT_R16G16B16A16_UNORM;
+	vertexDesc[0].AlignedByteOffset = offsetof(Elite::PackedVertex, position);
 	vertexDesc[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 
 	vertexDesc[1].SemanticName = "TEXCOORD";
-	vertexDesc[1].Format = DXGI_FORMAT_R32G32_FLOAT;
-	vertexDesc[1].AlignedByteOffset = 16;
+	vertexDesc[1].Format = DXGI_FORMAT_R16G16_FLOAT;
+	vertexDesc[1].AlignedByteOffset = offsetof(Elite::PackedVertex, uv);
 	vertexDesc[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 
 	vertexDesc[2].SemanticName = "NORMAL";
-	vertexDesc[2].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	vertexDesc[2].AlignedByteOffset = 24;
+	vertexDesc[2].Format = DXGI_FORMAT_R16G16_SNORM;
+	vertexDesc[2].AlignedByteOffset = offsetof(Elite::PackedVertex, normal);
 	vertexDesc[2].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 
 	vertexDesc[3].SemanticName = "TANGENT";
-	vertexDesc[3].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	vertexDesc[3].AlignedByteOffset = 36;
+	vertexDesc[3].Format = DXGI_FORMAT_R16G16_SNORM;
+	vertexDesc[3].AlignedByteOffset = offsetof(Elite::PackedVertex, tangent);
 	vertexDesc[3].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 
+	//Instance world matrix, one matrix column per element, comes from the second vertex buffer
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		vertexDesc[4 + i].SemanticName = "WORLD";
+		vertexDesc[4 + i].SemanticIndex = i;
+		vertexDesc[4 + i].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+		vertexDesc[4 + i].InputSlot = 1;
+		vertexDesc[4 + i].AlignedByteOffset = offsetof(Elite::InstanceData, world) + (i * 16);
+		vertexDesc[4 + i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+		vertexDesc[4 + i].InstanceDataStepRate = 1;
+	}
+
+	vertexDesc[8].SemanticName = "TINT";
+	vertexDesc[8].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+	vertexDesc[8].InputSlot = 1;
+	vertexDesc[8].AlignedByteOffset = offsetof(Elite::InstanceData, tint);
+	vertexDesc[8].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+	vertexDesc[8].InstanceDataStepRate = 1;
+
 	//Create Input Layout
 	D3DX11_PASS_DESC passDesc;
 	m_pEffect->GetTechniques()[0]->GetPassByIndex(0)->GetDesc(&passDesc);
@@ -64,30 +88,56 @@ Mesh::Mesh(ID3D11Device* pDevice, std::vector<Elite::Vertex_Input> vertices, std
 	if (FAILED(result))
 		return;
 
-	//Create vertex buffer
-	D3D11_BUFFER_DESC bd = {};
-	bd.Usage = D3D11_USAGE_IMMUTABLE;
-	bd.ByteWidth = sizeof(Elite::Vertex_Input) * (uint32_t)vertices.size();
-	bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-	bd.CPUAccessFlags = 0;
-	bd.MiscFlags = 0;
-	D3D11_SUBRESOURCE_DATA initData = { 0 };
-	initData.pSysMem = vertices.data();
-	result = pDevice->CreateBuffer(&bd, &initData, &m_pVertexBuffer);
-	if (FAILED(result))
-		return;
+	const Elite::PackedMesh packedMesh = Elite::PackMesh(lods);
+	m_Quantization = packedMesh.quantization;
+	for (size_t level = 0; level < lods.size(); ++level)
+	{
+		const Elite::MeshLOD& lod = lods[level];
 
-	//Create Index Buffer
-	m_AmountIndices = (uint32_t)indices.size();
-	bd.Usage = D3D11_USAGE_IMMUTABLE;
-	bd.ByteWidth = sizeof(uint32_t) * m_AmountIndices;
-	bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-	bd.CPUAccessFlags = 0;
-	bd.MiscFlags = 0;
-	initData.pSysMem = indices.data();
-	result = pDevice->CreateBuffer(&bd, &initData, &m_pIndexBuffer);
-	if (FAILED(result))
-		return;
+		//Create vertex buffer
+		D3D11_BUFFER_DESC bd = {};
+		bd.Usage = D3D11_USAGE_IMMUTABLE;
+		bd.ByteWidth = sizeof(Elite::PackedVertex) * (uint32_t)packedMesh.lods[level].size();
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.CPUAccessFlags = 0;
+		bd.MiscFlags = 0;
+		D3D11_SUBRESOURCE_DATA initData = { 0 };
+		initData.pSysMem = packedMesh.lods[level].data();
+		ID3D11Buffer* pVertexBuffer = nullptr;
+		result = pDevice->CreateBuffer(&bd, &initData, &pVertexBuffer);
+		if (FAILED(result))
+			return;
+
+		//Create Index Buffer
+		bd.Usage = D3D11_USAGE_IMMUTABLE;
+		bd.ByteWidth = sizeof(uint32_t) * (uint32_t)lod.indices.size();
+		bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		bd.CPUAccessFlags = 0;
+		bd.MiscFlags = 0;
+		initData.pSysMem = lod.indices.data();
+		ID3D11Buffer* pIndexBuffer = nullptr;
+		result = pDevice->CreateBuffer(&bd, &initData, &pIndexBuffer);
+		if (FAILED(result))
+		{
+			pVertexBuffer->Release();
+			return;
+		}
+
+		m_pVertexBuffers.push_back(pVertexBuffer);
+		m_pIndexBuffers.push_back(pIndexBuffer);
+		m_AmountIndices.push_back((uint32_t)lod.indices.size());
+	}
+
+	//Set maps & quantization, effect variables keep their value until they are set again
+	m_pEffect->SetVertexQuantization(m_Quantization);
+	if (m_Flat)
+	{
+		m_pEffect->SetMaps(m_pDiffuseTexture->GetResourceView());
+	}
+	else
+	{
+		m_pEffect->SetMaps(m_pDiffuseTexture->GetResourceView(), m_pNormalTexture->GetResourceView(), m_pSpecularTexture->GetResourceView(), m_pGlosinessTexture->GetResourceView());
+	}
 }
 
 Mesh::~Mesh()
@@ -96,13 +146,17 @@ Mesh::~Mesh()
 	{
 		m_pVertexLayout->Release();
 	}
-	if (m_pVertexBuffer)
+	for (ID3D11Buffer* pVertexBuffer : m_pVertexBuffers)
 	{
-		m_pVertexBuffer->Release();
+		pVertexBuffer->Release();
 	}
-	if (m_pIndexBuffer)
+	for (ID3D11Buffer* pIndexBuffer : m_pIndexBuffers)
 	{
-		m_pIndexBuffer->Release();
+		pIndexBuffer->Release();
+	}
+	if (m_pInstanceBuffer)
+	{
+		m_pInstanceBuffer->Release();
 	}
 
 	delete m_pEffect;
@@ -121,16 +175,11 @@ Mesh::~Mesh()
 	m_pSpecularTexture = nullptr;
 }
 
-void Mesh::Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter, Elite::CullMode cull, const Elite::FMatrix4& world)
+void Mesh::Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter, Elite::CullMode cull, const Elite::FMatrix4& world, const std::vector<Elite::InstanceData>& instances)
 {
-	//Set Vertex Buffer
-	UINT stride = sizeof(Elite::Vertex_Input);
-	UINT offset = 0;
-
-	pDeviceContext->IASetVertexBuffers(0, 1, &m_pVertexBuffer, &stride, &offset);
-
-	//Set Index Buffer
-	pDeviceContext->IASetIndexBuffer(m_pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	//Vertex, index & instance buffers are set per level of detail
+	if (m_AmountIndices.empty() || !UpdateInstanceBuffer(pDeviceContext, instances))
+		return;
 
 	//Set Input Buffer
 	pDeviceContext->IASetInputLayout(m_pVertexLayout);
@@ -169,7 +218,7 @@ void Mesh::Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter,
 		for (UINT p = 0; p < techDesc.Passes; ++p)
 		{
 			m_pEffect->GetTechniques()[0]->GetPassByIndex(p)->Apply(0, pDeviceContext);
-			pDeviceContext->DrawIndexed(m_AmountIndices, 0, 0);
+			DrawLods(pDeviceContext);
 		}
 	}
 	if (filter == Elite::Filtering::linear)
@@ -179,7 +228,7 @@ void Mesh::Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter,
 		for (UINT p = 0; p < techDesc.Passes; ++p)
 		{
 			m_pEffect->GetTechniques()[1]->GetPassByIndex(p)->Apply(0, pDeviceContext);
-			pDeviceContext->DrawIndexed(m_AmountIndices, 0, 0);
+			DrawLods(pDeviceContext);
 		}
 	}
 	if (filter == Elite::Filtering::anisotropic)
@@ -189,28 +238,97 @@ void Mesh::Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter,
 		for (UINT p = 0; p < techDesc.Passes; ++p)
 		{
 			m_pEffect->GetTechniques()[2]->GetPassByIndex(p)->Apply(0, pDeviceContext);
-			pDeviceContext->DrawIndexed(m_AmountIndices, 0, 0);
+			DrawLods(pDeviceContext);
 		}
 	}
 }
 
+bool Mesh::UpdateInstanceBuffer(ID3D11DeviceContext* pDeviceContext, const std::vector<Elite::InstanceData>& instances)
+{
+	if (instances.empty())
+		return false;
+
+	//Instances are grouped per level of detail, so every level draws one range of the buffer
+	const uint32_t amountLods = uint32_t(m_AmountIndices.size());
+	m_LodInstanceOffsets.assign(amountLods + 1, 0);
+	for (const Elite::InstanceData& instance : instances)
+		++m_LodInstanceOffsets[std::min(instance.lod, amountLods - 1) + 1];
+	for (uint32_t lod = 0; lod < amountLods; ++lod)
+		m_LodInstanceOffsets[lod + 1] += m_LodInstanceOffsets[lod];
+
+	m_SortedInstances.resize(instances.size());
+	std::vector<uint32_t> fill(m_LodInstanceOffsets.begin(), m_LodInstanceOffsets.end() - 1);
+	for (const Elite::InstanceData& instance : instances)
+		m_SortedInstances[fill[std::min(instance.lod, amountLods - 1)]++] = instance;
+
+	//Recreate the buffer when it is too small, it doubles so growing scenes do not reallocate every frame
+	if (instances.size() > m_InstanceCapacity)
+	{
+		if (m_pInstanceBuffer)
+			m_pInstanceBuffer->Release();
+		m_pInstanceBuffer = nullptr;
+		m_InstanceCapacity = std::max(uint32_t(instances.size()), m_InstanceCapacity * 2);
+
+		D3D11_BUFFER_DESC bd = {};
+		bd.Usage = D3D11_USAGE_DYNAMIC;
+		bd.ByteWidth = sizeof(Elite::InstanceData) * m_InstanceCapacity;
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		bd.MiscFlags = 0;
+		HRESULT result = m_pDevice->CreateBuffer(&bd, nullptr, &m_pInstanceBuffer);
+		if (FAILED(result))
+		{
+			m_InstanceCapacity = 0;
+			return false;
+		}
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mappedResource{};
+	HRESULT result = pDeviceContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+	if (FAILED(result))
+		return false;
+
+	memcpy(mappedResource.pData, m_SortedInstances.data(), sizeof(Elite::InstanceData) * m_SortedInstances.size());
+	pDeviceContext->Unmap(m_pInstanceBuffer, 0);
+	return true;
+}
+
+void Mesh::DrawLods(ID3D11DeviceContext* pDeviceContext)
+{
+	for (uint32_t lod = 0; lod < m_AmountIndices.size(); ++lod)
+	{
+		const UINT amountInstances = m_LodInstanceOffsets[lod + 1] - m_LodInstanceOffsets[lod];
+		if (amountInstances == 0)
+			continue;
+
+		//Set Vertex & Instance Buffers
+		ID3D11Buffer* pBuffers[2]{ m_pVertexBuffers[lod], m_pInstanceBuffer };
+		UINT strides[2]{ sizeof(Elite::PackedVertex), sizeof(Elite::InstanceData) };
+		UINT offsets[2]{ 0, 0 };
+		pDeviceContext->IASetVertexBuffers(0, 2, pBuffers, strides, offsets);
+
+		//Set Index Buffer
+		pDeviceContext->IASetIndexBuffer(m_pIndexBuffers[lod], DXGI_FORMAT_R32_UINT, 0);
+
+		pDeviceContext->DrawIndexedInstanced(m_AmountIndices[lod], amountInstances, 0, 0, m_LodInstanceOffsets[lod]);
+	}
+}
+
 void Mesh::SetCamera(Elite::Camera* pCamera)
 {
 	m_pCamera = pCamera;
+	m_CameraVersion = 0;
 }
 
 void Mesh::Update(float dT, const Elite::FMatrix4& world)
 {
-	//Update Matrices & maps
+	if (m_pCamera->GetVersion() == m_CameraVersion && world == m_World)
+		return;
+	m_CameraVersion = m_pCamera->GetVersion();
+	m_World = world;
+
+	//Update Matrices
 	m_WorldViewProjection = m_pCamera->GetProjectionMatrix() * m_pCamera->GetWorldToView() * world;
 	m_pEffect->SetMatrices(m_WorldViewProjection, world, m_pCamera->GetViewToWorld());
-
-	if (m_Flat)
-	{
-		m_pEffect->SetMaps(m_pDiffuseTexture->GetResourceView());
-	}
-	else
-	{
-		m_pEffect->SetMaps(m_pDiffuseTexture->GetResourceView(), m_pNormalTexture->GetResourceView(), m_pSpecularTexture->GetResourceView(), m_pGlosinessTexture->GetResourceView());
-	}
 }
+#endif
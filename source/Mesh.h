@@ -1,32 +1,50 @@
 #pragma once
+#ifdef ELITE_BACKEND_DX11
 #include <vector>
 #include "ECamera.h"
 #include "Texture.h"
+#include "RenderBackend.h"
+#include "PackedVertex.h"
 class BaseEffect;
 
 class Mesh
 {
 public:
-	Mesh(ID3D11Device* pDevice, std::vector<Elite::Vertex_Input> vertices, std::vector<uint32_t> indices, bool flat = false);
+	Mesh(ID3D11Device* pDevice, const std::vector<Elite::MeshLOD>& lods, bool flat = false);
 	~Mesh();
 
-	void Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter, Elite::CullMode cull, const Elite::FMatrix4& world);
+	//Draws every instance with the level of detail it asks for, one instanced draw call per level
+	void Render(ID3D11DeviceContext* pDeviceContext, Elite::Filtering filter, Elite::CullMode cull, const Elite::FMatrix4& world, const std::vector<Elite::InstanceData>& instances);
 
 	void SetCamera(Elite::Camera* pCamera);
+	//Maps & the vertex quantization are set once at construction, they never change
 	void Update(float dT, const Elite::FMatrix4& world);
 private:
+	bool UpdateInstanceBuffer(ID3D11DeviceContext* pDeviceContext, const std::vector<Elite::InstanceData>& instances);
+	void DrawLods(ID3D11DeviceContext* pDeviceContext);
+
 	BaseEffect* m_pEffect = nullptr;
+	ID3D11Device* m_pDevice = nullptr;
 
 	ID3D11InputLayout* m_pVertexLayout = nullptr;
-	ID3D11Buffer* m_pVertexBuffer = nullptr;
-	ID3D11Buffer* m_pIndexBuffer = nullptr;
-
-	uint32_t m_AmountIndices{};
+	//One vertex & index buffer per level of detail, the vertices are packed against the bounds of all levels
+	Elite::VertexQuantization m_Quantization{};
+	std::vector<ID3D11Buffer*> m_pVertexBuffers;
+	std::vector<ID3D11Buffer*> m_pIndexBuffers;
+	std::vector<uint32_t> m_AmountIndices;
+
+	//Per instance world matrix & tint, sorted by level of detail & grows when more instances are drawn
+	ID3D11Buffer* m_pInstanceBuffer = nullptr;
+	uint32_t m_InstanceCapacity{};
+	std::vector<Elite::InstanceData> m_SortedInstances;
+	std::vector<uint32_t> m_LodInstanceOffsets;
 
 	Elite::Camera* m_pCamera = nullptr;
 
+	//The matrices are only set again when the camera or the world changed
 	Elite::FMatrix4 m_WorldViewProjection;
 	Elite::FMatrix4 m_World;
+	uint32_t m_CameraVersion{};
 
 	Elite::Texture* m_pDiffuseTexture = nullptr;
 	Elite::Texture* m_pNormalTexture = nullptr;
@@ -35,4 +53,5 @@ private:
 
 	bool m_Flat;
 	float m_Timer = 0.f;
-};
\ No newline at end of file
+};
+#endif
@@ -0,0 +1,499 @@
+#include "pch.h"
+#include "MeshLOD.h"
+#include <fstream>
+#include <numeric>
+#include <chrono>
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+	struct Position
+	{
+		double x, y, z;
+	};
+
+	Position GetPosition(const Elite::Vertex_Input& v)
+	{
+		return Position{ v.position.x, v.position.y, v.position.z };
+	}
+
+	Position Subtract(const Position& a, const Position& b)
+	{
+		return Position{ a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	Position Cross(const Position& a, const Position& b)
+	{
+		return Position{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	double Dot(const Position& a, const Position& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	//Sum of squared distances to a set of planes, weighted by the area the planes came from
+	struct Quadric
+	{
+		double xx, xy, xz, xw, yy, yz, yw, zz, zw, ww;
+		double weight;
+
+		void AddPlane(const Position& normal, double d, double planeWeight)
+		{
+			xx += planeWeight * normal.x * normal.x;
+			xy += planeWeight * normal.x * normal.y;
+			xz += planeWeight * normal.x * normal.z;
+			xw += planeWeight * normal.x * d;
+			yy += planeWeight * normal.y * normal.y;
+			yz += planeWeight * normal.y * normal.z;
+			yw += planeWeight * normal.y * d;
+			zz += planeWeight * normal.z * normal.z;
+			zw += planeWeight * normal.z * d;
+			ww += planeWeight * d * d;
+			weight += planeWeight;
+		}
+
+		void Add(const Quadric& other)
+		{
+			xx += other.xx; xy += other.xy; xz += other.xz; xw += other.xw;
+			yy += other.yy; yz += other.yz; yw += other.yw;
+			zz += other.zz; zw += other.zw;
+			ww += other.ww;
+			weight += other.weight;
+		}
+
+		//Mean squared distance of p to the planes
+		double GetError(const Position& p) const
+		{
+			const double error = xx * p.x * p.x + 2.0 * xy * p.x * p.y + 2.0 * xz * p.x * p.z + 2.0 * xw * p.x
+				+ yy * p.y * p.y + 2.0 * yz * p.y * p.z + 2.0 * yw * p.y
+				+ zz * p.z * p.z + 2.0 * zw * p.z
+				+ ww;
+			return (weight > 0.0) ? std::max(error / weight, 0.0) : 0.0;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double cost;
+	};
+
+	uint64_t GetEdgeKey(uint32_t a, uint32_t b)
+	{
+		return (uint64_t(std::min(a, b)) << 32) | uint64_t(std::max(a, b));
+	}
+
+	//Groups vertices that sit at the same position, every group is one corner of the surface
+	uint32_t BuildCorners(const std::vector<Elite::Vertex_Input>& vertices, std::vector<uint32_t>& corners)
+	{
+		std::vector<uint32_t> order(vertices.size());
+		std::iota(order.begin(), order.end(), 0);
+		auto isLess = [&vertices](uint32_t a, uint32_t b)
+		{
+			const Elite::FPoint4& pa = vertices[a].position;
+			const Elite::FPoint4& pb = vertices[b].position;
+			if (pa.x != pb.x)
+				return pa.x < pb.x;
+			if (pa.y != pb.y)
+				return pa.y < pb.y;
+			return pa.z < pb.z;
+		};
+		std::sort(order.begin(), order.end(), isLess);
+
+		corners.resize(vertices.size());
+		uint32_t cornerCount = 0;
+		for (uint32_t i = 0; i < order.size(); ++i)
+		{
+			if (i > 0 && isLess(order[i - 1], order[i]))
+				++cornerCount;
+			corners[order[i]] = cornerCount;
+		}
+		return vertices.empty() ? 0 : cornerCount + 1;
+	}
+}
+
+void Elite::WeldVertices(std::vector<Vertex_Input>& vertices, std::vector<uint32_t>& indices)
+{
+	auto getKey = [&vertices](uint32_t i)
+	{
+		const Vertex_Input& v = vertices[i];
+		return std::make_tuple(v.position.x, v.position.y, v.position.z, v.uv.x, v.uv.y, v.normal.x, v.normal.y, v.normal.z);
+	};
+
+	std::vector<uint32_t> order(vertices.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&getKey](uint32_t a, uint32_t b) { return getKey(a) < getKey(b); });
+
+	std::vector<Vertex_Input> welded{};
+	std::vector<uint32_t> remap(vertices.size());
+	for (uint32_t i = 0; i < order.size(); ++i)
+	{
+		if (i == 0 || getKey(order[i - 1]) != getKey(order[i]))
+			welded.push_back(vertices[order[i]]);
+		remap[order[i]] = uint32_t(welded.size()) - 1;
+	}
+
+	for (uint32_t& index : indices)
+		index = remap[index];
+	vertices = std::move(welded);
+}
+
+std::vector<uint32_t> Elite::SimplifyMesh(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float& error)
+{
+	error = 0.f;
+	std::vector<uint32_t> result = indices;
+	if (result.size() <= targetIndexCount)
+		return result;
+
+	std::vector<uint32_t> corners{};
+	const uint32_t cornerCount = BuildCorners(vertices, corners);
+	std::vector<Position> positions(cornerCount);
+	for (uint32_t i = 0; i < vertices.size(); ++i)
+		positions[corners[i]] = GetPosition(vertices[i]);
+
+	//Every corner starts with the planes of its triangles
+	std::vector<Quadric> quadrics(cornerCount, Quadric{});
+	std::unordered_map<uint64_t, uint32_t> edgeCounts{};
+	for (size_t t = 0; t < result.size(); t += 3)
+	{
+		const uint32_t c[3]{ corners[result[t]], corners[result[t + 1]], corners[result[t + 2]] };
+		Position normal = Cross(Subtract(positions[c[1]], positions[c[0]]), Subtract(positions[c[2]], positions[c[0]]));
+		const double length = sqrt(Dot(normal, normal));
+		if (length <= 0.0)
+			continue;
+
+		normal = Position{ normal.x / length, normal.y / length, normal.z / length };
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			quadrics[c[i]].AddPlane(normal, -Dot(normal, positions[c[0]]), length * 0.5);
+			++edgeCounts[GetEdgeKey(c[i], c[(i + 1) % 3])];
+		}
+	}
+
+	//Borders get a plane through the edge, standing up from the triangle, so they do not shrink inwards
+	std::vector<bool> isBorder(cornerCount, false);
+	for (size_t t = 0; t < result.size(); t += 3)
+	{
+		const uint32_t c[3]{ corners[result[t]], corners[result[t + 1]], corners[result[t + 2]] };
+		const Position normal = Cross(Subtract(positions[c[1]], positions[c[0]]), Subtract(positions[c[2]], positions[c[0]]));
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const uint32_t a = c[i];
+			const uint32_t b = c[(i + 1) % 3];
+			if (edgeCounts[GetEdgeKey(a, b)] == 2)
+				continue;
+
+			isBorder[a] = true;
+			isBorder[b] = true;
+			const Position edge = Subtract(positions[b], positions[a]);
+			Position borderNormal = Cross(edge, normal);
+			const double length = sqrt(Dot(borderNormal, borderNormal));
+			if (length <= 0.0)
+				continue;
+
+			borderNormal = Position{ borderNormal.x / length, borderNormal.y / length, borderNormal.z / length };
+			const double edgeLength = sqrt(Dot(edge, edge));
+			quadrics[a].AddPlane(borderNormal, -Dot(borderNormal, positions[a]), edgeLength * edgeLength);
+			quadrics[b].AddPlane(borderNormal, -Dot(borderNormal, positions[a]), edgeLength * edgeLength);
+		}
+	}
+
+	std::vector<uint32_t> triangleOffsets(cornerCount + 1);
+	std::vector<uint32_t> cornerTriangles{};
+	std::vector<uint32_t> wedgeRemap(vertices.size());
+	std::vector<bool> isLocked(cornerCount);
+	std::vector<Collapse> collapses{};
+	double maxError = 0.0;
+
+	//Every pass collapses the cheapest edges whose neighbourhoods do not overlap
+	while (result.size() > targetIndexCount)
+	{
+		const uint32_t triangleCount = uint32_t(result.size() / 3);
+
+		//Triangles around every corner
+		std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+		for (uint32_t index : result)
+			++triangleOffsets[corners[index] + 1];
+		for (uint32_t c = 0; c < cornerCount; ++c)
+			triangleOffsets[c + 1] += triangleOffsets[c];
+		cornerTriangles.resize(result.size());
+		std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+		for (uint32_t i = 0; i < result.size(); ++i)
+			cornerTriangles[fill[corners[result[i]]]++] = i / 3;
+
+		edgeCounts.clear();
+		for (uint32_t i = 0; i < result.size(); i += 3)
+		{
+			for (uint32_t e = 0; e < 3; ++e)
+				++edgeCounts[GetEdgeKey(corners[result[i + e]], corners[result[i + (e + 1) % 3]])];
+		}
+
+		//A corner moves onto a neighbour when every wedge of it has an edge to a wedge of the neighbour, that wedge takes its place
+		auto matchWedges = [&](uint32_t from, uint32_t to, bool apply)
+		{
+			for (uint32_t i = triangleOffsets[from]; i < triangleOffsets[from + 1]; ++i)
+			{
+				const uint32_t t = cornerTriangles[i] * 3;
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					const uint32_t wedge = result[t + k];
+					if (corners[wedge] != from)
+						continue;
+
+					uint32_t match = UINT32_MAX;
+					for (uint32_t j = triangleOffsets[from]; j < triangleOffsets[from + 1] && match == UINT32_MAX; ++j)
+					{
+						const uint32_t s = cornerTriangles[j] * 3;
+						if (result[s] != wedge && result[s + 1] != wedge && result[s + 2] != wedge)
+							continue;
+						for (uint32_t l = 0; l < 3; ++l)
+						{
+							if (corners[result[s + l]] == to)
+								match = result[s + l];
+						}
+					}
+
+					if (match == UINT32_MAX)
+						return false;
+					if (apply)
+						wedgeRemap[wedge] = match;
+				}
+			}
+			return true;
+		};
+
+		auto isValid = [&](uint32_t from, uint32_t to)
+		{
+			if (isBorder[from] && (!isBorder[to] || edgeCounts[GetEdgeKey(from, to)] == 2))
+				return false;
+			return matchWedges(from, to, false);
+		};
+
+		collapses.clear();
+		for (const auto& edge : edgeCounts)
+		{
+			const uint32_t a = uint32_t(edge.first >> 32);
+			const uint32_t b = uint32_t(edge.first & 0xFFFFFFFF);
+			Quadric quadric = quadrics[a];
+			quadric.Add(quadrics[b]);
+
+			const double costAB = isValid(a, b) ? quadric.GetError(positions[b]) : DBL_MAX;
+			const double costBA = isValid(b, a) ? quadric.GetError(positions[a]) : DBL_MAX;
+			if (costAB == DBL_MAX && costBA == DBL_MAX)
+				continue;
+			collapses.push_back((costAB <= costBA) ? Collapse{ a, b, costAB } : Collapse{ b, a, costBA });
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+		//Every collapse removes about two triangles
+		const uint32_t targetTriangles = targetIndexCount / 3;
+		const uint32_t maxCollapses = std::max((triangleCount - targetTriangles) / 2, 1u);
+		std::fill(isLocked.begin(), isLocked.end(), false);
+		std::iota(wedgeRemap.begin(), wedgeRemap.end(), 0);
+		uint32_t appliedCollapses = 0;
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (appliedCollapses == maxCollapses)
+				break;
+			if (isLocked[collapse.from] || isLocked[collapse.to])
+				continue;
+
+			//Moving the corner may not flip any of the triangles that stay
+			bool isFlipped = false;
+			for (uint32_t i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1] && !isFlipped; ++i)
+			{
+				const uint32_t t = cornerTriangles[i] * 3;
+				Position before[3]{};
+				Position after[3]{};
+				bool isRemoved = false;
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					const uint32_t c = corners[result[t + k]];
+					isRemoved |= (c == collapse.to);
+					before[k] = positions[c];
+					after[k] = (c == collapse.from) ? positions[collapse.to] : positions[c];
+				}
+				if (isRemoved)
+					continue;
+
+				const Position normalBefore = Cross(Subtract(before[1], before[0]), Subtract(before[2], before[0]));
+				const Position normalAfter = Cross(Subtract(after[1], after[0]), Subtract(after[2], after[0]));
+				isFlipped = Dot(normalBefore, normalAfter) <= 0.0;
+			}
+			if (isFlipped)
+				continue;
+
+			//Corners around the collapse are locked until the next pass, their triangles are about to change
+			for (uint32_t i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1]; ++i)
+			{
+				const uint32_t t = cornerTriangles[i] * 3;
+				for (uint32_t k = 0; k < 3; ++k)
+					isLocked[corners[result[t + k]]] = true;
+			}
+			isLocked[collapse.to] = true;
+
+			matchWedges(collapse.from, collapse.to, true);
+			quadrics[collapse.to].Add(quadrics[collapse.from]);
+			maxError = std::max(maxError, collapse.cost);
+			++appliedCollapses;
+		}
+
+		if (appliedCollapses == 0)
+			break;
+
+		//Triangles that lost a corner are dropped
+		size_t writeIndex = 0;
+		for (size_t t = 0; t < result.size(); t += 3)
+		{
+			const uint32_t i0 = wedgeRemap[result[t]];
+			const uint32_t i1 = wedgeRemap[result[t + 1]];
+			const uint32_t i2 = wedgeRemap[result[t + 2]];
+			if (corners[i0] == corners[i1] || corners[i1] == corners[i2] || corners[i0] == corners[i2])
+				continue;
+
+			result[writeIndex++] = i0;
+			result[writeIndex++] = i1;
+			result[writeIndex++] = i2;
+		}
+		result.resize(writeIndex);
+	}
+
+	error = float(sqrt(maxError));
+	return result;
+}
+
+std::vector<Elite::MeshLOD> Elite::BuildLODChain(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices, uint32_t minTriangles, uint32_t maxLevels)
+{
+	std::vector<MeshLOD> lods{ MeshLOD{ vertices, indices, 0.f } };
+
+	//Every level starts from the full mesh, so its error is measured against the original surface
+	uint32_t targetIndexCount = uint32_t(indices.size());
+	while (lods.size() < maxLevels && (targetIndexCount / 3) > minTriangles)
+	{
+		targetIndexCount = std::max(targetIndexCount / 2, minTriangles * 3);
+
+		float error = 0.f;
+		const std::vector<uint32_t> simplified = SimplifyMesh(vertices, indices, targetIndexCount, error);
+
+		//Stop once the simplifier can not remove a meaningful amount anymore
+		if (simplified.size() * 4 > lods.back().indices.size() * 3)
+			break;
+
+		//Only the vertices this level still uses are kept
+		MeshLOD lod{ {}, {}, std::max(error, lods.back().error) };
+		std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+		for (uint32_t index : simplified)
+		{
+			if (remap[index] == UINT32_MAX)
+			{
+				remap[index] = uint32_t(lod.vertices.size());
+				lod.vertices.push_back(vertices[index]);
+			}
+			lod.indices.push_back(remap[index]);
+		}
+		lods.push_back(std::move(lod));
+	}
+	return lods;
+}
+
+namespace
+{
+	const uint32_t LODCacheMagic = 0x444F4C45; //"ELOD"
+	const uint32_t LODCacheVersion = 1;
+
+	template<typename T>
+	void Write(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool Read(std::ifstream& file, T& value)
+	{
+		return bool(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+std::vector<Elite::MeshLOD> Elite::LoadLODChain(const std::string& cachePath, const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices)
+{
+	uint64_t checksum = HashBytes(vertices.data(), vertices.size() * sizeof(Vertex_Input));
+	checksum = HashBytes(indices.data(), indices.size() * sizeof(uint32_t), checksum);
+
+	//The cache is only used when it was written by this version, for a mesh with exactly the same data
+	std::ifstream inFile(cachePath, std::ios::binary);
+	if (inFile)
+	{
+		uint32_t magic = 0, version = 0, vertexSize = 0, levelCount = 0;
+		uint64_t fileChecksum = 0;
+		if (Read(inFile, magic) && Read(inFile, version) && Read(inFile, vertexSize) && Read(inFile, fileChecksum) && Read(inFile, levelCount)
+			&& magic == LODCacheMagic && version == LODCacheVersion && vertexSize == sizeof(Vertex_Input) && fileChecksum == checksum)
+		{
+			std::vector<MeshLOD> lods(levelCount);
+			bool isValid = true;
+			for (size_t level = 0; level < lods.size() && isValid; ++level)
+			{
+				MeshLOD& lod = lods[level];
+				uint32_t vertexCount = 0, indexCount = 0;
+				isValid = Read(inFile, vertexCount) && Read(inFile, indexCount) && Read(inFile, lod.error);
+
+				//The first level is the mesh itself & simplified levels never grow, so a stale or damaged cache can not ask for more
+				isValid = isValid && (indexCount % 3 == 0) && vertexCount <= vertices.size() && indexCount <= indices.size()
+					&& (level > 0 || (vertexCount == vertices.size() && indexCount == indices.size()));
+				if (!isValid)
+					break;
+
+				lod.vertices.resize(vertexCount);
+				lod.indices.resize(indexCount);
+				isValid = bool(inFile.read(reinterpret_cast<char*>(lod.vertices.data()), vertexCount * sizeof(Vertex_Input)))
+					&& bool(inFile.read(reinterpret_cast<char*>(lod.indices.data()), indexCount * sizeof(uint32_t)));
+
+				//The rasterizer indexes the vertices without checking
+				for (size_t i = 0; i < lod.indices.size() && isValid; ++i)
+					isValid = lod.indices[i] < vertexCount;
+			}
+
+			if (isValid && !lods.empty())
+			{
+				std::cout << "LOD: loaded " << lods.size() << " level(s) from " << cachePath << "\n";
+				return lods;
+			}
+			std::cout << "LOD: " << cachePath << " is damaged, rebuilding it\n";
+		}
+	}
+	inFile.close();
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	std::vector<MeshLOD> lods = BuildLODChain(vertices, indices);
+	const float seconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << "LOD: built " << lods.size() << " level(s) in " << seconds << "s, triangles";
+	for (const MeshLOD& lod : lods)
+		std::cout << " " << lod.indices.size() / 3;
+	std::cout << "\n";
+
+	std::ofstream outFile(cachePath, std::ios::binary);
+	if (!outFile)
+	{
+		std::cout << "LOD: could not write " << cachePath << "\n";
+		return lods;
+	}
+
+	Write(outFile, LODCacheMagic);
+	Write(outFile, LODCacheVersion);
+	Write(outFile, uint32_t(sizeof(Vertex_Input)));
+	Write(outFile, checksum);
+	Write(outFile, uint32_t(lods.size()));
+	for (const MeshLOD& lod : lods)
+	{
+		Write(outFile, uint32_t(lod.vertices.size()));
+		Write(outFile, uint32_t(lod.indices.size()));
+		Write(outFile, lod.error);
+		outFile.write(reinterpret_cast<const char*>(lod.vertices.data()), lod.vertices.size() * sizeof(Vertex_Input));
+		outFile.write(reinterpret_cast<const char*>(lod.indices.data()), lod.indices.size() * sizeof(uint32_t));
+	}
+	return lods;
+}
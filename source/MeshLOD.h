@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "EHelper.h"
+
+namespace Elite
+{
+	//One level of detail, error is how far (in model space) the surface moved away from the full mesh
+	struct MeshLOD
+	{
+		std::vector<Vertex_Input> vertices;
+		std::vector<uint32_t> indices;
+		float error;
+	};
+
+	//Merges vertices with the same position, uv & normal so triangles share them
+	void WeldVertices(std::vector<Vertex_Input>& vertices, std::vector<uint32_t>& indices);
+
+	//Quadric error edge collapses until at most targetIndexCount indices are left, only the indices change
+	//Borders & uv or normal seams only collapse along themselves, so they keep their shape
+	std::vector<uint32_t> SimplifyMesh(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float& error);
+
+	//Halves the triangles every level until minTriangles is reached, level 0 is the full mesh
+	std::vector<MeshLOD> BuildLODChain(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices, uint32_t minTriangles = 256, uint32_t maxLevels = 8);
+
+	//Reads the chain from cachePath when it was built from this exact mesh, otherwise builds it & writes it there
+	std::vector<MeshLOD> LoadLODChain(const std::string& cachePath, const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices);
+}
@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "Meshlet.h"
+#include <numeric>
+#include <tuple>
+
+namespace
+{
+	const uint8_t NotInMeshlet = 0xFF;
+
+	//How much a triangle that faces away from the meshlet counts against it, in vertices it would add
+	const float ConeWeight = 0.5f;
+
+	//Triangles that face further away than this from the meshlet start a new one, so the cones stay cullable
+	const float MinConeDot = 0.7f;
+
+	//How many triangles after the first unused one are looked at when the meshlet has no neighbours left
+	const uint32_t SeedWindow = 256;
+
+	Elite::FPoint3 GetPosition(const Elite::Vertex_Input& v)
+	{
+		return Elite::FPoint3{ v.position.x, v.position.y, v.position.z };
+	}
+
+	void FinishMeshlet(Elite::MeshletMesh& mesh, Elite::Meshlet& meshlet, const std::vector<Elite::Vertex_Input>& vertices, const std::vector<Elite::FVector3>& normals, const std::vector<uint32_t>& triangles)
+	{
+		//Sphere around the box of the vertices
+		Elite::FPoint3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+		Elite::FPoint3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (uint32_t i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+		{
+			const Elite::FPoint3 position = GetPosition(vertices[mesh.vertices[i]]);
+			for (uint8_t axis = 0; axis < 3; ++axis)
+			{
+				min[axis] = std::min(min[axis], position[axis]);
+				max[axis] = std::max(max[axis], position[axis]);
+			}
+		}
+
+		meshlet.center = Elite::FPoint3{ (min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f };
+		meshlet.radius = 0.f;
+		for (uint32_t i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+			meshlet.radius = std::max(meshlet.radius, Elite::Magnitude(GetPosition(vertices[mesh.vertices[i]]) - meshlet.center));
+
+		//Cone around the average normal, degenerate triangles have no normal & can not be seen anyway
+		Elite::FVector3 axis{};
+		for (uint32_t triangle : triangles)
+			axis += normals[triangle];
+
+		meshlet.coneAxis = Elite::FVector3{};
+		meshlet.coneCutoff = 1.f;
+		if (Elite::Magnitude(axis) <= 0.f)
+			return;
+		meshlet.coneAxis = Elite::GetNormalized(axis);
+
+		float minDot = 1.f;
+		for (uint32_t triangle : triangles)
+		{
+			if (Elite::SqrMagnitude(normals[triangle]) > 0.f)
+				minDot = std::min(minDot, Elite::Dot(normals[triangle], meshlet.coneAxis));
+		}
+
+		//Cones close to a half sphere are almost never back facing, they are not worth the test
+		if (minDot > 0.1f)
+			meshlet.coneCutoff = sqrtf(1.f - minDot * minDot);
+	}
+}
+
+Elite::MeshletMesh Elite::BuildMeshlets(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices)
+{
+	MeshletMesh mesh{};
+	const uint32_t triangleCount = uint32_t(indices.size() / 3);
+	if (triangleCount == 0)
+		return mesh;
+
+	//Vertices split by uv or normal seams are grouped by position, so meshlets grow across hard edges
+	std::vector<uint32_t> order(vertices.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&vertices](uint32_t a, uint32_t b)
+	{
+		return std::make_tuple(vertices[a].position.x, vertices[a].position.y, vertices[a].position.z)
+			< std::make_tuple(vertices[b].position.x, vertices[b].position.y, vertices[b].position.z);
+	});
+
+	std::vector<uint32_t> positionIds(vertices.size());
+	uint32_t amountOfPositions = 0;
+	for (uint32_t i = 0; i < order.size(); ++i)
+	{
+		if (i > 0 && !(GetPosition(vertices[order[i]]) == GetPosition(vertices[order[i - 1]])))
+			++amountOfPositions;
+		positionIds[order[i]] = amountOfPositions;
+	}
+	++amountOfPositions;
+
+	//Triangles around every position
+	std::vector<uint32_t> adjacencyOffsets(amountOfPositions + 1, 0);
+	for (uint32_t index : indices)
+		++adjacencyOffsets[positionIds[index] + 1];
+	for (uint32_t p = 0; p < amountOfPositions; ++p)
+		adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (uint32_t i = 0; i < indices.size(); ++i)
+		adjacency[fill[positionIds[indices[i]]]++] = i / 3;
+
+	//Front facing normals, the side the rasterizer keeps when it culls back faces
+	std::vector<FVector3> normals(triangleCount);
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		const FPoint3 p0 = GetPosition(vertices[indices[t * 3]]);
+		const FPoint3 p1 = GetPosition(vertices[indices[t * 3 + 1]]);
+		const FPoint3 p2 = GetPosition(vertices[indices[t * 3 + 2]]);
+		const FVector3 normal = Cross(p2 - p0, p1 - p0);
+		if (Magnitude(normal) > 0.f)
+			normals[t] = GetNormalized(normal);
+	}
+
+	std::vector<bool> isUsed(triangleCount, false);
+	std::vector<uint8_t> localIndices(vertices.size(), NotInMeshlet);
+	std::vector<uint32_t> meshletTriangles{};
+	uint32_t nextSeed = 0;
+
+	while (true)
+	{
+		while (nextSeed < triangleCount && isUsed[nextSeed])
+			++nextSeed;
+		if (nextSeed == triangleCount)
+			break;
+
+		Meshlet meshlet{ uint32_t(mesh.vertices.size()), 0, uint32_t(mesh.triangles.size() / 3), 0, FPoint3{}, 0.f, FVector3{}, 1.f };
+		FVector3 coneNormal{};
+		meshletTriangles.clear();
+
+		uint32_t triangle = nextSeed;
+		while (true)
+		{
+			//Add the triangle & the vertices the meshlet does not have yet
+			isUsed[triangle] = true;
+			meshletTriangles.push_back(triangle);
+			for (uint32_t corner = 0; corner < 3; ++corner)
+			{
+				const uint32_t index = indices[triangle * 3 + corner];
+				if (localIndices[index] == NotInMeshlet)
+				{
+					localIndices[index] = uint8_t(meshlet.vertexCount++);
+					mesh.vertices.push_back(index);
+				}
+				mesh.triangles.push_back(localIndices[index]);
+			}
+			++meshlet.triangleCount;
+			coneNormal += normals[triangle];
+
+			if (meshlet.triangleCount == MaxMeshletTriangles)
+				break;
+
+			//Best unused neighbour of the meshlet that still fits
+			const FVector3 averageNormal = (Magnitude(coneNormal) > 0.f) ? GetNormalized(coneNormal) : coneNormal;
+			uint32_t bestTriangle = UINT32_MAX;
+			float bestScore = FLT_MAX;
+			for (uint32_t i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+			{
+				const uint32_t position = positionIds[mesh.vertices[i]];
+				for (uint32_t a = adjacencyOffsets[position]; a < adjacencyOffsets[position + 1]; ++a)
+				{
+					const uint32_t candidate = adjacency[a];
+					if (isUsed[candidate])
+						continue;
+
+					uint32_t newVertices = 0;
+					for (uint32_t corner = 0; corner < 3; ++corner)
+						newVertices += (localIndices[indices[candidate * 3 + corner]] == NotInMeshlet) ? 1 : 0;
+					if (meshlet.vertexCount + newVertices > MaxMeshletVertices || Dot(normals[candidate], averageNormal) < MinConeDot)
+						continue;
+
+					const float score = float(newVertices) + ConeWeight * (1.f - Dot(normals[candidate], averageNormal));
+					if (score < bestScore)
+					{
+						bestScore = score;
+						bestTriangle = candidate;
+					}
+				}
+			}
+
+			//Separate pieces (bolts, pipes, ...) continue with the closest of the next unused triangles
+			if (bestTriangle == UINT32_MAX && meshlet.vertexCount + 3 <= MaxMeshletVertices)
+			{
+				FPoint3 center{};
+				for (uint32_t i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+					center += FVector3(GetPosition(vertices[mesh.vertices[i]]) - FPoint3{}) / float(meshlet.vertexCount);
+
+				float bestDistance = FLT_MAX;
+				for (uint32_t candidate = nextSeed; candidate < std::min(nextSeed + SeedWindow, triangleCount); ++candidate)
+				{
+					if (isUsed[candidate] || Dot(normals[candidate], averageNormal) < MinConeDot)
+						continue;
+
+					const float distance = SqrMagnitude(GetPosition(vertices[indices[candidate * 3]]) - center);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestTriangle = candidate;
+					}
+				}
+			}
+
+			if (bestTriangle == UINT32_MAX)
+				break;
+			triangle = bestTriangle;
+		}
+
+		for (uint32_t i = meshlet.vertexOffset; i < meshlet.vertexOffset + meshlet.vertexCount; ++i)
+			localIndices[mesh.vertices[i]] = NotInMeshlet;
+
+		FinishMeshlet(mesh, meshlet, vertices, normals, meshletTriangles);
+		mesh.meshlets.push_back(meshlet);
+	}
+
+	return mesh;
+}
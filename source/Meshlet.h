@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EHelper.h"
+
+namespace Elite
+{
+	//Small cluster of neighbouring triangles that is culled as a whole before any of its vertices are transformed
+	struct Meshlet
+	{
+		//Ranges of MeshletMesh::vertices & MeshletMesh::triangles
+		uint32_t vertexOffset;
+		uint32_t vertexCount;
+		uint32_t triangleOffset;
+		uint32_t triangleCount;
+
+		//Bounding sphere in model space
+		FPoint3 center;
+		float radius;
+
+		//Average front facing normal & the sine of the cone around it that holds every triangle normal
+		//A cutoff of 1 means the normals spread too far to ever be back facing at once
+		FVector3 coneAxis;
+		float coneCutoff;
+	};
+
+	//Meshlets of one mesh, their triangles index the meshlet vertex list so they fit in a byte
+	struct MeshletMesh
+	{
+		std::vector<Meshlet> meshlets;
+		std::vector<uint32_t> vertices;
+		std::vector<uint8_t> triangles;
+	};
+
+	static const uint32_t MaxMeshletVertices = 64;
+	static const uint32_t MaxMeshletTriangles = 124;
+
+	//Grows every meshlet from a seed triangle over its neighbours, preferring triangles that add few vertices & face the same way
+	MeshletMesh BuildMeshlets(const std::vector<Vertex_Input>& vertices, const std::vector<uint32_t>& indices);
+
+	//True when the camera (in model space) only sees the back of every triangle of the meshlet
+	inline bool IsMeshletBackFacing(const Meshlet& meshlet, const FPoint3& camera)
+	{
+		if (meshlet.coneCutoff >= 1.f)
+			return false;
+
+		const FVector3 toCenter{ meshlet.center - camera };
+		return Dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * Magnitude(toCenter) + meshlet.radius;
+	}
+}
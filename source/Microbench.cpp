@@ -0,0 +1,493 @@
+#include "pch.h"
+#include "Microbench.h"
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include "EBRDF.h"
+#include "EOBJParser.h"
+#include "SoftwareBackend.h"
+#include "Texture.h"
+
+namespace
+{
+	const uint32_t AmountOfInputs = 64;
+	//Throughput is the fastest of this many rounds, slower ones were interrupted
+	const uint32_t AmountOfRounds = 5;
+	//Quads per side of the generated OBJ, two triangles each
+	const uint32_t SyntheticOBJQuads = 200;
+
+	//What every operation reports into, operations whose name does not contain the filter are skipped
+	struct MicrobenchRun
+	{
+		std::string filter;
+		uint32_t iterations;
+		float minimumSeconds;
+		std::vector<Elite::MicrobenchResult> results;
+
+		bool IsSelected(const std::string& name) const { return name.find(filter) != std::string::npos; };
+	};
+
+	//Results are summed into here, so the compiler can not drop the work that is timed
+	volatile float g_Sink = 0.f;
+
+	//The scalar bodies of the member operators, explicit specializations replace them for float
+	Elite::FMatrix4 ScalarMultiply(const Elite::FMatrix4& lm, const Elite::FMatrix4& rm)
+	{
+		Elite::FMatrix4 result;
+		for (uint8_t r = 0; r < 4; ++r)
+		{
+			for (uint8_t c = 0; c < 4; ++c)
+				result(r, c) = lm(r, 0) * rm(0, c) + lm(r, 1) * rm(1, c) + lm(r, 2) * rm(2, c) + lm(r, 3) * rm(3, c);
+		}
+		return result;
+	}
+
+	Elite::FPoint4 ScalarTransform(const Elite::FMatrix4& m, const Elite::FPoint4& p)
+	{
+		return Elite::FPoint4(
+			m(0, 0) * p.x + m(0, 1) * p.y + m(0, 2) * p.z + m(0, 3),
+			m(1, 0) * p.x + m(1, 1) * p.y + m(1, 2) * p.z + m(1, 3),
+			m(2, 0) * p.x + m(2, 1) * p.y + m(2, 2) * p.z + m(2, 3),
+			m(3, 0) * p.x + m(3, 1) * p.y + m(3, 2) * p.z + m(3, 3));
+	}
+
+	Elite::FVector4 ScalarTransform(const Elite::FMatrix4& m, const Elite::FVector4& v)
+	{
+		return Elite::FVector4(
+			m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z,
+			m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z,
+			m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z, 0);
+	}
+
+	//Every output is read, otherwise the scalar code only computes the values that are used
+	float Sum(const Elite::FMatrix4& m)
+	{
+		float sum = 0.f;
+		for (uint8_t c = 0; c < 4; ++c)
+			sum += m.data[c][0] + m.data[c][1] + m.data[c][2] + m.data[c][3];
+		return sum;
+	}
+
+	float Sum(const Elite::FPoint4& p)
+	{
+		return p.x + p.y + p.z + p.w;
+	}
+
+	float Sum(const Elite::FVector4& v)
+	{
+		return v.x + v.y + v.z + v.w;
+	}
+
+	//Average time of one call in nanoseconds
+	template<typename Function>
+	double Measure(uint32_t iterations, Function function)
+	{
+		float sum = 0.f;
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < iterations; ++i)
+			sum += function(i % AmountOfInputs);
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		g_Sink = g_Sink + sum;
+		return std::chrono::duration<double, std::nano>(end - start).count() / double(iterations);
+	}
+
+	template<typename Scalar, typename SIMD>
+	void Report(MicrobenchRun& run, const std::string& name, Scalar scalar, SIMD simd)
+	{
+		if (!run.IsSelected(name))
+			return;
+
+		//Both run once untimed, so neither pays for warming the caches
+		Measure(run.iterations / 10 + 1, scalar);
+		Measure(run.iterations / 10 + 1, simd);
+
+		const double scalarTime = Measure(run.iterations, scalar);
+		const double simdTime = Measure(run.iterations, simd);
+		std::cout << "Microbench: " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(2)
+			<< " scalar " << std::setw(7) << scalarTime << " ns, simd " << std::setw(7) << simdTime << " ns ("
+			<< scalarTime / std::max(simdTime, 1e-6) << "x)\n";
+		run.results.push_back({ name + " (scalar)", 1e9 / std::max(scalarTime, 1e-6) });
+		run.results.push_back({ name, 1e9 / std::max(simdTime, 1e-6) });
+	}
+
+	//Seconds that calls in a row take, the function gets the number of the call
+	template<typename Function>
+	double TimeCalls(uint64_t amountOfCalls, Function& function, float& sum)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (uint64_t i = 0; i < amountOfCalls; ++i)
+			sum += function(uint32_t(i));
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	//Calls are doubled until a round takes long enough to time, which also warms the caches
+	template<typename Function>
+	void ReportThroughput(MicrobenchRun& run, const std::string& name, uint32_t itemsPerCall, Function function)
+	{
+		if (!run.IsSelected(name))
+			return;
+
+		float sum = 0.f;
+		const double roundSeconds = double(run.minimumSeconds) / double(AmountOfRounds);
+		uint64_t amountOfCalls = 1;
+		while (TimeCalls(amountOfCalls, function, sum) < roundSeconds)
+			amountOfCalls *= 2;
+
+		double bestSeconds = DBL_MAX;
+		for (uint32_t round = 0; round < AmountOfRounds; ++round)
+			bestSeconds = std::min(bestSeconds, TimeCalls(amountOfCalls, function, sum));
+		g_Sink = g_Sink + sum;
+
+		const double itemsPerSecond = double(amountOfCalls) * double(itemsPerCall) / std::max(bestSeconds, 1e-9);
+		std::cout << "Microbench: " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << itemsPerSecond / 1e6 << " M items/s, " << std::setw(9) << 1e9 / itemsPerSecond << " ns per item\n";
+		run.results.push_back({ name, itemsPerSecond });
+	}
+
+	float Sum(const Elite::RGBColor& color)
+	{
+		return color.r + color.g + color.b;
+	}
+
+	Elite::FVector3 RandomDirection()
+	{
+		return Elite::GetNormalized(Elite::FVector3{ Elite::RandomBinomial(), Elite::RandomBinomial(), Elite::RandomBinomial() } + Elite::FVector3{ 0.f, 0.f, 0.01f });
+	}
+
+	//Triangles in pixels like the rasterizer stage hands them over, facing the camera for back-face culling
+	//Every call tests a 4x4 grid of pixels over the bounding box
+	struct RasterInput
+	{
+		std::vector<Elite::Vertex_Input> vertices;
+		Elite::FPoint2 topLeft;
+		Elite::FVector2 step;
+	};
+
+	std::vector<RasterInput> MakeRasterInputs(float size)
+	{
+		std::vector<RasterInput> inputs{};
+		for (uint32_t i = 0; i < AmountOfInputs; ++i)
+		{
+			const Elite::FPoint2 origin{ Elite::RandomFloat(640.f - size), Elite::RandomFloat(480.f - size) };
+			RasterInput input{};
+			input.vertices.resize(3);
+			for (Elite::Vertex_Input& vertex : input.vertices)
+			{
+				vertex.position = Elite::FPoint4{ origin.x + Elite::RandomFloat(size), origin.y + Elite::RandomFloat(size), 0.4f + Elite::RandomFloat(0.5f), 1.f + Elite::RandomFloat(50.f) };
+				vertex.uv = Elite::FVector2{ Elite::RandomFloat(), Elite::RandomFloat() };
+				vertex.normal = RandomDirection();
+				vertex.tangent = RandomDirection();
+				vertex.viewDirection = RandomDirection();
+			}
+
+			const Elite::FVector2 edge0{ input.vertices[1].position - input.vertices[0].position };
+			const Elite::FVector2 edge1{ input.vertices[2].position - input.vertices[0].position };
+			if (Elite::Cross(edge1, edge0) < 0.f)
+				std::swap(input.vertices[1], input.vertices[2]);
+
+			const float minX = std::min(std::min(input.vertices[0].position.x, input.vertices[1].position.x), input.vertices[2].position.x);
+			const float minY = std::min(std::min(input.vertices[0].position.y, input.vertices[1].position.y), input.vertices[2].position.y);
+			const float maxX = std::max(std::max(input.vertices[0].position.x, input.vertices[1].position.x), input.vertices[2].position.x);
+			const float maxY = std::max(std::max(input.vertices[0].position.y, input.vertices[1].position.y), input.vertices[2].position.y);
+			input.topLeft = Elite::FPoint2{ minX, minY };
+			input.step = Elite::FVector2{ (maxX - minX) / 4.f, (maxY - minY) / 4.f };
+			inputs.push_back(input);
+		}
+		return inputs;
+	}
+
+	//Grid of quads with positions, uvs & normals, written like the exporter of the bundled meshes writes them
+	bool WriteSyntheticOBJ(const std::string& filePath, uint32_t quadsPerSide)
+	{
+		std::ofstream file{ filePath };
+		if (!file)
+			return false;
+
+		const uint32_t verticesPerSide = quadsPerSide + 1;
+		file << "# Synthetic grid of " << quadsPerSide << "x" << quadsPerSide << " quads\n" << std::fixed << std::setprecision(4);
+		for (uint32_t y = 0; y < verticesPerSide; ++y)
+		{
+			for (uint32_t x = 0; x < verticesPerSide; ++x)
+				file << "v  " << float(x) * 0.5f << " " << Elite::RandomBinomial() << " " << float(y) * -0.5f << "\n";
+		}
+		for (uint32_t y = 0; y < verticesPerSide; ++y)
+		{
+			for (uint32_t x = 0; x < verticesPerSide; ++x)
+				file << "vt " << float(x) / float(quadsPerSide) << " " << float(y) / float(quadsPerSide) << " 0.0000\n";
+		}
+		for (uint32_t i = 0; i < verticesPerSide * verticesPerSide; ++i)
+		{
+			const Elite::FVector3 normal = RandomDirection();
+			file << "vn " << normal.x << " " << std::abs(normal.y) << " " << normal.z << "\n";
+		}
+		for (uint32_t y = 0; y < quadsPerSide; ++y)
+		{
+			for (uint32_t x = 0; x < quadsPerSide; ++x)
+			{
+				const uint32_t a = y * verticesPerSide + x + 1;
+				const uint32_t b = a + 1;
+				const uint32_t c = a + verticesPerSide;
+				const uint32_t d = c + 1;
+				file << "f " << a << "/" << a << "/" << a << " " << c << "/" << c << "/" << c << " " << b << "/" << b << "/" << b << "\n";
+				file << "f " << b << "/" << b << "/" << b << " " << c << "/" << c << "/" << c << " " << d << "/" << d << "/" << d << "\n";
+			}
+		}
+		return bool(file);
+	}
+
+	void ReportParseOBJ(MicrobenchRun& run, const std::string& name, const std::string& filePath)
+	{
+		if (!run.IsSelected(name))
+			return;
+
+		//Parsed once up front to know how many triangles a call produces
+		std::vector<Elite::Vertex_Input> vertices{};
+		std::vector<uint32_t> indices{};
+		if (!Elite::ParseOBJ(filePath, vertices, indices) || indices.empty())
+		{
+			std::cout << "Microbench: could not parse " << filePath << ", skipping " << name << "\n";
+			return;
+		}
+		ReportThroughput(run, name, uint32_t(indices.size() / 3), [&](uint32_t)
+		{
+			Elite::ParseOBJ(filePath, vertices, indices);
+			return float(vertices.size());
+		});
+	}
+}
+
+std::vector<Elite::MicrobenchResult> Elite::RunMicrobenchmarks(uint32_t iterations, const std::string& filter, float minimumSeconds)
+{
+	MicrobenchRun run{ filter, std::max(iterations, 1u), std::max(minimumSeconds, 0.01f), {} };
+
+	//Rigid transforms with a scale, like the world & clip matrices the renderer multiplies, so all of them can be inverted
+	SetRandomSeed(0);
+	std::vector<FMatrix4> matrices{};
+	std::vector<FPoint4> points{};
+	std::vector<FVector4> vectors{};
+	for (uint32_t i = 0; i < AmountOfInputs; ++i)
+	{
+		FMatrix4 matrix = FMatrix4(MakeRotationY(RandomFloat(float(E_PI_2))), FVector3{ RandomBinomial(50.f), RandomBinomial(50.f), RandomBinomial(50.f) });
+		matrix *= 0.5f + RandomFloat();
+		matrix(3, 3) = 1.f;
+		matrices.push_back(matrix);
+		points.push_back(FPoint4{ RandomBinomial(10.f), RandomBinomial(10.f), RandomBinomial(10.f), 1.f });
+		vectors.push_back(FVector4{ RandomBinomial(), RandomBinomial(), RandomBinomial(), RandomBinomial() });
+	}
+
+#ifndef ELITE_SSE2
+	std::cout << "Microbench: SSE2 is not available, both columns run the scalar code\n";
+#endif
+	std::cout << "Microbench: " << run.iterations << " iteration(s) per SIMD operation, kernels run for at least " << run.minimumSeconds << "s\n";
+
+	Report(run, "Matrix4 * Matrix4",
+		[&](uint32_t i) { return Sum(ScalarMultiply(matrices[i], matrices[(i + 1) % AmountOfInputs])); },
+		[&](uint32_t i) { return Sum(matrices[i] * matrices[(i + 1) % AmountOfInputs]); });
+
+	Report(run, "Matrix4 * Point4",
+		[&](uint32_t i) { return Sum(ScalarTransform(matrices[i], points[i])); },
+		[&](uint32_t i) { return Sum(matrices[i] * points[i]); });
+
+	Report(run, "Matrix4 * Vector4",
+		[&](uint32_t i) { return Sum(ScalarTransform(matrices[i], vectors[i])); },
+		[&](uint32_t i) { return Sum(matrices[i] * vectors[i]); });
+
+	Report(run, "Inverse",
+		[&](uint32_t i) { return Sum(Inverse<float>(matrices[i])); },
+		[&](uint32_t i) { return Sum(Inverse(matrices[i])); });
+
+	Report(run, "Dot Vector4",
+		[&](uint32_t i) { return Dot<float>(vectors[i], vectors[(i + 1) % AmountOfInputs]); },
+		[&](uint32_t i) { return Dot(vectors[i], vectors[(i + 1) % AmountOfInputs]); });
+
+	//Kernels of the software rasterizer on their own, with the inputs they get while drawing the vehicle
+	std::vector<FVector3> directions{};
+	std::vector<FVector2> uvs{};
+	std::vector<Vertex_Input> pixels{};
+	for (uint32_t i = 0; i < AmountOfInputs; ++i)
+	{
+		directions.push_back(FVector3{ RandomBinomial(10.f), RandomBinomial(10.f), RandomBinomial(10.f) });
+		uvs.push_back(FVector2{ RandomFloat(0.9f), RandomFloat(0.99f) });
+		pixels.push_back(Vertex_Input{ FPoint4{}, uvs.back(), RandomDirection(), RandomDirection(), RandomDirection() });
+	}
+
+	ReportThroughput(run, "GetNormalized Vector3", 1, [&](uint32_t i)
+	{
+		const FVector3 normalized = GetNormalized(directions[i % AmountOfInputs]);
+		return normalized.x + normalized.y + normalized.z;
+	});
+
+	//A span of texels along a row like a triangle reads them, & texels all over the texture like a minified one
+	const Texture texture{ "Resources/vehicle_diffuse.png" };
+	const bool hasResources = (texture.GetWidth() > 0);
+	if (!hasResources)
+		std::cout << "Microbench: Resources/vehicle_diffuse.png is missing, skipping the texture, rasterizer & shading kernels\n";
+	if (hasResources)
+	{
+		const float texelWidth = 1.f / float(texture.GetWidth());
+		ReportThroughput(run, "Texture::Sample span", 16, [&](uint32_t i)
+		{
+			FVector2 uv = uvs[i % AmountOfInputs];
+			float sum = 0.f;
+			for (uint32_t t = 0; t < 16; ++t, uv.x += texelWidth)
+				sum += Sum(texture.Sample(uv));
+			return sum;
+		});
+
+		std::vector<FVector2> scatteredUvs{};
+		for (uint32_t i = 0; i < 4096; ++i)
+			scatteredUvs.push_back(FVector2{ RandomFloat(0.99f), RandomFloat(0.99f) });
+		ReportThroughput(run, "Texture::Sample scattered", 1, [&](uint32_t i)
+		{
+			return Sum(texture.Sample(scatteredUvs[i % scatteredUvs.size()]));
+		});
+	}
+
+	//The backend only loads its textures, no mesh is added
+	if (hasResources && (run.IsSelected("IsInTriangle") || run.IsSelected("PixelShading")))
+	{
+		const SoftwareBackend backend{ nullptr, 640, 480 };
+		const std::vector<RasterInput> smallTriangles = MakeRasterInputs(4.f);
+		const std::vector<RasterInput> largeTriangles = MakeRasterInputs(32.f);
+		auto testTriangle = [&backend](const RasterInput& input)
+		{
+			float sum = 0.f;
+			Vertex_Input pixel{};
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					pixel.position = FPoint4{ input.topLeft.x + (float(x) + 0.5f) * input.step.x, input.topLeft.y + (float(y) + 0.5f) * input.step.y, 0.f, 0.f };
+					if (backend.IsInTriangle(pixel, input.vertices, CullMode::back))
+						sum += pixel.position.z;
+				}
+			}
+			return sum;
+		};
+		ReportThroughput(run, "IsInTriangle 4px", 16, [&](uint32_t i) { return testTriangle(smallTriangles[i % AmountOfInputs]); });
+		ReportThroughput(run, "IsInTriangle 32px", 16, [&](uint32_t i) { return testTriangle(largeTriangles[i % AmountOfInputs]); });
+
+		const RGBColor tint{ 1.f, 1.f, 1.f };
+		ReportThroughput(run, "PixelShading", 1, [&](uint32_t i) { return Sum(backend.PixelShading(pixels[i % AmountOfInputs], tint)); });
+	}
+
+	//Every BRDF term with unit directions, the light & view on the side of the normal
+	auto getNormal = [&](uint32_t i) { return pixels[i % AmountOfInputs].normal; };
+	auto getView = [&](uint32_t i) { return GetNormalized(pixels[i % AmountOfInputs].normal + pixels[(i + 1) % AmountOfInputs].viewDirection * 0.5f); };
+	auto getLight = [&](uint32_t i) { return GetNormalized(pixels[i % AmountOfInputs].normal + pixels[(i + 2) % AmountOfInputs].tangent * 0.5f); };
+	std::vector<FVector3> normals{};
+	std::vector<FVector3> views{};
+	std::vector<FVector3> lights{};
+	std::vector<FVector3> halfVectors{};
+	for (uint32_t i = 0; i < AmountOfInputs; ++i)
+	{
+		normals.push_back(getNormal(i));
+		views.push_back(getView(i));
+		lights.push_back(getLight(i));
+		halfVectors.push_back(GetNormalized(views.back() + lights.back()));
+	}
+	const RGBColor albedo{ 0.8f, 0.4f, 0.2f };
+
+	ReportThroughput(run, "BRDF::Lambert", 1, [&](uint32_t i) { return Sum(BRDF::Lambert(albedo, normals[i % AmountOfInputs].y)); });
+	ReportThroughput(run, "BRDF::Phong", 1, [&](uint32_t i)
+	{
+		const uint32_t index = i % AmountOfInputs;
+		return Sum(BRDF::Phong(albedo, 25.f, -lights[index], views[index], normals[index]));
+	});
+	ReportThroughput(run, "BRDF::NormalD", 1, [&](uint32_t i) { return BRDF::NormalD(normals[i % AmountOfInputs], halfVectors[i % AmountOfInputs], 0.25f); });
+	ReportThroughput(run, "BRDF::Fresnel", 1, [&](uint32_t i) { return Sum(BRDF::Fresnel(halfVectors[i % AmountOfInputs], views[i % AmountOfInputs])); });
+	ReportThroughput(run, "BRDF::Geometry", 1, [&](uint32_t i) { return BRDF::Geometry(normals[i % AmountOfInputs], views[i % AmountOfInputs], 0.25f); });
+	ReportThroughput(run, "BRDF::cookTorrence", 1, [&](uint32_t i)
+	{
+		const uint32_t index = i % AmountOfInputs;
+		return Sum(BRDF::cookTorrence(normals[index], halfVectors[index], views[index], lights[index], 0.25f));
+	});
+
+	//Throughput in parsed triangles, the generated file is written next to the executable & removed again
+	ReportParseOBJ(run, "ParseOBJ fireFX", "Resources/fireFX.obj");
+	ReportParseOBJ(run, "ParseOBJ tuktuk", "Resources/tuktuk.obj");
+	ReportParseOBJ(run, "ParseOBJ vehicle", "Resources/vehicle.obj");
+	if (run.IsSelected("ParseOBJ synthetic"))
+	{
+		const std::string syntheticPath = "microbench_synthetic.obj";
+		if (WriteSyntheticOBJ(syntheticPath, SyntheticOBJQuads))
+			ReportParseOBJ(run, "ParseOBJ synthetic", syntheticPath);
+		else
+			std::cout << "Microbench: could not write " << syntheticPath << ", skipping ParseOBJ synthetic\n";
+		std::remove(syntheticPath.c_str());
+	}
+	return run.results;
+}
+
+bool Elite::WriteMicrobenchResults(const std::string& filePath, const std::vector<MicrobenchResult>& results)
+{
+	std::ofstream file{ filePath };
+	if (!file)
+	{
+		std::cout << "Microbench: could not write " << filePath << "\n";
+		return false;
+	}
+
+	file << "operation,items_per_second\n" << std::fixed << std::setprecision(1);
+	for (const MicrobenchResult& result : results)
+		file << result.name << ',' << result.itemsPerSecond << '\n';
+	std::cout << "Microbench: wrote " << results.size() << " operation(s) to " << filePath << "\n";
+	return bool(file);
+}
+
+bool Elite::ReadMicrobenchResults(const std::string& filePath, std::vector<MicrobenchResult>& results)
+{
+	std::ifstream file{ filePath };
+	std::string line{};
+	if (!file || !std::getline(file, line) || line != "operation,items_per_second")
+	{
+		std::cout << "Microbench: " << filePath << " is not a microbenchmark result\n";
+		return false;
+	}
+
+	results.clear();
+	while (std::getline(file, line))
+	{
+		const size_t comma = line.rfind(',');
+		if (comma != std::string::npos)
+			results.push_back({ line.substr(0, comma), std::atof(line.c_str() + comma + 1) });
+	}
+	return true;
+}
+
+bool Elite::CompareMicrobenchResults(const std::vector<MicrobenchResult>& baseline, const std::vector<MicrobenchResult>& results, float threshold, std::ostream& stream)
+{
+	uint32_t amountOfRegressions = 0;
+	for (const MicrobenchResult& result : results)
+	{
+		const auto baselineResult = std::find_if(baseline.begin(), baseline.end(), [&result](const MicrobenchResult& other) { return other.name == result.name; });
+		if (baselineResult == baseline.end() || baselineResult->itemsPerSecond <= 0.0)
+		{
+			stream << "Compare: " << result.name << " is not in the baseline\n";
+			continue;
+		}
+
+		const double ratio = result.itemsPerSecond / baselineResult->itemsPerSecond;
+		const char* pVerdict = "";
+		if (ratio < 1.0 - threshold)
+		{
+			pVerdict = " REGRESSION";
+			++amountOfRegressions;
+		}
+		else if (ratio > 1.0 + threshold)
+			pVerdict = " faster";
+
+		std::ostringstream line{};
+		line << std::fixed << std::setprecision(2) << baselineResult->itemsPerSecond / 1e6 << " -> " << result.itemsPerSecond / 1e6
+			<< " M items/s (" << std::showpos << (ratio - 1.0) * 100.0 << "%)";
+		stream << "Compare: " << std::left << std::setw(26) << result.name << std::right << " " << line.str() << pVerdict << "\n";
+	}
+
+	stream << "Compare: " << amountOfRegressions << " operation(s) lost more than " << threshold * 100.f << "% of their throughput\n";
+	return amountOfRegressions == 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Elite
+{
+	//Throughput of one timed operation, an item is what one call works on (a matrix, a pixel, a parsed triangle)
+	struct MicrobenchResult
+	{
+		std::string name;
+		double itemsPerSecond;
+	};
+
+	//Times the math that runs per vertex & per instance against the plain scalar code, every line prints both & the speedup
+	//Without SSE2 both sides run the scalar templates
+	//Then the per pixel kernels of the software rasterizer & the OBJ parser, each for at least minimumSeconds, the fastest of several rounds counts
+	//Only operations whose name contains filter run, textures & meshes are read from Resources
+	std::vector<MicrobenchResult> RunMicrobenchmarks(uint32_t iterations, const std::string& filter, float minimumSeconds);
+
+	//One row per operation, so the results of different builds can be compared
+	bool WriteMicrobenchResults(const std::string& filePath, const std::vector<MicrobenchResult>& results);
+	bool ReadMicrobenchResults(const std::string& filePath, std::vector<MicrobenchResult>& results);
+	//Prints the change of every operation both ran, returns false when one lost more than threshold (a fraction) of its throughput
+	bool CompareMicrobenchResults(const std::vector<MicrobenchResult>& baseline, const std::vector<MicrobenchResult>& results, float threshold, std::ostream& stream);
+}
@@ -0,0 +1,271 @@
+#include "pch.h"
+#include "OcclusionBuffer.h"
+
+Elite::OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+	: m_Width{ 0 }
+	, m_Height{ 0 }
+	, m_TilesX{ 0 }
+	, m_TilesY{ 0 }
+	, m_Tiles{}
+	, m_ScreenVertices{}
+{
+	Resize(width, height);
+}
+
+void Elite::OcclusionBuffer::Resize(uint32_t width, uint32_t height)
+{
+	m_TilesX = (width + TileWidth - 1) / TileWidth;
+	m_TilesY = (height + BlockHeight - 1) / BlockHeight;
+	m_Width = m_TilesX * TileWidth;
+	m_Height = m_TilesY * BlockHeight;
+	m_Tiles.resize(size_t(m_TilesX) * m_TilesY);
+	Clear();
+}
+
+void Elite::OcclusionBuffer::Clear()
+{
+	for (Tile& tile : m_Tiles)
+	{
+		for (uint32_t block = 0; block < 4; ++block)
+		{
+			tile.masks[block] = 0;
+			tile.farDepths[block] = 1.f;
+			tile.layerDepths[block] = 0.f;
+		}
+	}
+}
+
+void Elite::OcclusionBuffer::RenderOccluder(const Occluder& occluder, const FMatrix4& modelToClip)
+{
+	if (m_Tiles.empty())
+		return;
+
+	FMatrix4 clipMatrix = modelToClip;
+	const FPoint3 camera = GetClipOrigin(modelToClip);
+
+	//Vertices pushed away from the camera by the error of the occluder, w is 0 for vertices behind the camera or near plane
+	m_ScreenVertices.resize(occluder.positions.size());
+	for (size_t i = 0; i < occluder.positions.size(); ++i)
+	{
+		FPoint3 position = occluder.positions[i];
+		const FVector3 toVertex{ position - camera };
+		if (Magnitude(toVertex) > 0.f)
+			position += GetNormalized(toVertex) * occluder.error;
+
+		const FPoint4 clip = clipMatrix * FPoint4{ position.x, position.y, position.z, 1.f };
+		if (clip.w <= 0.f || clip.z < 0.f)
+		{
+			m_ScreenVertices[i] = FPoint4{ 0.f, 0.f, 0.f, 0.f };
+			continue;
+		}
+		m_ScreenVertices[i] = FPoint4{ (clip.x / clip.w + 1.f) * 0.5f * float(m_Width), (1.f - clip.y / clip.w) * 0.5f * float(m_Height), clip.z / clip.w, 1.f };
+	}
+
+	for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+	{
+		const FPoint4& v0 = m_ScreenVertices[occluder.indices[i]];
+		const FPoint4& v1 = m_ScreenVertices[occluder.indices[i + 1]];
+		const FPoint4& v2 = m_ScreenVertices[occluder.indices[i + 2]];
+
+		//Triangles crossing the near plane are left out, an occluder may only ever hide too little
+		if (v0.w == 0.f || v1.w == 0.f || v2.w == 0.f)
+			continue;
+
+		//Front faces wind clockwise on screen, y points down
+		const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if (area >= 0.f)
+			continue;
+
+		RenderTriangle(v0.xyz, v1.xyz, v2.xyz);
+	}
+}
+
+void Elite::OcclusionBuffer::RenderTriangle(const FPoint3& v0, const FPoint3& v1, const FPoint3& v2)
+{
+	//Pixel bounding box, in tiles
+	const float minX = std::min(v0.x, std::min(v1.x, v2.x));
+	const float maxX = std::max(v0.x, std::max(v1.x, v2.x));
+	const float minY = std::min(v0.y, std::min(v1.y, v2.y));
+	const float maxY = std::max(v0.y, std::max(v1.y, v2.y));
+	if (maxX < 0.f || maxY < 0.f || minX >= float(m_Width) || minY >= float(m_Height))
+		return;
+
+	const uint32_t firstTileX = uint32_t(std::max(minX, 0.f)) / TileWidth;
+	const uint32_t lastTileX = uint32_t(std::min(maxX, float(m_Width - 1))) / TileWidth;
+	const uint32_t firstTileY = uint32_t(std::max(minY, 0.f)) / BlockHeight;
+	const uint32_t lastTileY = uint32_t(std::min(maxY, float(m_Height - 1))) / BlockHeight;
+
+	//Edge functions a * x + b * y + c, positive inside the triangle
+	const FPoint3* pVertices[3]{ &v0, &v1, &v2 };
+	float a[3]{}, b[3]{}, c[3]{};
+	for (uint32_t e = 0; e < 3; ++e)
+	{
+		const FPoint3& from = *pVertices[e];
+		const FPoint3& to = *pVertices[(e + 1) % 3];
+		a[e] = to.y - from.y;
+		b[e] = from.x - to.x;
+		c[e] = -(a[e] * from.x + b[e] * from.y);
+	}
+
+	//Depth plane, the furthest depth of a block is its center depth plus the slope to its corners
+	//It never has to be further than the furthest vertex
+	const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+	const float dzdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+	const float dzdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+	const float blockSlope = std::abs(dzdx) * float(BlockWidth) * 0.5f + std::abs(dzdy) * float(BlockHeight) * 0.5f;
+	const float maxZ = std::max(v0.z, std::max(v1.z, v2.z));
+
+	for (uint32_t tileY = firstTileY; tileY <= lastTileY; ++tileY)
+	{
+		for (uint32_t tileX = firstTileX; tileX <= lastTileX; ++tileX)
+		{
+			Tile& tile = m_Tiles[tileY * m_TilesX + tileX];
+			const float tileLeft = float(tileX * TileWidth);
+			const float tileTop = float(tileY * BlockHeight);
+
+#ifdef ELITE_SSE2
+			//One block per lane, every pixel of a row of the blocks at once
+			const __m128 blockOffsets = _mm_setr_ps(0.f, float(BlockWidth), float(BlockWidth * 2), float(BlockWidth * 3));
+			const __m128 pixelX = _mm_add_ps(_mm_set1_ps(tileLeft + 0.5f), blockOffsets);
+			__m128 rowEdges[3]{};
+			for (uint32_t e = 0; e < 3; ++e)
+				rowEdges[e] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[e]), pixelX), _mm_set1_ps(b[e] * (tileTop + 0.5f) + c[e]));
+
+			const __m128 zero = _mm_setzero_ps();
+			__m128i coverage = _mm_setzero_si128();
+			for (uint32_t y = 0; y < BlockHeight; ++y)
+			{
+				__m128 edges[3]{ rowEdges[0], rowEdges[1], rowEdges[2] };
+				for (uint32_t x = 0; x < BlockWidth; ++x)
+				{
+					const __m128 isInside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edges[0], zero), _mm_cmpge_ps(edges[1], zero)), _mm_cmpge_ps(edges[2], zero));
+					coverage = _mm_or_si128(coverage, _mm_and_si128(_mm_castps_si128(isInside), _mm_set1_epi32(int(1u << (y * BlockWidth + x)))));
+					for (uint32_t e = 0; e < 3; ++e)
+						edges[e] = _mm_add_ps(edges[e], _mm_set1_ps(a[e]));
+				}
+				for (uint32_t e = 0; e < 3; ++e)
+					rowEdges[e] = _mm_add_ps(rowEdges[e], _mm_set1_ps(b[e]));
+			}
+
+			const __m128i isCovered = _mm_xor_si128(_mm_cmpeq_epi32(coverage, _mm_setzero_si128()), _mm_set1_epi32(-1));
+			if (_mm_movemask_epi8(isCovered) == 0)
+				continue;
+
+			const __m128 blockCenterX = _mm_add_ps(_mm_set1_ps(tileLeft + float(BlockWidth) * 0.5f - v0.x), blockOffsets);
+			__m128 depth = _mm_add_ps(_mm_mul_ps(blockCenterX, _mm_set1_ps(dzdx)), _mm_set1_ps(v0.z + dzdy * (tileTop + float(BlockHeight) * 0.5f - v0.y) + blockSlope));
+			depth = _mm_min_ps(depth, _mm_set1_ps(maxZ));
+
+			__m128i masks = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tile.masks));
+			__m128 farDepths = _mm_loadu_ps(tile.farDepths);
+			__m128 layerDepths = _mm_loadu_ps(tile.layerDepths);
+			depth = _mm_min_ps(depth, farDepths);
+
+			//A triangle much further than the layer starts a new one, the layer would otherwise only ever move back
+			const __m128 isEmpty = _mm_castsi128_ps(_mm_cmpeq_epi32(masks, _mm_setzero_si128()));
+			const __m128 isDiscarded = _mm_cmpgt_ps(_mm_sub_ps(depth, layerDepths), _mm_sub_ps(farDepths, depth));
+			const __m128 isNewLayer = _mm_or_ps(isEmpty, isDiscarded);
+			const __m128 newLayerDepths = _mm_or_ps(_mm_and_ps(isNewLayer, depth), _mm_andnot_ps(isNewLayer, _mm_max_ps(layerDepths, depth)));
+			const __m128i newMasks = _mm_or_si128(coverage, _mm_andnot_si128(_mm_castps_si128(isNewLayer), masks));
+
+			layerDepths = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(isCovered), newLayerDepths), _mm_andnot_ps(_mm_castsi128_ps(isCovered), layerDepths));
+			masks = _mm_or_si128(_mm_and_si128(isCovered, newMasks), _mm_andnot_si128(isCovered, masks));
+
+			//Full layers become the depth of the whole block
+			const __m128i isFull = _mm_cmpeq_epi32(masks, _mm_set1_epi32(-1));
+			farDepths = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(isFull), _mm_min_ps(farDepths, layerDepths)), _mm_andnot_ps(_mm_castsi128_ps(isFull), farDepths));
+			masks = _mm_andnot_si128(isFull, masks);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(tile.masks), masks);
+			_mm_storeu_ps(tile.farDepths, farDepths);
+			_mm_storeu_ps(tile.layerDepths, layerDepths);
+#else
+			for (uint32_t block = 0; block < 4; ++block)
+			{
+				const float blockLeft = tileLeft + float(block * BlockWidth);
+				uint32_t coverage = 0;
+				for (uint32_t y = 0; y < BlockHeight; ++y)
+				{
+					for (uint32_t x = 0; x < BlockWidth; ++x)
+					{
+						const float pixelX = blockLeft + float(x) + 0.5f;
+						const float pixelY = tileTop + float(y) + 0.5f;
+						if (a[0] * pixelX + b[0] * pixelY + c[0] >= 0.f && a[1] * pixelX + b[1] * pixelY + c[1] >= 0.f && a[2] * pixelX + b[2] * pixelY + c[2] >= 0.f)
+							coverage |= 1u << (y * BlockWidth + x);
+					}
+				}
+				if (coverage == 0)
+					continue;
+
+				float depth = v0.z + dzdx * (blockLeft + float(BlockWidth) * 0.5f - v0.x) + dzdy * (tileTop + float(BlockHeight) * 0.5f - v0.y) + blockSlope;
+				depth = std::min(std::min(depth, maxZ), tile.farDepths[block]);
+
+				//A triangle much further than the layer starts a new one, the layer would otherwise only ever move back
+				if (tile.masks[block] == 0 || depth - tile.layerDepths[block] > tile.farDepths[block] - depth)
+				{
+					tile.masks[block] = coverage;
+					tile.layerDepths[block] = depth;
+				}
+				else
+				{
+					tile.masks[block] |= coverage;
+					tile.layerDepths[block] = std::max(tile.layerDepths[block], depth);
+				}
+
+				//Full layers become the depth of the whole block
+				if (tile.masks[block] == UINT32_MAX)
+				{
+					tile.farDepths[block] = std::min(tile.farDepths[block], tile.layerDepths[block]);
+					tile.masks[block] = 0;
+				}
+			}
+#endif
+		}
+	}
+}
+
+bool Elite::OcclusionBuffer::IsOccluded(const AABB& bounds, const FMatrix4& toClip) const
+{
+	if (m_Tiles.empty())
+		return false;
+
+	//Screen rectangle & closest depth of the corners
+	FMatrix4 clipMatrix = toClip;
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float closestDepth = FLT_MAX;
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		const FPoint4 position{ (corner & 1) ? bounds.max.x : bounds.min.x, (corner & 2) ? bounds.max.y : bounds.min.y, (corner & 4) ? bounds.max.z : bounds.min.z, 1.f };
+		const FPoint4 clip = clipMatrix * position;
+
+		//Boxes that reach behind the camera or near plane have no closed rectangle on screen
+		if (clip.w <= 0.f || clip.z < 0.f)
+			return false;
+
+		const float x = (clip.x / clip.w + 1.f) * 0.5f * float(m_Width);
+		const float y = (1.f - clip.y / clip.w) * 0.5f * float(m_Height);
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		closestDepth = std::min(closestDepth, clip.z / clip.w);
+	}
+
+	if (maxX < 0.f || maxY < 0.f || minX >= float(m_Width) || minY >= float(m_Height))
+		return false;
+
+	const uint32_t firstBlockX = uint32_t(std::max(minX, 0.f)) / BlockWidth;
+	const uint32_t lastBlockX = uint32_t(std::min(maxX, float(m_Width - 1))) / BlockWidth;
+	const uint32_t firstBlockY = uint32_t(std::max(minY, 0.f)) / BlockHeight;
+	const uint32_t lastBlockY = uint32_t(std::min(maxY, float(m_Height - 1))) / BlockHeight;
+
+	for (uint32_t blockY = firstBlockY; blockY <= lastBlockY; ++blockY)
+	{
+		for (uint32_t blockX = firstBlockX; blockX <= lastBlockX; ++blockX)
+		{
+			const Tile& tile = m_Tiles[blockY * m_TilesX + blockX / 4];
+			if (tile.farDepths[blockX % 4] >= closestDepth)
+				return false;
+		}
+	}
+	return true;
+}
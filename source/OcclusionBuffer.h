@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EMathUtilities.h"
+#include "Scene.h"
+
+namespace Elite
+{
+	//Positions of a coarse mesh that hides what is behind it
+	//The simplified surface can be up to error in front of the real one, so it is pushed back that far before it is drawn
+	struct Occluder
+	{
+		std::vector<FPoint3> positions;
+		std::vector<uint32_t> indices;
+		float error;
+	};
+
+	//Low resolution depth of a few occluders, objects behind them are culled on the CPU before any backend draws them
+	//Every block of 8x4 pixels keeps one far depth for all its pixels, plus a coverage mask & far depth of the triangles
+	//drawn since, which replace the block depth once they cover the whole block (masked occlusion culling)
+	class OcclusionBuffer final
+	{
+	public:
+		static const uint32_t BlockWidth = 8;
+		static const uint32_t BlockHeight = 4;
+		//Four blocks next to each other are rasterized at once
+		static const uint32_t TileWidth = BlockWidth * 4;
+
+		OcclusionBuffer(uint32_t width, uint32_t height);
+		~OcclusionBuffer() = default;
+
+		OcclusionBuffer(const OcclusionBuffer&) = delete;
+		OcclusionBuffer(OcclusionBuffer&&) noexcept = delete;
+		OcclusionBuffer& operator=(const OcclusionBuffer&) = delete;
+		OcclusionBuffer& operator=(OcclusionBuffer&&) noexcept = delete;
+
+		//Sizes are rounded up to whole tiles, the clip volume is stretched over all of them
+		void Resize(uint32_t width, uint32_t height);
+		void Clear();
+
+		//Draws the front faces of the occluder, modelToClip maps the visible volume to -w <= x, y <= w & 0 <= z <= w
+		void RenderOccluder(const Occluder& occluder, const FMatrix4& modelToClip);
+
+		//True when every pixel the box covers is behind the occluders drawn since the last clear
+		bool IsOccluded(const AABB& bounds, const FMatrix4& toClip) const;
+
+		uint32_t GetWidth() const { return m_Width; };
+		uint32_t GetHeight() const { return m_Height; };
+
+	private:
+		struct alignas(16) Tile
+		{
+			uint32_t masks[4];
+			//Every pixel of the block is at least this close
+			float farDepths[4];
+			//Every pixel in the mask is at least this close
+			float layerDepths[4];
+		};
+
+		//Vertices in pixels & depth, triangles have to be front facing & in front of the camera
+		void RenderTriangle(const FPoint3& v0, const FPoint3& v1, const FPoint3& v2);
+
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_TilesX;
+		uint32_t m_TilesY;
+		std::vector<Tile> m_Tiles;
+		std::vector<FPoint4> m_ScreenVertices;
+	};
+}
@@ -0,0 +1,244 @@
+#include "pch.h"
+#include "PackedVertex.h"
+#include <cstring>
+
+namespace
+{
+	const float UnormMax = 65535.f;
+	const float SnormMax = 32767.f;
+
+	uint32_t FloatBits(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	float BitsFloat(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	int16_t PackSnorm(float value)
+	{
+		return int16_t(std::round(Elite::Clamp(value, -1.f, 1.f) * SnormMax));
+	}
+
+	//Projects the unit sphere on an octahedron & unfolds it into a square, the lower half is folded over the diagonals
+	void PackOctahedral(const Elite::FVector3& v, int16_t out[2])
+	{
+		const float sum = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+		if (sum <= 0.f)
+		{
+			out[0] = 0;
+			out[1] = 0;
+			return;
+		}
+
+		float x = v.x / sum;
+		float y = v.y / sum;
+		if (v.z < 0.f)
+		{
+			const float foldedX = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+			const float foldedY = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+			x = foldedX;
+			y = foldedY;
+		}
+		out[0] = PackSnorm(x);
+		out[1] = PackSnorm(y);
+	}
+
+#ifndef ELITE_SSE2
+	float UnpackSnorm(int16_t value)
+	{
+		return std::max(float(value) / SnormMax, -1.f);
+	}
+
+	Elite::FVector3 UnpackOctahedral(const int16_t in[2])
+	{
+		Elite::FVector3 v{ UnpackSnorm(in[0]), UnpackSnorm(in[1]), 0.f };
+		v.z = 1.f - std::abs(v.x) - std::abs(v.y);
+		const float t = std::max(-v.z, 0.f);
+		v.x += v.x >= 0.f ? -t : t;
+		v.y += v.y >= 0.f ? -t : t;
+		Elite::Normalize(v);
+		return v;
+	}
+
+	void UnpackVertex(const Elite::PackedVertex& packed, const Elite::FVector3& positionScale, const Elite::FPoint3& positionOffset, Elite::Vertex_Input& out)
+	{
+		out.position = Elite::FPoint4{
+			positionOffset.x + float(packed.position[0]) * positionScale.x,
+			positionOffset.y + float(packed.position[1]) * positionScale.y,
+			positionOffset.z + float(packed.position[2]) * positionScale.z, 1.f };
+		out.uv = Elite::FVector2{ Elite::HalfToFloat(packed.uv[0]), Elite::HalfToFloat(packed.uv[1]) };
+		out.normal = UnpackOctahedral(packed.normal);
+		out.tangent = UnpackOctahedral(packed.tangent);
+	}
+#endif
+}
+
+uint16_t Elite::FloatToHalf(float value)
+{
+	//Rounds to nearest even, too big values become infinity & tiny values denormals
+	const uint32_t infinity = 255u << 23;
+	const uint32_t halfOverflow = (127u + 16u) << 23;
+	const uint32_t denormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+	uint32_t bits = FloatBits(value);
+	const uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint32_t half;
+	if (bits >= halfOverflow)
+		half = bits > infinity ? 0x7E00u : 0x7C00u;
+	else if (bits < (113u << 23))
+		half = FloatBits(BitsFloat(bits) + BitsFloat(denormalMagic)) - denormalMagic;
+	else
+	{
+		const uint32_t mantissaOdd = (bits >> 13) & 1u;
+		bits += (uint32_t(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+		half = bits >> 13;
+	}
+	return uint16_t(half | (sign >> 16));
+}
+
+float Elite::HalfToFloat(uint16_t value)
+{
+	const uint32_t shiftedExponent = 0x7C00u << 13;
+	uint32_t bits = (uint32_t(value) & 0x7FFFu) << 13;
+	const uint32_t exponent = bits & shiftedExponent;
+	bits += (127u - 15u) << 23;
+
+	float result;
+	if (exponent == shiftedExponent)
+		result = BitsFloat(bits + ((128u - 16u) << 23));
+	else if (exponent == 0)
+		result = BitsFloat(bits + (1u << 23)) - BitsFloat(113u << 23);
+	else
+		result = BitsFloat(bits);
+	return BitsFloat(FloatBits(result) | ((uint32_t(value) & 0x8000u) << 16));
+}
+
+Elite::PackedVertex Elite::PackVertex(const Vertex_Input& vertex, const VertexQuantization& quantization)
+{
+	PackedVertex packed{};
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		const float scale = quantization.scale[i];
+		const float unorm = scale > 0.f ? (vertex.position[i] - quantization.offset[i]) / scale : 0.f;
+		packed.position[i] = uint16_t(std::round(Clamp(unorm, 0.f, 1.f) * UnormMax));
+	}
+	packed.position[3] = uint16_t(UnormMax);
+	packed.uv[0] = FloatToHalf(vertex.uv.x);
+	packed.uv[1] = FloatToHalf(vertex.uv.y);
+	PackOctahedral(vertex.normal, packed.normal);
+	PackOctahedral(vertex.tangent, packed.tangent);
+	return packed;
+}
+
+Elite::PackedMesh Elite::PackMesh(const std::vector<MeshLOD>& lods)
+{
+	PackedMesh mesh{};
+
+	FPoint3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+	FPoint3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (const MeshLOD& lod : lods)
+	{
+		for (const Vertex_Input& vertex : lod.vertices)
+		{
+			for (uint8_t i = 0; i < 3; ++i)
+			{
+				min[i] = std::min(min[i], vertex.position[i]);
+				max[i] = std::max(max[i], vertex.position[i]);
+			}
+		}
+	}
+	if (min.x > max.x)
+		return mesh;
+
+	mesh.quantization.offset = min;
+	mesh.quantization.scale = max - min;
+
+	mesh.lods.reserve(lods.size());
+	for (const MeshLOD& lod : lods)
+	{
+		std::vector<PackedVertex> vertices{};
+		vertices.reserve(lod.vertices.size());
+		for (const Vertex_Input& vertex : lod.vertices)
+			vertices.push_back(PackVertex(vertex, mesh.quantization));
+		mesh.lods.push_back(std::move(vertices));
+	}
+	return mesh;
+}
+
+void Elite::UnpackVertices(const PackedVertex* pVertices, const VertexQuantization& quantization, const uint32_t* pIndices, uint32_t count, Vertex_Input* pOut)
+{
+	//The stored integers are scaled straight to model space, instead of to [0, 1] first
+	const FVector3 positionScale = quantization.scale / UnormMax;
+#ifdef ELITE_SSE2
+	const __m128 scale = _mm_setr_ps(positionScale.x, positionScale.y, positionScale.z, 0.f);
+	const __m128 offset = _mm_setr_ps(quantization.offset.x, quantization.offset.y, quantization.offset.z, 1.f);
+	const __m128i zero = _mm_setzero_si128();
+
+	//Halves are expanded in the lower bits of a float & rescaled, infinity & NaN get their exponent back
+	const __m128i halfNoSign = _mm_set1_epi32(0x7FFF);
+	const __m128 halfMagic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+	const __m128i halfInfNaN = _mm_set1_epi32(0x7BFF);
+	const __m128 floatInfNaN = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+	const __m128 invSnormMax = _mm_set1_ps(1.f / SnormMax);
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(int(0x80000000u)));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const PackedVertex& packed = pVertices[pIndices[i]];
+		Vertex_Input& out = pOut[i];
+
+		//Position, offset + unorm * scale with w ending up 1
+		const __m128i position = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed.position)), zero);
+		_mm_storeu_ps(out.position.data, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(position), scale), offset));
+
+		//Uv
+		int32_t uvBits;
+		std::memcpy(&uvBits, packed.uv, sizeof(uvBits));
+		const __m128i half = _mm_unpacklo_epi16(_mm_cvtsi32_si128(uvBits), zero);
+		const __m128i halfExponentMantissa = _mm_and_si128(half, halfNoSign);
+		const __m128i halfSign = _mm_slli_epi32(_mm_xor_si128(half, halfExponentMantissa), 16);
+		const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(halfExponentMantissa, 13)), halfMagic);
+		const __m128 infNaN = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(halfExponentMantissa, halfInfNaN)), floatInfNaN);
+		const __m128 uv = _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(halfSign), infNaN));
+		_mm_storel_pi(reinterpret_cast<__m64*>(out.uv.data), uv);
+
+		//Normal & tangent next to each other, lanes are nx ny tx ty
+		const __m128i octahedral16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed.normal));
+		const __m128i octahedral32 = _mm_srai_epi32(_mm_unpacklo_epi16(octahedral16, octahedral16), 16);
+		__m128 xy = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(octahedral32), invSnormMax), minusOne);
+
+		//z = 1 - |x| - |y| for both, the lower half of the octahedron is unfolded by moving x & y towards 0
+		const __m128 absXY = _mm_andnot_ps(signMask, xy);
+		__m128 z = _mm_sub_ps(one, _mm_add_ps(absXY, _mm_shuffle_ps(absXY, absXY, _MM_SHUFFLE(2, 3, 0, 1))));
+		const __m128 fold = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+		xy = _mm_sub_ps(xy, _mm_or_ps(fold, _mm_and_ps(xy, signMask)));
+
+		//Normalize both at once, zero vectors can not come out of an octahedron
+		const __m128 xySquared = _mm_mul_ps(xy, xy);
+		const __m128 sqrMagnitude = _mm_add_ps(_mm_add_ps(xySquared, _mm_shuffle_ps(xySquared, xySquared, _MM_SHUFFLE(2, 3, 0, 1))), _mm_mul_ps(z, z));
+		const __m128 invMagnitude = _mm_div_ps(one, _mm_sqrt_ps(sqrMagnitude));
+		xy = _mm_mul_ps(xy, invMagnitude);
+		z = _mm_mul_ps(z, invMagnitude);
+
+		_mm_storel_pi(reinterpret_cast<__m64*>(out.normal.data), xy);
+		_mm_store_ss(&out.normal.z, z);
+		_mm_storeh_pi(reinterpret_cast<__m64*>(out.tangent.data), xy);
+		_mm_store_ss(&out.tangent.z, _mm_movehl_ps(z, z));
+	}
+#else
+	for (uint32_t i = 0; i < count; ++i)
+		UnpackVertex(pVertices[pIndices[i]], positionScale, quantization.offset, pOut[i]);
+#endif
+}
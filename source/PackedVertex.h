@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EHelper.h"
+#include "MeshLOD.h"
+
+namespace Elite
+{
+	//Stored & uploaded vertex, 20 bytes instead of the 64 of a Vertex_Input
+	//Position: unorm16 inside the bounds of the mesh, w is always 1 so the GPU reads it as a point
+	//Uv: half floats
+	//Normal & tangent: snorm16 octahedral, the bitangent is Cross(tangent, normal) in both backends so no handedness is stored
+	struct PackedVertex
+	{
+		uint16_t position[4];
+		uint16_t uv[2];
+		int16_t normal[2];
+		int16_t tangent[2];
+	};
+	static_assert(sizeof(PackedVertex) == 20, "PackedVertex has to match the DirectX input layout");
+
+	//Maps the unorm16 positions back to model space, position = offset + unorm * scale
+	struct VertexQuantization
+	{
+		FPoint3 offset;
+		FVector3 scale;
+	};
+
+	//Every level of detail of a mesh, packed against the bounds of all of them
+	struct PackedMesh
+	{
+		VertexQuantization quantization;
+		std::vector<std::vector<PackedVertex>> lods;
+	};
+
+	PackedMesh PackMesh(const std::vector<MeshLOD>& lods);
+	PackedVertex PackVertex(const Vertex_Input& vertex, const VertexQuantization& quantization);
+
+	//Decodes the vertices at the given indices into out, the view direction is left untouched
+	void UnpackVertices(const PackedVertex* pVertices, const VertexQuantization& quantization, const uint32_t* pIndices, uint32_t count, Vertex_Input* pOut);
+
+	uint16_t FloatToHalf(float value);
+	float HalfToFloat(uint16_t value);
+}
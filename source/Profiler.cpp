@@ -0,0 +1,259 @@
+#include "pch.h"
+#ifdef ELITE_PROFILING
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	struct ProfileEvent
+	{
+		const char* pName;
+		uint64_t start;
+		uint32_t duration;
+		uint32_t depth;
+	};
+
+	struct OpenZone
+	{
+		const char* pName;
+		uint64_t start;
+	};
+
+	//Only the owning thread writes the events, readers copy them out & drop the ones that were overwritten meanwhile
+	struct ThreadRecord
+	{
+		std::vector<ProfileEvent> events;
+		std::atomic<uint64_t> amountWritten;
+		std::atomic<bool> isInUse;
+		uint32_t id;
+		uint32_t depth;
+		OpenZone openZones[Elite::MaxProfileDepth];
+		std::string name;
+	};
+
+	std::mutex g_Mutex;
+	std::vector<ThreadRecord*> g_pRecords;
+
+	thread_local ThreadRecord* t_pRecord = nullptr;
+
+	//Hands the buffer back once its thread exits
+	struct RecordRelease
+	{
+		~RecordRelease()
+		{
+			if (t_pRecord)
+				t_pRecord->isInUse.store(false, std::memory_order_release);
+		}
+	};
+	thread_local RecordRelease t_RecordRelease;
+
+	uint64_t GetTime()
+	{
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	ThreadRecord& GetRecord()
+	{
+		if (t_pRecord)
+			return *t_pRecord;
+
+		std::lock_guard<std::mutex> lock{ g_Mutex };
+		for (ThreadRecord* pRecord : g_pRecords)
+		{
+			bool isInUse = false;
+			if (pRecord->isInUse.compare_exchange_strong(isInUse, true))
+			{
+				t_pRecord = pRecord;
+				break;
+			}
+		}
+		if (!t_pRecord)
+		{
+			ThreadRecord* pRecord = new ThreadRecord{};
+			pRecord->events.resize(Elite::ProfileEventsPerThread);
+			pRecord->amountWritten.store(0);
+			pRecord->isInUse.store(true);
+			pRecord->id = uint32_t(g_pRecords.size()) + 1;
+			g_pRecords.push_back(pRecord);
+			t_pRecord = pRecord;
+		}
+
+		t_pRecord->depth = 0;
+		t_pRecord->name = "Thread " + std::to_string(t_pRecord->id);
+		(void)&t_RecordRelease;
+		return *t_pRecord;
+	}
+
+	//The events that are still in the ring buffer, oldest first
+	std::vector<ProfileEvent> CopyEvents(const ThreadRecord& record)
+	{
+		const uint64_t capacity = Elite::ProfileEventsPerThread;
+		const uint64_t amountWritten = record.amountWritten.load(std::memory_order_acquire);
+		const uint64_t first = (amountWritten > capacity) ? amountWritten - capacity : 0;
+
+		std::vector<ProfileEvent> events{};
+		events.reserve(size_t(amountWritten - first));
+		for (uint64_t i = first; i < amountWritten; ++i)
+			events.push_back(record.events[size_t(i % capacity)]);
+
+		//Events the thread wrapped around to while copying are not valid anymore
+		//Neither is the slot of the event it may be writing right now, the next one after amountWrittenAfter
+		const uint64_t amountWrittenAfter = record.amountWritten.load(std::memory_order_acquire);
+		const uint64_t firstValid = (amountWrittenAfter + 1 > capacity) ? amountWrittenAfter + 1 - capacity : 0;
+		if (firstValid > first)
+			events.erase(events.begin(), events.begin() + size_t(std::min(firstValid - first, uint64_t(events.size()))));
+		return events;
+	}
+
+}
+
+void Elite::BeginProfileZone(const char* pName)
+{
+	ThreadRecord& record = GetRecord();
+	if (record.depth < MaxProfileDepth)
+		record.openZones[record.depth] = OpenZone{ pName, GetTime() };
+	++record.depth;
+}
+
+void Elite::EndProfileZone()
+{
+	const uint64_t end = GetTime();
+	ThreadRecord& record = *t_pRecord;
+	--record.depth;
+	if (record.depth >= MaxProfileDepth)
+		return;
+
+	const OpenZone& zone = record.openZones[record.depth];
+	const uint64_t index = record.amountWritten.load(std::memory_order_relaxed);
+	record.events[size_t(index % ProfileEventsPerThread)] = ProfileEvent{ zone.pName, zone.start, uint32_t(std::min(end - zone.start, uint64_t(UINT32_MAX))), record.depth };
+	record.amountWritten.store(index + 1, std::memory_order_release);
+}
+
+void Elite::SetProfileThreadName(const std::string& name)
+{
+	ThreadRecord& record = GetRecord();
+	std::lock_guard<std::mutex> lock{ g_Mutex };
+	record.name = name;
+}
+
+bool Elite::WriteProfileTrace(const std::string& filePath)
+{
+	std::ofstream file{ filePath };
+	if (!file)
+	{
+		std::cout << "Profiler: could not write " << filePath << "\n";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{ g_Mutex };
+	std::vector<std::vector<ProfileEvent>> events{};
+	uint64_t origin = UINT64_MAX;
+	for (const ThreadRecord* pRecord : g_pRecords)
+	{
+		events.push_back(CopyEvents(*pRecord));
+		for (const ProfileEvent& event : events.back())
+			origin = std::min(origin, event.start);
+	}
+
+	//Complete events in microseconds from the first recorded zone, one track per thread
+	size_t amountOfEvents = 0;
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t t = 0; t < g_pRecords.size(); ++t)
+	{
+		const ThreadRecord& record = *g_pRecords[t];
+		file << (t == 0 ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << record.id << ",\"args\":{\"name\":";
+		WriteJsonString(file, record.name);
+		file << "}}";
+
+		file << std::fixed << std::setprecision(3);
+		for (const ProfileEvent& event : events[t])
+		{
+			file << ",\n{\"name\":";
+			WriteJsonString(file, event.pName);
+			file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << record.id
+				<< ",\"ts\":" << double(event.start - origin) / 1000.0 << ",\"dur\":" << double(event.duration) / 1000.0 << "}";
+		}
+		amountOfEvents += events[t].size();
+	}
+	file << "\n]}\n";
+
+	std::cout << "Profiler: wrote " << amountOfEvents << " zone(s) of " << g_pRecords.size() << " thread(s) to " << filePath << "\n";
+	return bool(file);
+}
+
+std::vector<Elite::ProfileZoneStatistics> Elite::GetProfileStatistics()
+{
+	std::map<std::string, ProfileZoneStatistics> statistics{};
+	{
+		std::lock_guard<std::mutex> lock{ g_Mutex };
+		for (const ThreadRecord* pRecord : g_pRecords)
+		{
+			//Parents start before their children & at a lower depth, so sorting by start puts every parent on the stack before its children
+			std::vector<ProfileEvent> events = CopyEvents(*pRecord);
+			std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+			{
+				return (a.start != b.start) ? a.start < b.start : a.depth < b.depth;
+			});
+
+			std::vector<uint64_t> childTimes(events.size(), 0);
+			std::vector<size_t> parents{};
+			for (size_t i = 0; i < events.size(); ++i)
+			{
+				while (!parents.empty() && events[parents.back()].depth >= events[i].depth)
+					parents.pop_back();
+				if (!parents.empty())
+					childTimes[parents.back()] += events[i].duration;
+				parents.push_back(i);
+			}
+
+			for (size_t i = 0; i < events.size(); ++i)
+			{
+				const uint64_t duration = events[i].duration;
+				auto result = statistics.insert({ events[i].pName, ProfileZoneStatistics{ events[i].pName, 0, 0, 0, UINT64_MAX, 0 } });
+				ProfileZoneStatistics& zone = result.first->second;
+				++zone.count;
+				zone.total += duration;
+				zone.self += duration - std::min(duration, childTimes[i]);
+				zone.min = std::min(zone.min, duration);
+				zone.max = std::max(zone.max, duration);
+			}
+		}
+	}
+
+	std::vector<ProfileZoneStatistics> sorted{};
+	for (const std::pair<const std::string, ProfileZoneStatistics>& zone : statistics)
+		sorted.push_back(zone.second);
+	std::sort(sorted.begin(), sorted.end(), [](const ProfileZoneStatistics& a, const ProfileZoneStatistics& b)
+	{
+		return a.self > b.self;
+	});
+	return sorted;
+}
+
+void Elite::PrintProfileStatistics(std::ostream& stream)
+{
+	const std::vector<ProfileZoneStatistics> statistics = GetProfileStatistics();
+	stream << "Profiler: " << std::left << std::setw(28) << "zone" << std::right << std::setw(10) << "count" << std::setw(12) << "total ms"
+		<< std::setw(12) << "self ms" << std::setw(10) << "avg us" << std::setw(10) << "min us" << std::setw(10) << "max us" << "\n";
+	stream << std::fixed << std::setprecision(2);
+	for (const ProfileZoneStatistics& s : statistics)
+	{
+		stream << "Profiler: " << std::left << std::setw(28) << s.name << std::right << std::setw(10) << s.count
+			<< std::setw(12) << double(s.total) / 1e6 << std::setw(12) << double(s.self) / 1e6
+			<< std::setw(10) << double(s.total) / double(s.count) / 1e3 << std::setw(10) << double(s.min) / 1e3 << std::setw(10) << double(s.max) / 1e3 << "\n";
+	}
+}
+
+void Elite::ClearProfile()
+{
+	std::lock_guard<std::mutex> lock{ g_Mutex };
+	for (ThreadRecord* pRecord : g_pRecords)
+		pRecord->amountWritten.store(0, std::memory_order_release);
+}
+#endif
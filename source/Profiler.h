@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//Scoped CPU zones, they only exist when ELITE_PROFILING is defined (the Profile configuration) & compile to nothing otherwise
+#ifdef ELITE_PROFILING
+	#define ELITE_PROFILE_JOIN_INNER(a, b) a##b
+	#define ELITE_PROFILE_JOIN(a, b) ELITE_PROFILE_JOIN_INNER(a, b)
+	//Times the rest of the enclosing scope, the name has to be a string literal
+	#define ELITE_PROFILE_SCOPE(name) const Elite::ProfileZone ELITE_PROFILE_JOIN(profileZone, __LINE__){ name }
+	#define ELITE_PROFILE_THREAD(name) Elite::SetProfileThreadName(name)
+#else
+	#define ELITE_PROFILE_SCOPE(name)
+	#define ELITE_PROFILE_THREAD(name)
+#endif
+
+#ifdef ELITE_PROFILING
+namespace Elite
+{
+	//Every thread records finished zones into its own ring buffer, only the oldest zones are lost when it is full
+	//Nothing is locked while recording, a thread only takes a lock the first time it records
+	//Buffers of finished threads are reused by the next thread that starts recording
+	static const uint32_t ProfileEventsPerThread = 1 << 18;
+	static const uint32_t MaxProfileDepth = 64;
+
+	void BeginProfileZone(const char* pName);
+	void EndProfileZone();
+	//Name of the calling thread's track in the trace
+	void SetProfileThreadName(const std::string& name);
+
+	//Times of every zone with the same name in nanoseconds, total includes the zones inside it & self does not
+	struct ProfileZoneStatistics
+	{
+		std::string name;
+		uint64_t count;
+		uint64_t total;
+		uint64_t self;
+		uint64_t min;
+		uint64_t max;
+	};
+
+	//Writes the recorded zones of every thread as Chrome trace JSON, for chrome://tracing or Perfetto
+	bool WriteProfileTrace(const std::string& filePath);
+	//Every zone name that was recorded, sorted by self time
+	std::vector<ProfileZoneStatistics> GetProfileStatistics();
+	void PrintProfileStatistics(std::ostream& stream);
+	//Forgets every recorded zone, no other thread may be recording at the same time
+	void ClearProfile();
+
+	class ProfileZone final
+	{
+	public:
+		explicit ProfileZone(const char* pName) { BeginProfileZone(pName); };
+		~ProfileZone() { EndProfileZone(); };
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone(ProfileZone&&) noexcept = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+		ProfileZone& operator=(ProfileZone&&) noexcept = delete;
+	};
+}
+#endif
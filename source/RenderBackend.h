@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EHelper.h"
+#include "MeshLOD.h"
+
+namespace Elite
+{
+	class Camera;
+
+	//Geometry loaded once by the renderer, every backend uploads it in its own format
+	//Level 0 is the full mesh, every next level has about half the triangles
+	struct MeshData
+	{
+		std::vector<MeshLOD> lods;
+		bool isTransparent;
+	};
+
+	//One copy of a mesh, placed relative to the world matrix of the pipeline state
+	struct InstanceData
+	{
+		FMatrix4 world;
+		RGBColor tint;
+		uint32_t lod;
+	};
+
+	//State the renderer hands to the active backend every frame
+	struct PipelineState
+	{
+		FMatrix4 world;
+		//Every mesh is drawn once per instance, there is always at least one
+		std::vector<InstanceData> instances;
+		Filtering filter;
+		CullMode cull;
+		bool renderTransparent;
+	};
+
+	//Camera position in the space toClip transforms from, the point the x, y & w rows all map to 0
+	//That is the 4D cross product of those rows, so no inverse of a possibly singular clip matrix is needed
+	inline FPoint3 GetClipOrigin(const FMatrix4& toClip)
+	{
+		float rows[3][4]{};
+		for (uint8_t c = 0; c < 4; ++c)
+		{
+			rows[0][c] = toClip[c][0];
+			rows[1][c] = toClip[c][1];
+			rows[2][c] = toClip[c][3];
+		}
+		auto minor = [&rows](uint8_t a, uint8_t b, uint8_t c)
+		{
+			return rows[0][a] * (rows[1][b] * rows[2][c] - rows[1][c] * rows[2][b])
+				- rows[0][b] * (rows[1][a] * rows[2][c] - rows[1][c] * rows[2][a])
+				+ rows[0][c] * (rows[1][a] * rows[2][b] - rows[1][b] * rows[2][a]);
+		};
+		const float w = -minor(0, 1, 2);
+		return FPoint3{ minor(1, 2, 3) / w, -minor(0, 2, 3) / w, minor(0, 1, 3) / w };
+	}
+
+	//Device, meshes, textures & presenting of one way of rendering the scene
+	class RenderBackend
+	{
+	public:
+		RenderBackend() = default;
+		virtual ~RenderBackend() = default;
+
+		RenderBackend(const RenderBackend&) = delete;
+		RenderBackend(RenderBackend&&) noexcept = delete;
+		RenderBackend& operator=(const RenderBackend&) = delete;
+		RenderBackend& operator=(RenderBackend&&) noexcept = delete;
+
+		virtual void AddMesh(const MeshData& mesh) = 0;
+		virtual void SetCamera(Camera* pCamera) = 0;
+
+		virtual void Update(float dT, const PipelineState& state) = 0;
+		virtual void Render(const PipelineState& state) = 0;
+
+		//Called before the renderer switches to another backend, nothing may still be presenting afterwards
+		virtual void Flush() = 0;
+	};
+}
@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "ResolutionGovernor.h"
+
+Elite::ResolutionGovernor::ResolutionGovernor(uint32_t maxWidth, uint32_t maxHeight, float targetFrameTime, float minScale)
+	: m_MaxWidth{ maxWidth }
+	, m_MaxHeight{ maxHeight }
+	, m_Width{ maxWidth }
+	, m_Height{ maxHeight }
+	, m_TargetFrameTime{ targetFrameTime }
+	, m_MinScale{ minScale }
+	, m_Scale{ 1.f }
+	, m_AverageFrameTime{}
+	, m_FramesSinceChange{}
+	, m_IsEnabled{ false }
+{
+}
+
+bool Elite::ResolutionGovernor::Update(float frameTime)
+{
+	if (!m_IsEnabled)
+		return false;
+
+	//Smooth the frame time so the governor reacts to load, not to noise
+	if (m_AverageFrameTime <= 0.f)
+		m_AverageFrameTime = frameTime;
+	else
+		m_AverageFrameTime = Lerp(m_AverageFrameTime, frameTime, 0.1f);
+
+	++m_FramesSinceChange;
+	if (m_FramesSinceChange < 10)
+		return false;
+
+	//Shading cost grows with the pixel count, so scale each axis with the square root of the ratio
+	const float ratio = sqrtf(m_TargetFrameTime / m_AverageFrameTime);
+	if (m_AverageFrameTime > m_TargetFrameTime * 1.05f)
+		return ApplyScale(m_Scale * std::max(ratio, 0.85f));
+	if (m_AverageFrameTime < m_TargetFrameTime * 0.8f)
+		return ApplyScale(m_Scale * std::min(ratio, 1.1f));
+
+	return false;
+}
+
+void Elite::ResolutionGovernor::SetEnabled(bool enabled)
+{
+	m_IsEnabled = enabled;
+	m_AverageFrameTime = 0.f;
+	m_FramesSinceChange = 0;
+
+	//Go back to native resolution when the governor is switched off
+	if (!m_IsEnabled)
+		ApplyScale(1.f);
+}
+
+bool Elite::ResolutionGovernor::ApplyScale(float scale)
+{
+	m_Scale = Clamp(scale, m_MinScale, 1.f);
+
+	const uint32_t width = std::max(uint32_t(float(m_MaxWidth) * m_Scale), uint32_t(1));
+	const uint32_t height = std::max(uint32_t(float(m_MaxHeight) * m_Scale), uint32_t(1));
+	if (width == m_Width && height == m_Height)
+		return false;
+
+	m_Width = width;
+	m_Height = height;
+
+	//Measure the new resolution from scratch
+	m_AverageFrameTime = 0.f;
+	m_FramesSinceChange = 0;
+	return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+namespace Elite
+{
+	//Scales the internal render resolution of the software rasterizer so frame time stays close to a target budget
+	class ResolutionGovernor final
+	{
+	public:
+		ResolutionGovernor(uint32_t maxWidth, uint32_t maxHeight, float targetFrameTime = 1.f / 60.f, float minScale = 0.25f);
+		~ResolutionGovernor() = default;
+
+		//Feed the measured frame time, returns true when the render resolution changed
+		bool Update(float frameTime);
+
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return m_IsEnabled; };
+
+		void SetTargetFrameTime(float targetFrameTime) { m_TargetFrameTime = targetFrameTime; };
+		float GetTargetFrameTime() const { return m_TargetFrameTime; };
+
+		float GetScale() const { return m_Scale; };
+		uint32_t GetWidth() const { return m_Width; };
+		uint32_t GetHeight() const { return m_Height; };
+
+	private:
+		bool ApplyScale(float scale);
+
+		uint32_t m_MaxWidth;
+		uint32_t m_MaxHeight;
+		uint32_t m_Width;
+		uint32_t m_Height;
+
+		float m_TargetFrameTime;
+		float m_MinScale;
+		float m_Scale;
+		float m_AverageFrameTime;
+
+		//Only adjust every few frames so a single hitch does not make the resolution jump around
+		uint32_t m_FramesSinceChange;
+
+		bool m_IsEnabled;
+	};
+}
@@ -10,6 +10,9 @@ Texture2D gSpecularMap : SpecularMap;
 Texture2D gGlossinessMap : GlossinessMap;
 
 float4x4 gWorld: World;
+//Positions are stored as unorm16 inside the bounds of the mesh
+float3 gPositionOffset;
+float3 gPositionScale;
 float4x4 gViewInverse : ViewInverse;
 
 float3 lightDirection = { 0.577f, -0.577f, -0.577f };
@@ -21,8 +24,13 @@ struct VS_INPUT
 {
 	float4 Position : POSITION;
 	float2 TexCoord : TEXCOORD;
-	float3 Normal : NORMAL;
-	float3 Tangent : TANGENT;
+	float2 Normal : NORMAL;
+	float2 Tangent : TANGENT;
+	float4 World0 : WORLD0;
+	float4 World1 : WORLD1;
+	float4 World2 : WORLD2;
+	float4 World3 : WORLD3;
+	float3 Tint : TINT;
 };
 
 struct VS_OUTPUT
@@ -32,21 +40,36 @@ struct VS_OUTPUT
 	float2 TexCoord : TEXCOORD;
 	float3 Normal : NORMAL;
 	float3 Tangent : TANGENT;
+	float3 Tint : COLOR;
 };
 
 //-------------------------------------------------------
 // Vertex Shader
 //-------------------------------------------------------
+//Normals & tangents are stored octahedral, the lower half of the octahedron is folded over the diagonals
+float3 DecodeOctahedral(float2 encoded)
+{
+	float3 v = float3(encoded, 1.f - abs(encoded.x) - abs(encoded.y));
+	float fold = saturate(-v.z);
+	v.x += v.x >= 0.f ? -fold : fold;
+	v.y += v.y >= 0.f ? -fold : fold;
+	return normalize(v);
+}
+
 VS_OUTPUT VS(VS_INPUT input)
 {
 	VS_OUTPUT output = (VS_OUTPUT)0;
-	float4 pos = float4(input.Position.xyz, 1.f);
+	//Instances are placed relative to gWorld
+	float4x4 instanceWorld = float4x4(input.World0, input.World1, input.World2, input.World3);
+	float3 position = gPositionOffset + input.Position.xyz * gPositionScale;
+	float4 pos = mul(float4(position, 1.f), instanceWorld);
 	output.Position = mul(pos, gWorldViewProj);
-	float4 worldPos = float4(input.Position.xyz, input.Position.z);
+	float4 worldPos = float4(pos.xyz, position.z);
 	output.WorldPosition = mul(worldPos, gWorld);
 	output.TexCoord = input.TexCoord;
-	output.Normal = mul(normalize(input.Normal), (float3x3)gWorld);
-	output.Tangent = mul(normalize(input.Tangent), (float3x3)gWorld);
+	output.Normal = mul(mul(DecodeOctahedral(input.Normal), (float3x3)instanceWorld), (float3x3)gWorld);
+	output.Tangent = mul(mul(DecodeOctahedral(input.Tangent), (float3x3)instanceWorld), (float3x3)gWorld);
+	output.Tint = input.Tint;
 	return output;
 }
 
@@ -107,7 +130,7 @@ float4 PixelShadingPhong(VS_OUTPUT input, SamplerState sam)
 	observedArea = saturate(observedArea);
 	observedArea /= gPi;
 
-	float4 diffuseColor = gDiffuseMap.Sample(sam, input.TexCoord);
+	float4 diffuseColor = gDiffuseMap.Sample(sam, input.TexCoord) * float4(input.Tint, 1.f);
 
 	float shininess = 25.f;
 
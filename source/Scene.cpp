@@ -0,0 +1,314 @@
+#include "pch.h"
+#include "Scene.h"
+#include "OcclusionBuffer.h"
+
+namespace
+{
+	Elite::AABB TransformBounds(const Elite::AABB& bounds, const Elite::FMatrix4& transform)
+	{
+		//Transforms the center & grows the extent by the absolute rotation, stays tight for rigid transforms
+		Elite::AABB result{};
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			float center = transform[3][i];
+			float extent = 0.f;
+			for (uint8_t j = 0; j < 3; ++j)
+			{
+				center += transform[j][i] * (bounds.min[j] + bounds.max[j]) * 0.5f;
+				extent += std::abs(transform[j][i]) * (bounds.max[j] - bounds.min[j]) * 0.5f;
+			}
+			result.min[i] = center - extent;
+			result.max[i] = center + extent;
+		}
+		return result;
+	}
+
+	//Returns true when the box is behind one of the planes, planes the box is fully in front of are removed from the mask
+	bool IsOutside(const float planes[6][4], const Elite::AABB& bounds, uint32_t& planeMask)
+	{
+		for (uint32_t p = 0; p < 6; ++p)
+		{
+			if (!(planeMask & (1 << p)))
+				continue;
+
+			//Distance of the corners furthest along & furthest against the plane normal
+			float furthest = planes[p][3];
+			float nearest = planes[p][3];
+			for (uint8_t i = 0; i < 3; ++i)
+			{
+				const float a = planes[p][i] * bounds.min[i];
+				const float b = planes[p][i] * bounds.max[i];
+				furthest += std::max(a, b);
+				nearest += std::min(a, b);
+			}
+
+			if (furthest < 0.f)
+				return true;
+			if (nearest >= 0.f)
+				planeMask &= ~(1 << p);
+		}
+		return false;
+	}
+
+	void GrowBounds(Elite::AABB& bounds, const Elite::AABB& other)
+	{
+		for (uint8_t i = 0; i < 3; ++i)
+		{
+			bounds.min[i] = std::min(bounds.min[i], other.min[i]);
+			bounds.max[i] = std::max(bounds.max[i], other.max[i]);
+		}
+	}
+}
+
+Elite::Scene::Scene()
+	: m_ModelBounds{}
+	, m_NeedsBuild{ false }
+{
+}
+
+void Elite::Scene::SetModelBounds(const AABB& bounds)
+{
+	m_ModelBounds = bounds;
+	m_NeedsBuild = true;
+}
+
+uint32_t Elite::Scene::AddNode(const FMatrix4& transform, const RGBColor& tint, bool hasModel, uint32_t parent)
+{
+	const uint32_t node = uint32_t(m_Nodes.size());
+	m_Nodes.push_back(Node{ transform, transform, tint, hasModel, parent, {}, AABB{}, InvalidNode, 0 });
+	if (parent != InvalidNode)
+		m_Nodes[parent].children.push_back(node);
+
+	m_NeedsBuild = true;
+	return node;
+}
+
+void Elite::Scene::SetTransform(uint32_t node, const FMatrix4& transform)
+{
+	m_Nodes[node].transform = transform;
+	m_DirtyNodes.push_back(node);
+}
+
+void Elite::Scene::Clear()
+{
+	m_Nodes.clear();
+	m_DirtyNodes.clear();
+	m_Objects.clear();
+	m_BVH.clear();
+	m_NeedsBuild = false;
+}
+
+void Elite::Scene::Update()
+{
+	//Parents are always added before their children, so one pass in order updates everything
+	if (m_NeedsBuild)
+	{
+		for (uint32_t node = 0; node < m_Nodes.size(); ++node)
+		{
+			Node& current = m_Nodes[node];
+			current.world = (current.parent != InvalidNode) ? m_Nodes[current.parent].world * current.transform : current.transform;
+			current.bounds = TransformBounds(m_ModelBounds, current.world);
+		}
+
+		Build();
+		m_DirtyNodes.clear();
+		m_NeedsBuild = false;
+		return;
+	}
+
+	//Only moved subtrees are updated, the boxes above them are refitted but the hierarchy keeps its shape
+	for (uint32_t node : m_DirtyNodes)
+		UpdateWorld(node);
+	m_DirtyNodes.clear();
+}
+
+void Elite::Scene::UpdateWorld(uint32_t node)
+{
+	std::vector<uint32_t> stack{ node };
+	while (!stack.empty())
+	{
+		Node& current = m_Nodes[stack.back()];
+		stack.pop_back();
+
+		current.world = (current.parent != InvalidNode) ? m_Nodes[current.parent].world * current.transform : current.transform;
+		current.bounds = TransformBounds(m_ModelBounds, current.world);
+		if (current.leaf != InvalidNode)
+			Refit(current.leaf);
+
+		stack.insert(stack.end(), current.children.begin(), current.children.end());
+	}
+}
+
+void Elite::Scene::Build()
+{
+	m_Objects.clear();
+	m_BVH.clear();
+	for (uint32_t node = 0; node < m_Nodes.size(); ++node)
+	{
+		m_Nodes[node].leaf = InvalidNode;
+		if (m_Nodes[node].hasModel)
+			m_Objects.push_back(node);
+	}
+
+	if (!m_Objects.empty())
+		BuildRange(0, uint32_t(m_Objects.size()), InvalidNode);
+}
+
+uint32_t Elite::Scene::BuildRange(uint32_t first, uint32_t count, uint32_t parent)
+{
+	const uint32_t index = uint32_t(m_BVH.size());
+	m_BVH.push_back(BVHNode{ m_Nodes[m_Objects[first]].bounds, parent, InvalidNode, InvalidNode, first, count });
+
+	AABB centers{ m_BVH[index].bounds };
+	for (uint32_t i = first; i < first + count; ++i)
+	{
+		const AABB& bounds = m_Nodes[m_Objects[i]].bounds;
+		GrowBounds(m_BVH[index].bounds, bounds);
+
+		const FPoint3 center{ (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f };
+		GrowBounds(centers, AABB{ center, center });
+	}
+
+	if (count <= MaxLeafObjects)
+	{
+		for (uint32_t i = first; i < first + count; ++i)
+			m_Nodes[m_Objects[i]].leaf = index;
+		return index;
+	}
+
+	//Median split along the axis where the object centers are spread out the most
+	uint8_t axis = 0;
+	for (uint8_t i = 1; i < 3; ++i)
+	{
+		if ((centers.max[i] - centers.min[i]) > (centers.max[axis] - centers.min[axis]))
+			axis = i;
+	}
+
+	const uint32_t half = count / 2;
+	std::nth_element(m_Objects.begin() + first, m_Objects.begin() + first + half, m_Objects.begin() + first + count, [this, axis](uint32_t a, uint32_t b)
+	{
+		return (m_Nodes[a].bounds.min[axis] + m_Nodes[a].bounds.max[axis]) < (m_Nodes[b].bounds.min[axis] + m_Nodes[b].bounds.max[axis]);
+	});
+
+	const uint32_t left = BuildRange(first, half, index);
+	const uint32_t right = BuildRange(first + half, count - half, index);
+	m_BVH[index].left = left;
+	m_BVH[index].right = right;
+	m_BVH[index].count = 0;
+	return index;
+}
+
+void Elite::Scene::Refit(uint32_t bvhNode)
+{
+	while (bvhNode != InvalidNode)
+	{
+		BVHNode& current = m_BVH[bvhNode];
+		if (current.count > 0)
+		{
+			current.bounds = m_Nodes[m_Objects[current.first]].bounds;
+			for (uint32_t i = current.first + 1; i < current.first + current.count; ++i)
+				GrowBounds(current.bounds, m_Nodes[m_Objects[i]].bounds);
+		}
+		else
+		{
+			current.bounds = m_BVH[current.left].bounds;
+			GrowBounds(current.bounds, m_BVH[current.right].bounds);
+		}
+		bvhNode = current.parent;
+	}
+}
+
+void Elite::Scene::Cull(const FMatrix4& sceneToClip, float viewportHeight, std::vector<InstanceData>& visible, const OcclusionBuffer* pOccluders)
+{
+	visible.clear();
+	if (m_BVH.empty())
+		return;
+
+	//Frustum planes straight from the rows of the clip matrix, they point inwards
+	float planes[6][4]{};
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		const float x = sceneToClip[i][0];
+		const float y = sceneToClip[i][1];
+		const float z = sceneToClip[i][2];
+		const float w = sceneToClip[i][3];
+		planes[0][i] = w + x;
+		planes[1][i] = w - x;
+		planes[2][i] = w + y;
+		planes[3][i] = w - y;
+		planes[4][i] = z;
+		planes[5][i] = w - z;
+	}
+
+	//Every entry keeps the planes its box still crosses, boxes fully inside a plane skip it for their whole subtree
+	const uint32_t allPlanes = (1 << 6) - 1;
+	std::pair<uint32_t, uint32_t> stack[64]{};
+	uint32_t stackSize = 0;
+	stack[stackSize++] = { 0, allPlanes };
+
+	while (stackSize > 0)
+	{
+		const uint32_t index = stack[stackSize - 1].first;
+		uint32_t planeMask = stack[stackSize - 1].second;
+		--stackSize;
+
+		const BVHNode& node = m_BVH[index];
+		if (IsOutside(planes, node.bounds, planeMask))
+			continue;
+		if (pOccluders && pOccluders->IsOccluded(node.bounds, sceneToClip))
+			continue;
+
+		if (node.count > 0)
+		{
+			for (uint32_t i = node.first; i < node.first + node.count; ++i)
+			{
+				Node& object = m_Nodes[m_Objects[i]];
+				uint32_t objectMask = planeMask;
+				if (IsOutside(planes, object.bounds, objectMask))
+					continue;
+				if (pOccluders && pOccluders->IsOccluded(object.bounds, sceneToClip))
+					continue;
+
+				object.lod = SelectLod(sceneToClip, viewportHeight, object);
+				visible.push_back(InstanceData{ object.world, object.tint, object.lod });
+			}
+		}
+		else
+		{
+			stack[stackSize++] = { node.left, planeMask };
+			stack[stackSize++] = { node.right, planeMask };
+		}
+	}
+}
+
+uint32_t Elite::Scene::SelectLod(const FMatrix4& sceneToClip, float viewportHeight, const Node& node) const
+{
+	if (m_LodErrors.size() <= 1)
+		return 0;
+
+	//Clip w of the box corner closest to the camera
+	float closestW = sceneToClip[3][3];
+	for (uint8_t i = 0; i < 3; ++i)
+	{
+		const float center = (node.bounds.min[i] + node.bounds.max[i]) * 0.5f;
+		const float extent = (node.bounds.max[i] - node.bounds.min[i]) * 0.5f;
+		closestW += sceneToClip[i][3] * center - std::abs(sceneToClip[i][3]) * extent;
+	}
+	if (closestW <= 0.f)
+		return 0;
+
+	//Pixels one unit of the model covers there, scaled nodes scale their error too
+	const float clipPerUnit = sqrtf(sceneToClip[0][1] * sceneToClip[0][1] + sceneToClip[1][1] * sceneToClip[1][1] + sceneToClip[2][1] * sceneToClip[2][1]);
+	float nodeScale = 0.f;
+	for (uint8_t c = 0; c < 3; ++c)
+		nodeScale = std::max(nodeScale, sqrtf(node.world[c][0] * node.world[c][0] + node.world[c][1] * node.world[c][1] + node.world[c][2] * node.world[c][2]));
+	const float pixelsPerUnit = 0.5f * viewportHeight * clipPerUnit * nodeScale / closestW;
+
+	//Finer levels are picked right away, coarser levels only once they are well below the limit
+	uint32_t lod = std::min(node.lod, uint32_t(m_LodErrors.size()) - 1);
+	while (lod > 0 && m_LodErrors[lod] * pixelsPerUnit > MaxPixelError)
+		--lod;
+	while (lod + 1 < m_LodErrors.size() && m_LodErrors[lod + 1] * pixelsPerUnit <= MaxPixelError * LodHysteresis)
+		++lod;
+	return lod;
+}
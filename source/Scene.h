@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "RenderBackend.h"
+
+namespace Elite
+{
+	class OcclusionBuffer;
+
+	//Axis aligned bounding box
+	struct AABB
+	{
+		FPoint3 min;
+		FPoint3 max;
+	};
+
+	//Objects placed relative to the pipeline world matrix, every node with a model draws all meshes of the renderer
+	//Nodes are kept in a bounding volume hierarchy, moving a node only refits the boxes above it
+	class Scene final
+	{
+	public:
+		static const uint32_t InvalidNode = UINT32_MAX;
+		static constexpr float MaxPixelError = 1.f;
+		//A coarser level is only picked once its error is this far below the limit, so objects do not flicker between levels
+		static constexpr float LodHysteresis = 0.75f;
+
+		Scene();
+		~Scene() = default;
+
+		Scene(const Scene&) = delete;
+		Scene(Scene&&) noexcept = delete;
+		Scene& operator=(const Scene&) = delete;
+		Scene& operator=(Scene&&) noexcept = delete;
+
+		//Bounds of the meshes in model space, rebuilds the hierarchy on the next update
+		void SetModelBounds(const AABB& bounds);
+		//Model space error of every level of detail, level 0 is the full mesh
+		void SetLodErrors(const std::vector<float>& lodErrors) { m_LodErrors = lodErrors; };
+
+		//Children are transformed by their parent, parents have to be added first
+		uint32_t AddNode(const FMatrix4& transform, const RGBColor& tint, bool hasModel = true, uint32_t parent = InvalidNode);
+		void SetTransform(uint32_t node, const FMatrix4& transform);
+		void Clear();
+
+		//Applies moved transforms & refits the hierarchy, has to be called before culling
+		void Update();
+		//Nodes were added, removed or moved since the last update
+		bool IsDirty() const { return m_NeedsBuild || !m_DirtyNodes.empty(); };
+
+		//Adds every node with a model that intersects the clip volume of sceneToClip (0 <= z <= w)
+		//Visible nodes also get the coarsest level of detail that stays below MaxPixelError on screen
+		//With occluders, nodes & subtrees hidden behind them are left out as well
+		void Cull(const FMatrix4& sceneToClip, float viewportHeight, std::vector<InstanceData>& visible, const OcclusionBuffer* pOccluders = nullptr);
+
+		uint32_t GetAmountOfNodes() const { return uint32_t(m_Nodes.size()); };
+
+	private:
+		struct Node
+		{
+			FMatrix4 transform;
+			FMatrix4 world;
+			RGBColor tint;
+			bool hasModel;
+			uint32_t parent;
+			std::vector<uint32_t> children;
+			AABB bounds;
+			uint32_t leaf;
+			uint32_t lod;
+		};
+
+		//Leaves point to a range of m_Objects, inner nodes to their two children
+		struct BVHNode
+		{
+			AABB bounds;
+			uint32_t parent;
+			uint32_t left;
+			uint32_t right;
+			uint32_t first;
+			uint32_t count;
+		};
+
+		static const uint32_t MaxLeafObjects = 4;
+
+		void UpdateWorld(uint32_t node);
+		void Build();
+		uint32_t BuildRange(uint32_t first, uint32_t count, uint32_t parent);
+		void Refit(uint32_t bvhNode);
+		uint32_t SelectLod(const FMatrix4& sceneToClip, float viewportHeight, const Node& node) const;
+
+		AABB m_ModelBounds;
+		std::vector<float> m_LodErrors;
+		std::vector<Node> m_Nodes;
+		std::vector<uint32_t> m_DirtyNodes;
+		std::vector<uint32_t> m_Objects;
+		std::vector<BVHNode> m_BVH;
+		bool m_NeedsBuild;
+	};
+}
@@ -0,0 +1,62 @@
+#include "pch.h"
+#include "ShadingRateMap.h"
+
+void Elite::ShadingRateMap::Resize(uint32_t width, uint32_t height)
+{
+	m_Width = width;
+	m_Height = height;
+	m_TilesX = (width + TileSize - 1) / TileSize;
+	m_TilesY = (height + TileSize - 1) / TileSize;
+	m_Rates.assign(m_TilesX * m_TilesY, ShadingRate::rate1x1);
+}
+
+void Elite::ShadingRateMap::Fill(ShadingRate rate)
+{
+	std::fill(m_Rates.begin(), m_Rates.end(), rate);
+}
+
+void Elite::ShadingRateMap::BuildFromLuminance(const uint32_t* pPixels, const SDL_PixelFormat* pFormat)
+{
+	for (uint32_t tileY = 0; tileY < m_TilesY; ++tileY)
+	{
+		for (uint32_t tileX = 0; tileX < m_TilesX; ++tileX)
+		{
+			const uint32_t startX = tileX * TileSize;
+			const uint32_t startY = tileY * TileSize;
+			const uint32_t endX = std::min(startX + TileSize, m_Width);
+			const uint32_t endY = std::min(startY + TileSize, m_Height);
+
+			//Luminance mean & variance of the tile, from the pixels that were shaded at full rate
+			float sum = 0.f;
+			float sumSquared = 0.f;
+			uint32_t amountOfSamples = 0;
+			for (uint32_t r = startY; r < endY; r += LuminanceSampleSpacing)
+			{
+				for (uint32_t c = startX; c < endX; c += LuminanceSampleSpacing)
+				{
+					const uint32_t pixel = pPixels[c + (r * m_Width)];
+					const float red = float((pixel & pFormat->Rmask) >> pFormat->Rshift);
+					const float green = float((pixel & pFormat->Gmask) >> pFormat->Gshift);
+					const float blue = float((pixel & pFormat->Bmask) >> pFormat->Bshift);
+					const float luminance = (0.2126f * red + 0.7152f * green + 0.0722f * blue) / 255.f;
+					sum += luminance;
+					sumSquared += luminance * luminance;
+					++amountOfSamples;
+				}
+			}
+
+			const float mean = sum / float(amountOfSamples);
+			const float variance = (sumSquared / float(amountOfSamples)) - (mean * mean);
+
+			ShadingRate rate = ShadingRate::rate1x1;
+			if (variance < 0.0005f)
+				rate = ShadingRate::rate4x4;
+			else if (variance < 0.002f)
+				rate = ShadingRate::rate2x2;
+			else if (variance < 0.006f)
+				rate = ShadingRate::rate1x2;
+
+			SetTileRate(tileX, tileY, rate);
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EHelper.h"
+#include "FrameBuffer.h"
+
+struct SDL_PixelFormat;
+
+namespace Elite
+{
+	//Screen space map that stores one shading rate per tile of the software render target
+	class ShadingRateMap final
+	{
+	public:
+		static const uint32_t TileSize = FrameBuffer::TileSize;
+
+		ShadingRateMap() = default;
+		~ShadingRateMap() = default;
+
+		void Resize(uint32_t width, uint32_t height);
+		void Fill(ShadingRate rate);
+
+		//Pick coarse rates for tiles that had little luminance variance in the given (previous) frame
+		//Only the first pixel of every 4x4 block is read, every shading rate shades that pixel itself
+		//so the variance does not drop in tiles that were shaded coarsely & they can go back to full rate
+		void BuildFromLuminance(const uint32_t* pPixels, const SDL_PixelFormat* pFormat);
+		static const uint32_t LuminanceSampleSpacing = 4;
+
+		void SetTileRate(uint32_t tileX, uint32_t tileY, ShadingRate rate) { m_Rates[tileX + (tileY * m_TilesX)] = rate; };
+		ShadingRate GetTileRate(uint32_t tileX, uint32_t tileY) const { return m_Rates[tileX + (tileY * m_TilesX)]; };
+
+		uint32_t GetTilesX() const { return m_TilesX; };
+		uint32_t GetTilesY() const { return m_TilesY; };
+
+	private:
+		uint32_t m_Width{};
+		uint32_t m_Height{};
+		uint32_t m_TilesX{};
+		uint32_t m_TilesY{};
+		std::vector<ShadingRate> m_Rates{};
+	};
+
+	inline uint32_t GetShadingRateWidth(ShadingRate rate)
+	{
+		return (rate == ShadingRate::rate4x4) ? 4 : (rate == ShadingRate::rate2x2) ? 2 : 1;
+	}
+
+	inline uint32_t GetShadingRateHeight(ShadingRate rate)
+	{
+		return (rate == ShadingRate::rate4x4) ? 4 : (rate == ShadingRate::rate1x1) ? 1 : 2;
+	}
+
+	inline ShadingRate GetCoarserRate(ShadingRate rate0, ShadingRate rate1)
+	{
+		return (int(rate0) > int(rate1)) ? rate0 : rate1;
+	}
+
+	//Rate a triangle can afford from its texture derivatives, magnified textures hold little detail per pixel
+	inline ShadingRate GetTextureShadingRate(float texelsPerPixel)
+	{
+		if (texelsPerPixel < 0.25f)
+			return ShadingRate::rate4x4;
+		if (texelsPerPixel < 0.5f)
+			return ShadingRate::rate2x2;
+		if (texelsPerPixel < 0.75f)
+			return ShadingRate::rate1x2;
+		return ShadingRate::rate1x1;
+	}
+}
@@ -0,0 +1,1022 @@
+#include "pch.h"
+#include "SoftwareBackend.h"
+#include "ECamera.h"
+#include "EBRDF.h"
+#include "EBatch.h"
+#include "Profiler.h"
+#include "ImageWriter.h"
+
+namespace
+{
+	//Amount of pixels in a 4 bit quad mask
+	inline uint32_t CountQuadBits(uint32_t mask)
+	{
+		return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+	}
+}
+
+Elite::SoftwareBackend::SoftwareBackend(SDL_Window* pWindow, uint32_t width, uint32_t height)
+	: m_Width{ width }
+	, m_Height{ height }
+	, m_pPresenter{ nullptr }
+	, m_pBackBuffer{ nullptr }
+	, m_pBackBufferPixels{ nullptr }
+	, m_Governor{ width, height }
+	, m_HasRenderedFrame{ false }
+	, m_Context{}
+	, m_FrameStatistics{}
+	, m_RenderThread{}
+	, m_RenderMutex{}
+	, m_RenderCondition{}
+	, m_pRenderingBuffer{ nullptr }
+	, m_IsFrameRequested{ false }
+	, m_IsQuitting{ false }
+	, m_TextureDiffuse{ "Resources/vehicle_diffuse.png" }
+	, m_TextureNormal{ "Resources/vehicle_normal.png" }
+	, m_TexureSpecularMap{ "Resources/vehicle_specular.png" }
+	, m_TextureGlossiness{ "Resources/vehicle_gloss.png" }
+	, m_TextureTransparent{ "Resources/fireFX_diffuse.png" }
+	, m_pCamera{ nullptr }
+{
+	m_pPresenter = new FramePresenter(pWindow, m_Width, m_Height, pWindow ? PresentMode::blit : PresentMode::offscreen);
+	m_pBackBuffer = m_pPresenter->GetBackBuffers().front();
+	m_pBackBufferPixels = (uint32_t*)m_pBackBuffer->pixels;
+
+	m_Context.pFrameBuffer = new FrameBuffer(m_pBackBuffer->format);
+	m_Context.shadingRateMode = ShadingRateMode::full;
+	m_Context.cull = CullMode::back;
+	m_Context.isMeshletOcclusion = true;
+	m_Context.renderTransparent = false;
+	m_Context.isTransparentPass = false;
+	m_Context.tilePixels.resize(FrameBuffer::TileSize * FrameBuffer::TileSize);
+	m_Context.statistics = FrameStatistics{};
+	m_Context.isPixelStatistics = false;
+	m_Context.debugView = DebugView::none;
+
+	//Render resolution starts at window size
+	ResizeRenderTarget(m_Width, m_Height);
+}
+
+Elite::SoftwareBackend::~SoftwareBackend()
+{
+	FinishFrame();
+	if (m_RenderThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock{ m_RenderMutex };
+			m_IsQuitting = true;
+		}
+		m_RenderCondition.notify_all();
+		m_RenderThread.join();
+	}
+
+	delete m_Context.pFrameBuffer;
+	m_Context.pFrameBuffer = nullptr;
+
+	delete m_pPresenter;
+	m_pPresenter = nullptr;
+}
+
+void Elite::SoftwareBackend::AddMesh(const MeshData& mesh)
+{
+	FinishFrame();
+	if (mesh.lods.empty())
+		return;
+
+	//Transparent meshes are small effects, only their full detail level is kept
+	if (mesh.isTransparent)
+	{
+		const MeshLOD& source = mesh.lods.front();
+		const uint32_t indexOffset = uint32_t(m_TransparentMesh.vertices.size());
+		m_TransparentMesh.vertices.insert(m_TransparentMesh.vertices.end(), source.vertices.begin(), source.vertices.end());
+		for (uint32_t index : source.indices)
+			m_TransparentMesh.indices.push_back(index + indexOffset);
+
+		m_TransparentMeshlets = BuildMeshlets(m_TransparentMesh.vertices, m_TransparentMesh.indices);
+		m_PackedTransparentMesh = PackMesh({ m_TransparentMesh });
+		return;
+	}
+
+	//Every opaque mesh is appended to one vertex & index list per level, a mesh with fewer levels repeats its coarsest one
+	const size_t levelCount = std::max(m_Lods.size(), mesh.lods.size());
+	while (m_Lods.size() < levelCount)
+		m_Lods.push_back(m_Lods.empty() ? MeshLOD{ {}, {}, 0.f } : m_Lods.back());
+
+	for (size_t level = 0; level < levelCount; ++level)
+	{
+		const MeshLOD& source = mesh.lods[std::min(level, mesh.lods.size() - 1)];
+		MeshLOD& lod = m_Lods[level];
+
+		const uint32_t indexOffset = uint32_t(lod.vertices.size());
+		lod.vertices.insert(lod.vertices.end(), source.vertices.begin(), source.vertices.end());
+		for (uint32_t index : source.indices)
+			lod.indices.push_back(index + indexOffset);
+		lod.error = std::max(lod.error, source.error);
+	}
+
+	m_Meshlets.clear();
+	size_t amountOfMeshlets = 0;
+	for (const MeshLOD& lod : m_Lods)
+	{
+		m_Meshlets.push_back(BuildMeshlets(lod.vertices, lod.indices));
+		amountOfMeshlets += m_Meshlets.back().meshlets.size();
+	}
+	m_PackedLods = PackMesh(m_Lods);
+	std::cout << "Meshlets: split " << m_Lods.size() << " level(s) into " << amountOfMeshlets << " meshlet(s)\n";
+}
+
+void Elite::SoftwareBackend::Update(float dT, const PipelineState& state)
+{
+	(void)state;
+
+	if (!m_HasRenderedFrame)
+		return;
+	m_HasRenderedFrame = false;
+
+	if (m_Governor.Update(dT))
+	{
+		FinishFrame();
+		ResizeRenderTarget(m_Governor.GetWidth(), m_Governor.GetHeight());
+	}
+}
+
+void Elite::SoftwareBackend::Render(const PipelineState& state)
+{
+	ELITE_PROFILE_SCOPE("SoftwareBackend::Render");
+	//The previous frame is queued, not presented yet, it is presented below while this one renders
+	FinishFrame();
+
+	m_Context.worldToView = m_pCamera->GetWorldToView();
+	m_Context.projection = m_pCamera->GetProjectionMatrix();
+	m_Context.world = state.world;
+	m_Context.instances = state.instances;
+	m_Context.cull = state.cull;
+	m_Context.renderTransparent = state.renderTransparent;
+
+	//Get a free back buffer, presents the oldest queued frame when none is free
+	{
+		ELITE_PROFILE_SCOPE("AcquireBackBuffer");
+		m_pBackBuffer = m_pPresenter->AcquireBackBuffer();
+	}
+	m_pBackBufferPixels = (uint32_t*)m_pBackBuffer->pixels;
+	if (m_RenderBuffer.empty())
+		m_Context.pRenderPixels = m_pBackBufferPixels;
+
+	SDL_LockSurface(m_pBackBuffer);
+
+	//The window surface is read while it is presented & offscreen frames have nothing to present, so only blitted frames overlap
+	if (m_pPresenter->GetPresentMode() == PresentMode::blit)
+	{
+		if (!m_RenderThread.joinable())
+			m_RenderThread = std::thread{ &SoftwareBackend::RenderLoop, this };
+		{
+			std::lock_guard<std::mutex> lock{ m_RenderMutex };
+			m_pRenderingBuffer = m_pBackBuffer;
+			m_IsFrameRequested = true;
+		}
+		m_RenderCondition.notify_all();
+
+		ELITE_PROFILE_SCOPE("Present");
+		m_pPresenter->PresentQueued();
+	}
+	else
+	{
+		RenderFrame(m_Context);
+		UpscaleStage();
+		SDL_UnlockSurface(m_pBackBuffer);
+		m_FrameStatistics = m_Context.statistics;
+
+		ELITE_PROFILE_SCOPE("Present");
+		m_pPresenter->Present(m_pBackBuffer);
+	}
+	m_HasRenderedFrame = true;
+}
+
+void Elite::SoftwareBackend::RenderLoop()
+{
+	ELITE_PROFILE_THREAD("Render");
+	std::unique_lock<std::mutex> lock{ m_RenderMutex };
+	while (true)
+	{
+		m_RenderCondition.wait(lock, [this]() { return m_IsFrameRequested || m_IsQuitting; });
+		if (m_IsQuitting)
+			return;
+
+		lock.unlock();
+		RenderFrame(m_Context);
+		UpscaleStage();
+		lock.lock();
+
+		m_IsFrameRequested = false;
+		m_RenderCondition.notify_all();
+	}
+}
+
+void Elite::SoftwareBackend::FinishFrame()
+{
+	if (!m_pRenderingBuffer)
+		return;
+
+	{
+		ELITE_PROFILE_SCOPE("WaitForRenderThread");
+		std::unique_lock<std::mutex> lock{ m_RenderMutex };
+		m_RenderCondition.wait(lock, [this]() { return !m_IsFrameRequested; });
+	}
+	SDL_UnlockSurface(m_pRenderingBuffer);
+	m_FrameStatistics = m_Context.statistics;
+	m_pPresenter->Queue(m_pRenderingBuffer);
+	m_pRenderingBuffer = nullptr;
+}
+
+void Elite::SoftwareBackend::RenderFrame(RasterContext& context) const
+{
+	ELITE_PROFILE_SCOPE("RenderFrame");
+	//Clear Buffers, tiles are only cleared once they are rendered to or resolved
+	{
+		ELITE_PROFILE_SCOPE("ClearBuffers");
+		context.pFrameBuffer->SetColorBuffer(context.pRenderPixels);
+		context.pFrameBuffer->Clear(RGBColor(0.1f, 0.1f, 0.1f));
+	}
+
+	//Statistics start over, the per pixel counts are cleared to the current render size
+	const bool isCountingPixels = context.isPixelStatistics || context.debugView != DebugView::none;
+	const size_t amountOfPixels = size_t(context.renderWidth) * context.renderHeight;
+	context.statistics = FrameStatistics{};
+	context.statistics.instances = context.instances.size();
+	context.statistics.pixels = amountOfPixels;
+	if (isCountingPixels)
+	{
+		context.pixelStatistics.layers.assign(amountOfPixels, 0);
+		context.pixelStatistics.shadingCost.assign(amountOfPixels, 0);
+	}
+	else if (!context.pixelStatistics.layers.empty())
+		context.pixelStatistics = PixelStatistics{};
+
+	//Render
+	context.transformedVertices.resize(MaxMeshletVertices);
+	if (!m_Lods.empty())
+	{
+		for (const InstanceData& instance : context.instances)
+		{
+			const size_t level = std::min(size_t(instance.lod), m_Lods.size() - 1);
+			InstanceStage(context, instance);
+
+			//Whole meshlets are skipped before any of their vertices are transformed
+			for (const Meshlet& meshlet : m_Meshlets[level].meshlets)
+			{
+				++context.statistics.meshletsTested;
+				if (!IsMeshletVisible(context, meshlet))
+				{
+					++context.statistics.meshletsCulled;
+					continue;
+				}
+
+				ProjectionStage(context, m_PackedLods.lods[level], m_PackedLods.quantization, m_Meshlets[level], meshlet);
+				RasterizerStage(context, m_Meshlets[level], meshlet);
+			}
+		}
+	}
+
+	//Transparent meshes are tested against the opaque depth but never write their own, so their triangles can be drawn in any order
+	if (context.renderTransparent && !m_TransparentMesh.indices.empty())
+	{
+		ELITE_PROFILE_SCOPE("TransparentPass");
+		//Effects are seen from both sides, like the flat effect of DirectX
+		const CullMode opaqueCull = context.cull;
+		context.cull = CullMode::none;
+		context.transparencyBuffer.Clear();
+		context.isTransparentPass = true;
+		for (const InstanceData& instance : context.instances)
+		{
+			InstanceStage(context, instance);
+			for (const Meshlet& meshlet : m_TransparentMeshlets.meshlets)
+			{
+				++context.statistics.meshletsTested;
+				if (!IsMeshletVisible(context, meshlet))
+				{
+					++context.statistics.meshletsCulled;
+					continue;
+				}
+
+				ProjectionStage(context, m_PackedTransparentMesh.lods.front(), m_PackedTransparentMesh.quantization, m_TransparentMeshlets, meshlet);
+				RasterizerStage(context, m_TransparentMeshlets, meshlet);
+			}
+		}
+		context.isTransparentPass = false;
+		context.cull = opaqueCull;
+		ELITE_PROFILE_SCOPE("Composite");
+		context.transparencyBuffer.Composite(*context.pFrameBuffer);
+	}
+	{
+		ELITE_PROFILE_SCOPE("Resolve");
+		context.pFrameBuffer->Resolve();
+	}
+	ShadingRateStage(context);
+
+	//The heatmap is drawn after the adaptive shading rates were built, they keep following the shaded frame
+	if (isCountingPixels)
+	{
+		ELITE_PROFILE_SCOPE("PixelStatistics");
+		CountPixelStatistics(context.pixelStatistics, context.statistics);
+		WriteHeatmap(context.debugView, context.pixelStatistics, *context.pFrameBuffer);
+	}
+}
+
+void Elite::SoftwareBackend::Flush()
+{
+	FinishFrame();
+	m_pPresenter->Flush();
+}
+
+Elite::FMatrix4 Elite::SoftwareBackend::GetClipMatrix(const FMatrix4& worldToView, const FMatrix4& projection, const FMatrix4& world)
+{
+	FMatrix4 clip = projection * worldToView * world;
+
+	//Make the mesh visible, w is scaled up so the mesh fits on screen
+	for (uint32_t c = 0; c < 4; ++c)
+		clip[c][3] *= 10.f;
+	return clip;
+}
+
+void Elite::SoftwareBackend::InstanceStage(RasterContext& context, const InstanceData& instance) const
+{
+	ELITE_PROFILE_SCOPE("InstanceStage");
+	context.instanceWorld = context.world * instance.world;
+	context.instanceClip = GetClipMatrix(context.worldToView, context.projection, context.instanceWorld);
+	context.tint = instance.tint;
+
+	context.modelCamera = GetClipOrigin(context.instanceClip);
+
+	//Reversed depth is flipped in the matrix, so no vertex has to subtract two nearly equal clip values & the far plane keeps the float precision around 0
+	context.depthClip = context.instanceClip;
+	if (context.pFrameBuffer->IsDepthReversed())
+	{
+		for (uint32_t c = 0; c < 4; ++c)
+			context.depthClip[c][2] = context.instanceClip[c][3] - context.instanceClip[c][2];
+	}
+
+	//Frustum planes from the rows of the clip matrix, normalized so spheres can be tested against them
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		const float x = context.instanceClip[i][0];
+		const float y = context.instanceClip[i][1];
+		const float z = context.instanceClip[i][2];
+		const float w = context.instanceClip[i][3];
+		context.modelPlanes[0][i] = w + x;
+		context.modelPlanes[1][i] = w - x;
+		context.modelPlanes[2][i] = w + y;
+		context.modelPlanes[3][i] = w - y;
+		context.modelPlanes[4][i] = z;
+		context.modelPlanes[5][i] = w - z;
+	}
+	for (float* pPlane : context.modelPlanes)
+	{
+		const float length = sqrtf(pPlane[0] * pPlane[0] + pPlane[1] * pPlane[1] + pPlane[2] * pPlane[2]);
+		for (uint8_t i = 0; i < 4; ++i)
+			pPlane[i] /= length;
+	}
+}
+
+bool Elite::SoftwareBackend::IsMeshletVisible(const RasterContext& context, const Meshlet& meshlet) const
+{
+	//Frustum
+	for (const float* pPlane : context.modelPlanes)
+	{
+		if (pPlane[0] * meshlet.center.x + pPlane[1] * meshlet.center.y + pPlane[2] * meshlet.center.z + pPlane[3] < -meshlet.radius)
+			return false;
+	}
+
+	//Normal cone, front face culling mirrors the cone
+	if (context.cull == CullMode::back && IsMeshletBackFacing(meshlet, context.modelCamera))
+		return false;
+	if (context.cull == CullMode::front)
+	{
+		Meshlet mirrored{ meshlet };
+		mirrored.coneAxis = -meshlet.coneAxis;
+		if (IsMeshletBackFacing(mirrored, context.modelCamera))
+			return false;
+	}
+
+	if (!context.isMeshletOcclusion)
+		return true;
+
+	//Occlusion, the screen rectangle & closest depth of the box around the sphere
+	//Reversed depth keeps the largest value closest
+	FMatrix4 clipMatrix = context.depthClip;
+	const bool isReversed = context.pFrameBuffer->IsDepthReversed();
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float closestDepth = isReversed ? -FLT_MAX : FLT_MAX;
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		const FPoint4 position{ meshlet.center.x + ((corner & 1) ? meshlet.radius : -meshlet.radius),
+			meshlet.center.y + ((corner & 2) ? meshlet.radius : -meshlet.radius),
+			meshlet.center.z + ((corner & 4) ? meshlet.radius : -meshlet.radius), 1.f };
+		FPoint4 clip = clipMatrix * position;
+
+		//Boxes that reach behind the camera have no closed rectangle on screen
+		if (clip.w <= 0.f)
+			return true;
+
+		const float x = ((clip.x / clip.w + 1) / 2.0f) * context.renderWidth;
+		const float y = ((1 - clip.y / clip.w) / 2.0f) * context.renderHeight;
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+
+		const float depth = clip.z / clip.w;
+		closestDepth = isReversed ? std::max(closestDepth, depth) : std::min(closestDepth, depth);
+	}
+
+	const uint32_t startX = uint32_t(Clamp(minX, 0.f, float(context.renderWidth)));
+	const uint32_t startY = uint32_t(Clamp(minY, 0.f, float(context.renderHeight)));
+	const uint32_t endX = uint32_t(ceilf(Clamp(maxX, 0.f, float(context.renderWidth))));
+	const uint32_t endY = uint32_t(ceilf(Clamp(maxY, 0.f, float(context.renderHeight))));
+	return !context.pFrameBuffer->IsOccluded(startX, startY, endX, endY, closestDepth);
+}
+
+void Elite::SoftwareBackend::ProjectionStage(RasterContext& context, const std::vector<PackedVertex>& vertices, const VertexQuantization& quantization, const MeshletMesh& meshlets, const Meshlet& meshlet) const
+{
+	ELITE_PROFILE_SCOPE("ProjectionStage");
+	//Gather & decode the vertices of the meshlet, every stage after this streams over them in place
+	Vertex_Input* pVertices = context.transformedVertices.data();
+	UnpackVertices(vertices.data(), quantization, &meshlets.vertices[meshlet.vertexOffset], meshlet.vertexCount, pVertices);
+
+	const StridedSpan<Vertex_Input> transformed{ pVertices, meshlet.vertexCount };
+	const StridedSpan<FPoint4> positions{ &transformed.pFirst->position, transformed.count, transformed.stride };
+	const StridedSpan<FPoint3> positions3{ &transformed.pFirst->position.xyz, transformed.count, transformed.stride };
+	const StridedSpan<FVector3> normals{ &transformed.pFirst->normal, transformed.count, transformed.stride };
+	const StridedSpan<FVector3> tangents{ &transformed.pFirst->tangent, transformed.count, transformed.stride };
+	const StridedSpan<FVector3> viewDirections{ &transformed.pFirst->viewDirection, transformed.count, transformed.stride };
+
+	//The camera is subtracted through the translation, so the transform gives the view directions directly
+	FMatrix4 worldToCamera = context.instanceWorld;
+	worldToCamera[3] -= context.worldToView[3];
+	TransformPoints(worldToCamera, positions3, viewDirections);
+	NormalizeVectors(viewDirections);
+
+	TransformVectors(context.instanceWorld, normals, normals);
+	TransformVectors(context.instanceWorld, tangents, tangents);
+
+	ProjectPoints(context.depthClip, positions, positions);
+}
+
+void Elite::SoftwareBackend::RasterizerStage(RasterContext& context, const MeshletMesh& meshlets, const Meshlet& meshlet) const
+{
+	ELITE_PROFILE_SCOPE("RasterizerStage");
+	context.statistics.trianglesTested += meshlet.triangleCount;
+	for (uint32_t t{}; t < meshlet.triangleCount; t++)
+	{
+		const uint8_t* pTriangle = &meshlets.triangles[(meshlet.triangleOffset + t) * 3];
+		std::vector<Elite::Vertex_Input> NDCVertices = { context.transformedVertices[pTriangle[0]], context.transformedVertices[pTriangle[1]], context.transformedVertices[pTriangle[2]] };
+
+		//Frustum culling
+		bool culling = false;
+		for (int i{}; i < NDCVertices.size(); i++)
+		{
+			if (NDCVertices[i].position.x < -1.0f || NDCVertices[i].position.x > 1.0f)
+			{
+				culling = true;
+			}
+			if (NDCVertices[i].position.y < -1.0f || NDCVertices[i].position.y > 1.0f)
+			{
+				culling = true;
+			}
+			if (NDCVertices[i].position.z < 0.0f || NDCVertices[i].position.z > 1.0f)
+			{
+				culling = true;
+			}
+
+			//Rasterization stage
+			NDCVertices[i].position.x = ((NDCVertices[i].position.x + 1) / 2.0f) * context.renderWidth;
+			NDCVertices[i].position.y = ((1 - NDCVertices[i].position.y) / 2.0f) * context.renderHeight;
+		}
+
+		if (culling)
+		{
+			++context.statistics.trianglesFrustumCulled;
+			continue;
+		}
+
+		//A triangle that faces away has no pixel inside it, so its bounding box is never walked
+		const FVector2 edge0{ NDCVertices[1].position - NDCVertices[0].position };
+		const FVector2 edge1{ NDCVertices[2].position - NDCVertices[0].position };
+		const float signedArea = Cross(edge1, edge0);
+		if ((context.cull == CullMode::back && signedArea < 0.f) || (context.cull == CullMode::front && signedArea > 0.f))
+		{
+			++context.statistics.trianglesBackFaceCulled;
+			continue;
+		}
+
+		//Bounding Box
+		Elite::FPoint2 topLeft = Elite::FPoint2{ std::min(std::min(NDCVertices[0].position.x, NDCVertices[1].position.x), NDCVertices[2].position.x),
+			std::min(std::min(NDCVertices[0].position.y, NDCVertices[1].position.y), NDCVertices[2].position.y) };
+
+		Elite::FPoint2 bottomRight = Elite::FPoint2{ std::max(std::max(NDCVertices[0].position.x, NDCVertices[1].position.x), NDCVertices[2].position.x),
+			std::max(std::max(NDCVertices[0].position.y, NDCVertices[1].position.y), NDCVertices[2].position.y) };
+
+		topLeft.x = Elite::Clamp(topLeft.x, 0.f, float(context.renderWidth));
+		topLeft.y = Elite::Clamp(topLeft.y, 0.f, float(context.renderHeight));
+		bottomRight.x = Elite::Clamp(bottomRight.x, 0.f, float(context.renderWidth));
+		bottomRight.y = Elite::Clamp(bottomRight.y, 0.f, float(context.renderHeight));
+
+		const uint32_t minX = uint32_t(topLeft.x);
+		const uint32_t minY = uint32_t(topLeft.y);
+		const uint32_t maxX = uint32_t(ceilf(bottomRight.x));
+		const uint32_t maxY = uint32_t(ceilf(bottomRight.y));
+		if (minX >= maxX || minY >= maxY)
+			continue;
+		++context.statistics.trianglesRasterized;
+
+		//Adaptive shading also looks at how magnified the diffuse texture is on this triangle
+		ShadingRate triangleRate = ShadingRate::rate1x1;
+		if (context.shadingRateMode == ShadingRateMode::adaptive)
+		{
+			const FVector2 uvEdge0{ NDCVertices[1].uv - NDCVertices[0].uv };
+			const FVector2 uvEdge1{ NDCVertices[2].uv - NDCVertices[0].uv };
+			const float screenArea = std::abs(signedArea);
+			const float texelArea = std::abs(Cross(uvEdge0, uvEdge1)) * float(m_TextureDiffuse.GetWidth() * m_TextureDiffuse.GetHeight());
+			if (screenArea > 0.f)
+				triangleRate = GetTextureShadingRate(sqrtf(texelArea / screenArea));
+		}
+
+		//Walk the bounding box tile by tile, every tile shades its pixels in blocks of its own shading rate
+		const uint32_t tileSize = ShadingRateMap::TileSize;
+		for (uint32_t tileY = minY / tileSize; tileY <= (maxY - 1) / tileSize; ++tileY)
+		{
+			for (uint32_t tileX = minX / tileSize; tileX <= (maxX - 1) / tileSize; ++tileX)
+			{
+				context.pFrameBuffer->TouchTile(tileX, tileY);
+				if (context.isTransparentPass)
+					context.transparencyBuffer.TouchTile(tileX, tileY);
+
+				const ShadingRate rate = GetCoarserRate(context.shadingRateMap.GetTileRate(tileX, tileY), triangleRate);
+				ShadeTile(context, NDCVertices, tileX, tileY, std::max(minX, tileX * tileSize), std::max(minY, tileY * tileSize),
+					std::min(maxX, (tileX + 1) * tileSize), std::min(maxY, (tileY + 1) * tileSize), rate);
+			}
+		}
+	}
+}
+
+void Elite::SoftwareBackend::ShadeTile(RasterContext& context, const std::vector<Elite::Vertex_Input>& ndcVertices, uint32_t tileX, uint32_t tileY, uint32_t startX, uint32_t startY, uint32_t endX, uint32_t endY, ShadingRate rate) const
+{
+	ELITE_PROFILE_SCOPE("ShadeTile");
+	const uint32_t tileSize = FrameBuffer::TileSize;
+	const uint32_t tileStartX = tileX * tileSize;
+	const uint32_t tileStartY = tileY * tileSize;
+
+	//Coverage is resolved per pixel, depth is tested 4 pixels at a time
+	uint32_t passedRows[tileSize]{};
+	float alphas[tileSize * tileSize];
+	for (uint32_t r = startY; r < endY; ++r)
+	{
+		for (uint32_t quadX = startX - (startX % 4); quadX < endX; quadX += 4)
+		{
+			float depths[4]{};
+			uint32_t coverage = 0;
+			for (uint32_t i = 0; i < 4; ++i)
+			{
+				const uint32_t c = quadX + i;
+				if (c < startX || c >= endX)
+					continue;
+
+				Elite::Vertex_Input& pixel = context.tilePixels[(c - tileStartX) + ((r - tileStartY) * tileSize)];
+				pixel.position = { float(c), float(r), 0, 0 };
+				if (IsInTriangle(pixel, ndcVertices, context.cull))
+				{
+					//Fully transparent texels are dropped before they are depth tested or shaded
+					if (context.isTransparentPass)
+					{
+						alphas[(c - tileStartX) + ((r - tileStartY) * tileSize)] = m_TextureTransparent.SampleAlpha(pixel.uv);
+						if (alphas[(c - tileStartX) + ((r - tileStartY) * tileSize)] <= 0.f)
+							continue;
+					}
+
+					depths[i] = pixel.position.z;
+					coverage |= 1 << i;
+				}
+			}
+
+			if (coverage != 0)
+			{
+				const uint32_t passed = context.pFrameBuffer->DepthTestQuad(quadX, r, depths, coverage, !context.isTransparentPass);
+				passedRows[r - tileStartY] |= passed << (quadX - tileStartX);
+				context.statistics.fragmentsTested += CountQuadBits(coverage);
+				context.statistics.fragmentsPassed += CountQuadBits(passed);
+			}
+		}
+	}
+
+	//Layers & shading cost per pixel are only counted when they are asked for
+	const bool isCountingPixels = !context.pixelStatistics.layers.empty();
+	uint32_t* pLayers = isCountingPixels ? context.pixelStatistics.layers.data() : nullptr;
+	uint16_t* pShadingCost = isCountingPixels ? context.pixelStatistics.shadingCost.data() : nullptr;
+
+	//Transparent pixels are always shaded at full rate, a shared color would show as blocks in the blend
+	if (context.isTransparentPass)
+	{
+		const bool isReversed = context.pFrameBuffer->IsDepthReversed();
+		for (uint32_t r = startY; r < endY; ++r)
+		{
+			uint32_t passed = passedRows[r - tileStartY];
+			for (uint32_t localX = 0; passed != 0; ++localX, passed >>= 1)
+			{
+				if (!(passed & 1))
+					continue;
+
+				const uint32_t texel = localX + ((r - tileStartY) * tileSize);
+				const Vertex_Input& pixel = context.tilePixels[texel];
+				context.transparencyBuffer.AddPixel(tileStartX + localX, r, m_TextureTransparent.Sample(pixel.uv), alphas[texel],
+					isReversed ? 1.f - pixel.position.z : pixel.position.z);
+				++context.statistics.shadingInvocations;
+				if (isCountingPixels)
+				{
+					const uint32_t pixelIndex = (tileStartX + localX) + (r * context.renderWidth);
+					pLayers[pixelIndex] += 1 << 16;
+					pShadingCost[pixelIndex] += PixelStatistics::ShadingCostUnit;
+				}
+			}
+		}
+		return;
+	}
+
+	//Every block of the shading rate is shaded once, at its first pixel that passed
+	const uint32_t blockWidth = GetShadingRateWidth(rate);
+	const uint32_t blockHeight = GetShadingRateHeight(rate);
+	const uint16_t blockShadingCost = uint16_t(PixelStatistics::ShadingCostUnit / (blockWidth * blockHeight));
+	for (uint32_t blockY = startY - (startY % blockHeight); blockY < endY; blockY += blockHeight)
+	{
+		for (uint32_t blockX = startX - (startX % blockWidth); blockX < endX; blockX += blockWidth)
+		{
+			const uint32_t blockMask = ((1 << blockWidth) - 1) << (blockX - tileStartX);
+			const uint32_t blockEndY = std::min(blockY + blockHeight, endY);
+
+			uint32_t packedColor = 0;
+			bool isShaded = false;
+			for (uint32_t r = std::max(blockY, startY); r < blockEndY; ++r)
+			{
+				uint32_t passed = passedRows[r - tileStartY] & blockMask;
+				while (passed != 0)
+				{
+					uint32_t localX = 0;
+					while (!(passed & (1 << localX)))
+						++localX;
+					passed &= ~(1 << localX);
+
+					if (!isShaded)
+					{
+						packedColor = context.pFrameBuffer->PackColor(PixelShading(context.tilePixels[localX + ((r - tileStartY) * tileSize)], context.tint));
+						isShaded = true;
+						++context.statistics.shadingInvocations;
+					}
+					const uint32_t pixelIndex = (tileStartX + localX) + (r * context.renderWidth);
+					context.pRenderPixels[pixelIndex] = packedColor;
+					if (isCountingPixels)
+					{
+						++pLayers[pixelIndex];
+						pShadingCost[pixelIndex] += blockShadingCost;
+					}
+				}
+			}
+		}
+	}
+}
+
+void Elite::SoftwareBackend::ShadingRateStage(RasterContext& context) const
+{
+	ELITE_PROFILE_SCOPE("ShadingRateStage");
+	//The adaptive rate map for the next frame is built from the luminance of this one
+	if (context.shadingRateMode == ShadingRateMode::adaptive)
+		context.shadingRateMap.BuildFromLuminance(context.pRenderPixels, context.pFormat);
+}
+
+void Elite::SoftwareBackend::ResizeRenderTarget(uint32_t width, uint32_t height)
+{
+	m_Context.renderWidth = width;
+	m_Context.renderHeight = height;
+
+	//Native resolution renders straight into the back buffers, lower resolutions go through an intermediate buffer
+	std::vector<uint32_t*> colorBuffers{};
+	if (m_Context.renderWidth == m_Width && m_Context.renderHeight == m_Height)
+	{
+		m_RenderBuffer.clear();
+		m_RenderBuffer.shrink_to_fit();
+		for (SDL_Surface* pBackBuffer : m_pPresenter->GetBackBuffers())
+			colorBuffers.push_back((uint32_t*)pBackBuffer->pixels);
+		m_Context.pRenderPixels = colorBuffers.front();
+	}
+	else
+	{
+		m_RenderBuffer.resize(m_Context.renderWidth * m_Context.renderHeight);
+		m_Context.pRenderPixels = m_RenderBuffer.data();
+		colorBuffers.push_back(m_Context.pRenderPixels);
+	}
+
+	m_Context.pFormat = m_pPresenter->GetBackBuffers().front()->format;
+	m_Context.pFrameBuffer->SetFormat(m_Context.pFormat);
+	m_Context.pFrameBuffer->Resize(m_Context.renderWidth, m_Context.renderHeight, colorBuffers);
+
+	m_Context.transparencyBuffer.Resize(m_Context.renderWidth, m_Context.renderHeight);
+	m_Context.shadingRateMap.Resize(m_Context.renderWidth, m_Context.renderHeight);
+	if (m_Context.shadingRateMode == ShadingRateMode::fixed)
+		m_Context.shadingRateMap.Fill(ShadingRate::rate2x2);
+}
+
+void Elite::SoftwareBackend::UpscaleStage()
+{
+	ELITE_PROFILE_SCOPE("UpscaleStage");
+	if (m_RenderBuffer.empty())
+		return;
+
+	//Bilinear upscale in 16.16 fixed point, every 8 bit channel of the packed pixel is filtered separately
+	const uint32_t stepX = ((m_Context.renderWidth - 1) << 16) / std::max(m_Width - 1, uint32_t(1));
+	const uint32_t stepY = ((m_Context.renderHeight - 1) << 16) / std::max(m_Height - 1, uint32_t(1));
+
+	uint32_t srcY = 0;
+	for (uint32_t r = 0; r < m_Height; ++r, srcY += stepY)
+	{
+		const uint32_t y0 = srcY >> 16;
+		const uint32_t y1 = std::min(y0 + 1, m_Context.renderHeight - 1);
+		const uint32_t fy = (srcY >> 8) & 0xFF;
+		const uint32_t* pRow0 = m_Context.pRenderPixels + (y0 * m_Context.renderWidth);
+		const uint32_t* pRow1 = m_Context.pRenderPixels + (y1 * m_Context.renderWidth);
+		uint32_t* pDst = m_pBackBufferPixels + (r * m_Width);
+
+		uint32_t srcX = 0;
+		for (uint32_t c = 0; c < m_Width; ++c, srcX += stepX)
+		{
+			const uint32_t x0 = srcX >> 16;
+			const uint32_t x1 = std::min(x0 + 1, m_Context.renderWidth - 1);
+			const uint32_t fx = (srcX >> 8) & 0xFF;
+
+			const uint32_t p00 = pRow0[x0];
+			const uint32_t p01 = pRow0[x1];
+			const uint32_t p10 = pRow1[x0];
+			const uint32_t p11 = pRow1[x1];
+
+			uint32_t finalPixel = 0;
+			for (uint32_t shift = 0; shift < 32; shift += 8)
+			{
+				const uint32_t top = (((p00 >> shift) & 0xFF) * (256 - fx)) + (((p01 >> shift) & 0xFF) * fx);
+				const uint32_t bottom = (((p10 >> shift) & 0xFF) * (256 - fx)) + (((p11 >> shift) & 0xFF) * fx);
+				finalPixel |= (((top * (256 - fy)) + (bottom * fy)) >> 16) << shift;
+			}
+			pDst[c] = finalPixel;
+		}
+	}
+}
+
+bool Elite::SoftwareBackend::IsInTriangle(Elite::Vertex_Input& pointToHit, const std::vector<Elite::Vertex_Input>& ndcPoints, CullMode cull) const
+{
+	//Baycentric
+	Elite::FVector2 pointToSideA = FVector2((pointToHit.position - ndcPoints[0].position));
+	Elite::FVector2 pointToSideB = FVector2((pointToHit.position - ndcPoints[1].position));
+	Elite::FVector2 pointToSideC = FVector2((pointToHit.position - ndcPoints[2].position));
+
+	const Elite::FVector2 edgeA{ ndcPoints[1].position - ndcPoints[0].position };
+	const Elite::FVector2 edgeB{ ndcPoints[2].position - ndcPoints[1].position };
+	const Elite::FVector2 edgeC{ ndcPoints[0].position - ndcPoints[2].position };
+
+	float W0 = Elite::Cross(pointToSideB, edgeB);
+	float W1 = Elite::Cross(pointToSideC, edgeC);
+	float W2 = Elite::Cross(pointToSideA, edgeA);
+
+	//Cull mode
+	if (cull == CullMode::back)
+	{
+		if (W2 < 0 || W1 < 0 || W0 < 0)
+		{
+			return false;
+		}
+	}
+	else if (cull == CullMode::front)
+	{
+		if (W2 > 0 || W1 > 0 || W0 > 0)
+		{
+			return false;
+		}
+	}
+	else if (cull == CullMode::none)
+	{
+		if (!((W2 < 0 && W1 < 0 && W0 < 0) || (W2 > 0 && W1 > 0 && W0 > 0)))
+		{
+			return false;
+		}
+	}
+
+	//Interpolate between vertex values
+	W0 = abs(W0 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
+	W1 = abs(W1 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
+	W2 = abs(W2 / Elite::Cross(Elite::FVector2(ndcPoints[0].position - ndcPoints[1].position), edgeC));
+
+	auto interpolatedZ = (1 / (((1 / (ndcPoints[0].position.z)) * W0) + ((1 / (ndcPoints[1].position.z)) * W1) + ((1 / (ndcPoints[2].position.z)) * W2)));
+	pointToHit.position.z = interpolatedZ;
+
+	auto interpolatedW = (1 / (((1 / (ndcPoints[0].position.w)) * W0) + ((1 / (ndcPoints[1].position.w)) * W1) + ((1 / (ndcPoints[2].position.w)) * W2)));
+
+	pointToHit.uv = (((ndcPoints[0].uv / ndcPoints[0].position.w) * W0) + ((ndcPoints[1].uv / ndcPoints[1].position.w) * W1)
+		+ ((ndcPoints[2].uv / ndcPoints[2].position.w) * W2)) * interpolatedW;
+
+	pointToHit.normal = ndcPoints[0].normal * W0 + ndcPoints[1].normal * W1 + ndcPoints[2].normal * W2;
+	pointToHit.normal = GetNormalized(pointToHit.normal);
+
+	pointToHit.tangent = ndcPoints[0].tangent * W0 + ndcPoints[1].tangent * W1 + ndcPoints[2].tangent * W2;
+
+	pointToHit.viewDirection = ndcPoints[0].viewDirection * W0 + ndcPoints[1].viewDirection * W1 + ndcPoints[2].viewDirection * W2;
+	pointToHit.viewDirection = GetNormalized(pointToHit.viewDirection);
+	return true;
+}
+
+Elite::RGBColor Elite::SoftwareBackend::PixelShading(const Elite::Vertex_Input& v, const Elite::RGBColor& tint) const
+{
+	//Direction light, folded at compile time
+	constexpr FVector3 lightDir = { 0.577f, -0.577f, -0.577f };
+	constexpr FVector3 toLight = -lightDir;
+	constexpr Elite::RGBColor lightRadiance = Elite::RGBColor{ 1.f, 1.f, 1.f } * 7.f;
+
+	float observedArea{};
+
+	//Calculate normals in tangent space
+	Elite::RGBColor normalRgb = m_TextureNormal.Sample(v.uv);
+	Elite::FVector3 normal{ normalRgb.r, normalRgb.g, normalRgb.b };
+	Elite::FVector3 binormal = Cross(v.tangent, v.normal);
+	Elite::FMatrix3 tangentSpaceAxis = FMatrix3(v.tangent, binormal, v.normal);
+
+	normal.x = 2.f * normal.x - 1.f;
+	normal.y = 2.f * normal.y - 1.f;
+	normal.z = 2.f * normal.z - 1.f;
+
+	normal = tangentSpaceAxis * normal;
+	normal = GetNormalized(normal);
+
+	//Calculate cosine law
+	observedArea = Elite::Dot(normal, toLight);
+	observedArea = Clamp(observedArea, 0.f, 1.f);
+	observedArea /= float(M_PI);
+
+	//Calculate Phong
+	float shininess = 25.f;
+	auto phongColor = BRDF::Phong(m_TexureSpecularMap.Sample(v.uv), shininess * m_TextureGlossiness.Sample(v.uv).r, lightDir, v.viewDirection, v.normal);
+	auto diffuseColor = m_TextureDiffuse.Sample(v.uv) * tint;
+	auto ambientColor = Elite::RGBColor{ 0.025f, 0.025f, 0.025f };
+
+	diffuseColor += phongColor + ambientColor;
+	diffuseColor.MaxToOne();
+
+	auto finalColor = lightRadiance * diffuseColor * observedArea;
+	return finalColor;
+}
+
+void Elite::SoftwareBackend::ToggleResolutionGovernor()
+{
+	FinishFrame();
+	m_Governor.SetEnabled(!m_Governor.IsEnabled());
+	ResizeRenderTarget(m_Governor.GetWidth(), m_Governor.GetHeight());
+	if (m_Governor.IsEnabled())
+		std::cout << "Resolution governor: targeting " << int(1.f / m_Governor.GetTargetFrameTime()) << " FPS\n";
+	else
+		std::cout << "Resolution governor: back to native resolution\n";
+}
+
+void Elite::SoftwareBackend::ToggleShadingRate()
+{
+	FinishFrame();
+	if (m_Context.shadingRateMode == ShadingRateMode::full)
+	{
+		m_Context.shadingRateMode = ShadingRateMode::fixed;
+		m_Context.shadingRateMap.Fill(ShadingRate::rate2x2);
+		std::cout << "Shading rate: changed to fixed 2x2 shading\n";
+	}
+	else if (m_Context.shadingRateMode == ShadingRateMode::fixed)
+	{
+		m_Context.shadingRateMode = ShadingRateMode::adaptive;
+		std::cout << "Shading rate: changed to adaptive shading\n";
+	}
+	else if (m_Context.shadingRateMode == ShadingRateMode::adaptive)
+	{
+		m_Context.shadingRateMode = ShadingRateMode::full;
+		m_Context.shadingRateMap.Fill(ShadingRate::rate1x1);
+		std::cout << "Shading rate: changed to full rate shading\n";
+	}
+}
+
+void Elite::SoftwareBackend::SetShadingRateMode(ShadingRateMode shadingRateMode)
+{
+	FinishFrame();
+	//Adaptive rates start at full rate until the first frame was rendered
+	m_Context.shadingRateMode = shadingRateMode;
+	m_Context.shadingRateMap.Fill((shadingRateMode == ShadingRateMode::fixed) ? ShadingRate::rate2x2 : ShadingRate::rate1x1);
+}
+
+void Elite::SoftwareBackend::ToggleFrameLatency()
+{
+	FinishFrame();
+	//0 presents every frame while the next one renders, 1 & 2 keep that many more frames waiting
+	m_pPresenter->SetFrameLatency((m_pPresenter->GetRequestedFrameLatency() + 1) % 3);
+	m_pBackBuffer = m_pPresenter->GetBackBuffers().front();
+	m_pBackBufferPixels = (uint32_t*)m_pBackBuffer->pixels;
+	ResizeRenderTarget(m_Context.renderWidth, m_Context.renderHeight);
+	std::cout << "Frame latency: changed to " << m_pPresenter->GetRequestedFrameLatency() << " frame(s)";
+	if (m_pPresenter->GetFrameLatency() != m_pPresenter->GetRequestedFrameLatency())
+		std::cout << ", used once the present mode blits again";
+	std::cout << "\n";
+}
+
+void Elite::SoftwareBackend::TogglePresentMode()
+{
+	if (m_pPresenter->GetPresentMode() == PresentMode::blit)
+		SetPresentMode(PresentMode::windowSurface);
+	else
+		SetPresentMode(PresentMode::blit);
+
+	if (m_pPresenter->GetPresentMode() == PresentMode::windowSurface)
+		std::cout << "Present mode: changed to rendering into the window surface\n";
+	else
+		std::cout << "Present mode: changed to blitting to the window surface\n";
+}
+
+void Elite::SoftwareBackend::SetPresentMode(PresentMode presentMode)
+{
+	FinishFrame();
+	//Back buffers are recreated, the window surface can only be used when its format matches the rasterizer output
+	m_pPresenter->SetPresentMode(presentMode);
+	m_pBackBuffer = m_pPresenter->GetBackBuffers().front();
+	m_pBackBufferPixels = (uint32_t*)m_pBackBuffer->pixels;
+	ResizeRenderTarget(m_Context.renderWidth, m_Context.renderHeight);
+}
+
+void Elite::SoftwareBackend::ToggleDepthFormat()
+{
+	FinishFrame();
+	switch (m_Context.pFrameBuffer->GetDepthFormat())
+	{
+	case DepthFormat::float32:
+		m_Context.pFrameBuffer->SetDepthFormat(DepthFormat::reversedFloat32);
+		std::cout << "Depth format: changed to reversed-Z 32 bit float\n";
+		break;
+	case DepthFormat::reversedFloat32:
+		m_Context.pFrameBuffer->SetDepthFormat(DepthFormat::unorm24);
+		std::cout << "Depth format: changed to 24 bit unorm\n";
+		break;
+	case DepthFormat::unorm24:
+		m_Context.pFrameBuffer->SetDepthFormat(DepthFormat::unorm16);
+		std::cout << "Depth format: changed to 16 bit unorm\n";
+		break;
+	case DepthFormat::unorm16:
+		m_Context.pFrameBuffer->SetDepthFormat(DepthFormat::float32);
+		std::cout << "Depth format: changed to 32 bit float\n";
+		break;
+	}
+}
+
+void Elite::SoftwareBackend::ToggleMeshletOcclusion()
+{
+	FinishFrame();
+	m_Context.isMeshletOcclusion = !m_Context.isMeshletOcclusion;
+	if (m_Context.isMeshletOcclusion)
+		std::cout << "Meshlet occlusion: changed to testing meshlets against the depth buffer\n";
+	else
+		std::cout << "Meshlet occlusion: changed to only frustum & cone culling meshlets\n";
+}
+
+void Elite::SoftwareBackend::ToggleDebugView()
+{
+	switch (m_Context.debugView)
+	{
+	case DebugView::none:
+		SetDebugView(DebugView::overdraw);
+		break;
+	case DebugView::overdraw:
+		SetDebugView(DebugView::shadingCost);
+		break;
+	case DebugView::shadingCost:
+		SetDebugView(DebugView::none);
+		break;
+	}
+}
+
+void Elite::SoftwareBackend::SetDebugView(DebugView debugView)
+{
+	FinishFrame();
+	m_Context.debugView = debugView;
+	if (debugView == DebugView::overdraw)
+		std::cout << "Debug view: changed to overdraw heatmap\n";
+	else if (debugView == DebugView::shadingCost)
+		std::cout << "Debug view: changed to shading cost heatmap\n";
+	else
+		std::cout << "Debug view: changed to the shaded frame\n";
+}
+
+const uint32_t* Elite::SoftwareBackend::GetFramePixels()
+{
+	Flush();
+	const SDL_Surface* pLastFrame = m_pPresenter->GetLastFrame();
+	return pLastFrame ? (const uint32_t*)pLastFrame->pixels : nullptr;
+}
+
+bool Elite::SoftwareBackend::SaveFrame(const std::string& filePath)
+{
+	//Queued frames have to be finished before the last frame can be read
+	Flush();
+	return WriteImage(filePath, const_cast<SDL_Surface*>(m_pPresenter->GetLastFrame()));
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "RenderBackend.h"
+#include "Meshlet.h"
+#include "PackedVertex.h"
+#include "Texture.h"
+#include "FrameBuffer.h"
+#include "TransparencyBuffer.h"
+#include "FramePresenter.h"
+#include "ResolutionGovernor.h"
+#include "ShadingRateMap.h"
+#include "FrameStatistics.h"
+
+struct SDL_Window;
+struct SDL_Surface;
+struct SDL_PixelFormat;
+
+namespace Elite
+{
+	//Everything a software frame writes to, every thread that renders needs its own
+	struct RasterContext
+	{
+		FrameBuffer* pFrameBuffer;
+		uint32_t* pRenderPixels;
+		uint32_t renderWidth;
+		uint32_t renderHeight;
+		const SDL_PixelFormat* pFormat;
+
+		ShadingRateMap shadingRateMap;
+		ShadingRateMode shadingRateMode;
+
+		FMatrix4 worldToView;
+		FMatrix4 projection;
+		FMatrix4 world;
+		std::vector<InstanceData> instances;
+		CullMode cull;
+
+		//Meshlets are tested against the depth that is already drawn before they are transformed
+		bool isMeshletOcclusion;
+
+		//Transparent meshes are drawn last, into the transparency buffer, & composited over the opaque pixels
+		bool renderTransparent;
+		bool isTransparentPass;
+		TransparencyBuffer transparencyBuffer;
+
+		//Instance that is being rasterized, the camera & frustum planes are in its model space for meshlet culling
+		FMatrix4 instanceWorld;
+		FMatrix4 instanceClip;
+		//Same as instanceClip, but with reversed depth its z row is the w row minus the z row, so projected z already is w - z
+		FMatrix4 depthClip;
+		FPoint3 modelCamera;
+		float modelPlanes[6][4];
+		RGBColor tint;
+
+		//Holds one meshlet at a time
+		std::vector<Vertex_Input> transformedVertices;
+		//Interpolated pixels of the tile that is being rasterized
+		std::vector<Vertex_Input> tilePixels;
+
+		//Counted by every stage & started over every frame
+		//Per pixel counts are only kept with pixel statistics or a debug view, the view replaces the shaded frame
+		FrameStatistics statistics;
+		bool isPixelStatistics;
+		DebugView debugView;
+		PixelStatistics pixelStatistics;
+	};
+
+	//CPU rasterizer, needs no graphics device and presents through SDL surfaces (or not at all when headless)
+	//Blitted frames are rendered on a render thread, so the calling thread presents frame N while frame N + 1 is rendered
+	class SoftwareBackend final : public RenderBackend
+	{
+	public:
+		SoftwareBackend(SDL_Window* pWindow, uint32_t width, uint32_t height);
+		~SoftwareBackend();
+
+		void AddMesh(const MeshData& mesh) override;
+		void SetCamera(Camera* pCamera) override { m_pCamera = pCamera; };
+
+		void Update(float dT, const PipelineState& state) override;
+		void Render(const PipelineState& state) override;
+		void Flush() override;
+
+		void ToggleResolutionGovernor();
+		void ToggleShadingRate();
+		void ToggleFrameLatency();
+		void TogglePresentMode();
+		void ToggleDepthFormat();
+		void ToggleMeshletOcclusion();
+		void ToggleDebugView();
+		void SetPresentMode(PresentMode presentMode);
+		void SetDebugView(DebugView debugView);
+		void SetShadingRateMode(ShadingRateMode shadingRateMode);
+		void SetDepthFormat(DepthFormat depthFormat) { FinishFrame(); m_Context.pFrameBuffer->SetDepthFormat(depthFormat); };
+		void SetPixelStatistics(bool isEnabled) { FinishFrame(); m_Context.isPixelStatistics = isEnabled; };
+
+		//Counters of the last finished frame
+		const FrameStatistics& GetFrameStatistics() const { return m_FrameStatistics; };
+
+		uint32_t GetRenderWidth() const { return m_Context.renderWidth; };
+		uint32_t GetRenderHeight() const { return m_Context.renderHeight; };
+
+		//World to clip space of the rasterizer, also the frustum objects have to be culled against
+		static FMatrix4 GetClipMatrix(const FMatrix4& worldToView, const FMatrix4& projection, const FMatrix4& world);
+
+		//Renders the meshes into the context, only reads the meshes & textures so it can run on several threads at once
+		void RenderFrame(RasterContext& context) const;
+
+		//Last finished frame in the back buffer format, no copy is made
+		//Waits for the frame that is being rendered & presents every queued frame first
+		const uint32_t* GetFramePixels();
+		bool SaveFrame(const std::string& filePath);
+
+		//Coverage & interpolation of one pixel & its shading, public so the microbenchmarks can time them on their own
+		bool IsInTriangle(Vertex_Input& pointToHit, const std::vector<Vertex_Input>& ndcPoints, CullMode cull) const;
+		RGBColor PixelShading(const Vertex_Input& v, const RGBColor& tint) const;
+
+	private:
+		uint32_t m_Width;
+		uint32_t m_Height;
+
+		FramePresenter* m_pPresenter;
+		SDL_Surface* m_pBackBuffer;
+		uint32_t* m_pBackBufferPixels;
+
+		//Internal render resolution, can be lower than the window when the governor is active
+		//Updates without a frame rendered since the last one are idle time, the governor never sees them
+		ResolutionGovernor m_Governor;
+		std::vector<uint32_t> m_RenderBuffer;
+		bool m_HasRenderedFrame;
+
+		//Interactive frame, renders into the back buffers or the intermediate render buffer
+		//While the render thread works on it only that thread touches it, every other member function waits for the frame first
+		RasterContext m_Context;
+		FrameStatistics m_FrameStatistics;
+
+		//Started by the first blitted frame, renders one frame at a time into m_pRenderingBuffer
+		std::thread m_RenderThread;
+		std::mutex m_RenderMutex;
+		std::condition_variable m_RenderCondition;
+		SDL_Surface* m_pRenderingBuffer;
+		bool m_IsFrameRequested;
+		bool m_IsQuitting;
+
+		void RenderLoop();
+		//Waits for the render thread & queues its frame, the frame is presented by the next Render or Flush
+		void FinishFrame();
+
+		void InstanceStage(RasterContext& context, const InstanceData& instance) const;
+		bool IsMeshletVisible(const RasterContext& context, const Meshlet& meshlet) const;
+		void ProjectionStage(RasterContext& context, const std::vector<PackedVertex>& vertices, const VertexQuantization& quantization, const MeshletMesh& meshlets, const Meshlet& meshlet) const;
+		void RasterizerStage(RasterContext& context, const MeshletMesh& meshlets, const Meshlet& meshlet) const;
+		void ShadeTile(RasterContext& context, const std::vector<Vertex_Input>& ndcVertices, uint32_t tileX, uint32_t tileY, uint32_t startX, uint32_t startY, uint32_t endX, uint32_t endY, ShadingRate rate) const;
+		void ShadingRateStage(RasterContext& context) const;
+		void ResizeRenderTarget(uint32_t width, uint32_t height);
+		void UpscaleStage();
+
+		//Every level of detail holds all opaque meshes, split into meshlets
+		//The float vertices are only kept to rebuild the meshlets, frames decode the packed ones
+		std::vector<MeshLOD> m_Lods;
+		std::vector<MeshletMesh> m_Meshlets;
+		PackedMesh m_PackedLods;
+
+		//All transparent meshes, they are only drawn at full detail
+		MeshLOD m_TransparentMesh;
+		MeshletMesh m_TransparentMeshlets;
+		PackedMesh m_PackedTransparentMesh;
+
+		//Textures
+		Texture m_TextureDiffuse;
+		Texture m_TextureNormal;
+		Texture m_TexureSpecularMap;
+		Texture m_TextureGlossiness;
+		Texture m_TextureTransparent;
+
+		//Camera
+		Camera* m_pCamera;
+	};
+}
@@ -1,8 +1,9 @@
 #include "pch.h"
 #include "Texture.h"
 #include <iostream>
-#include "Effect.h"
 
+#ifdef ELITE_BACKEND_DX11
+#include "Effect.h"
 
 Elite::Texture::Texture(ID3D11Device* pDevice, const char* filePath)
 {
@@ -38,6 +39,7 @@ Elite::Texture::Texture(ID3D11Device* pDevice, const char* filePath)
 
 	SDL_FreeSurface(pSurface);
 }
+#endif
 
 Elite::Texture::Texture(const char* filePath)
 {
@@ -47,6 +49,7 @@ Elite::Texture::Texture(const char* filePath)
 
 Elite::Texture::~Texture()
 {
+#ifdef ELITE_BACKEND_DX11
 	if (m_pTextureResourceView)
 	{
 		m_pTextureResourceView->Release();
@@ -55,6 +58,7 @@ Elite::Texture::~Texture()
 	{
 		m_pDX11Texture->Release();
 	}
+#endif
 
 	if (m_pSRASTexture)
 	{
@@ -62,21 +66,27 @@ Elite::Texture::~Texture()
 	}
 }
 
-Elite::RGBColor Elite::Texture::Sample(const Elite::FVector2& uv) const
+Uint32 Elite::Texture::GetTexel(const Elite::FVector2& uv) const
 {
 	Elite::FVector2 convertedUv{};
 	convertedUv.x = uv.x * m_pSRASTexture->w;
 	convertedUv.y = (uv.y) * m_pSRASTexture->h;
+
+	Uint32 pixelCoord = Uint32(roundf(convertedUv.x)) + Uint32((roundf(convertedUv.y) * m_pSRASTexture->w));
+	pixelCoord = Clamp(pixelCoord, Uint32(0), Uint32(m_pSRASTexture->w * m_pSRASTexture->h));
+
+	return static_cast<Uint32*>(m_pSRASTexture->pixels)[pixelCoord];
+}
+
+Elite::RGBColor Elite::Texture::Sample(const Elite::FVector2& uv) const
+{
 	Elite::RGBColor finalColor;
 
 	Uint8 r{};
 	Uint8 g{};
 	Uint8 b{};
 
-	Uint32 pixelCoord = Uint32(roundf(convertedUv.x)) + Uint32((roundf(convertedUv.y) * m_pSRASTexture->w));
-	pixelCoord = Clamp(pixelCoord, Uint32(0), Uint32(m_pSRASTexture->w * m_pSRASTexture->h));
-
-	SDL_GetRGB(static_cast<Uint32*>(m_pSRASTexture->pixels)[pixelCoord], m_pSRASTexture->format, &r, &g, &b);
+	SDL_GetRGB(GetTexel(uv), m_pSRASTexture->format, &r, &g, &b);
 
 	finalColor.r = static_cast<float>(float(r)) / 255.f;
 	finalColor.g = static_cast<float>(float(g)) / 255.f;
@@ -84,3 +94,14 @@ Elite::RGBColor Elite::Texture::Sample(const Elite::FVector2& uv) const
 
 	return finalColor;
 }
+
+float Elite::Texture::SampleAlpha(const Elite::FVector2& uv) const
+{
+	Uint8 r{};
+	Uint8 g{};
+	Uint8 b{};
+	Uint8 a{};
+
+	SDL_GetRGBA(GetTexel(uv), m_pSRASTexture->format, &r, &g, &b, &a);
+	return float(a) / 255.f;
+}
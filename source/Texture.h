@@ -9,18 +9,31 @@ namespace Elite
 	class Texture
 	{
 	public:
+#ifdef ELITE_BACKEND_DX11
 		Texture(ID3D11Device* pDevice, const char* filePath);
+#endif
 		Texture(const char* filePath);
 		~Texture();
 
 		Elite::RGBColor Sample(const Elite::FVector2& uv) const;
+		//Opacity of the texel, 1 for textures without an alpha channel
+		float SampleAlpha(const Elite::FVector2& uv) const;
 
+		uint32_t GetWidth() const { return m_pSRASTexture ? uint32_t(m_pSRASTexture->w) : 0; };
+		uint32_t GetHeight() const { return m_pSRASTexture ? uint32_t(m_pSRASTexture->h) : 0; };
+
+#ifdef ELITE_BACKEND_DX11
 		ID3D11ShaderResourceView* GetResourceView() { return m_pTextureResourceView; };
+#endif
 
 	private:
+		Uint32 GetTexel(const Elite::FVector2& uv) const;
+
+#ifdef ELITE_BACKEND_DX11
 		//Directx11
 		ID3D11Texture2D* m_pDX11Texture = nullptr;
 		ID3D11ShaderResourceView* m_pTextureResourceView = nullptr;
+#endif
 
 		//SRAS
 		SDL_Surface* m_pSRASTexture = nullptr;
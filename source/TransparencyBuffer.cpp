@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "TransparencyBuffer.h"
+
+Elite::TransparencyBuffer::TransparencyBuffer()
+	: m_Width{}
+	, m_Height{}
+	, m_TilesX{}
+	, m_TilesY{}
+	, m_FrameEpoch{}
+{
+}
+
+void Elite::TransparencyBuffer::Resize(uint32_t width, uint32_t height)
+{
+	m_Width = width;
+	m_Height = height;
+	m_TilesX = (width + FrameBuffer::TileSize - 1) / FrameBuffer::TileSize;
+	m_TilesY = (height + FrameBuffer::TileSize - 1) / FrameBuffer::TileSize;
+	m_Texels.resize(size_t(m_Width) * m_Height);
+
+	m_FrameEpoch = 0;
+	m_TileEpochs.assign(m_TilesX * m_TilesY, 0);
+	m_TouchedTiles.clear();
+}
+
+void Elite::TransparencyBuffer::Clear()
+{
+	m_TouchedTiles.clear();
+
+	//Epoch 0 is reserved for "never touched"
+	++m_FrameEpoch;
+	if (m_FrameEpoch == 0)
+	{
+		std::fill(m_TileEpochs.begin(), m_TileEpochs.end(), 0);
+		m_FrameEpoch = 1;
+	}
+}
+
+void Elite::TransparencyBuffer::InitializeTile(uint32_t tileIndex)
+{
+	m_TileEpochs[tileIndex] = m_FrameEpoch;
+	m_TouchedTiles.push_back(tileIndex);
+
+	const uint32_t startX = (tileIndex % m_TilesX) * FrameBuffer::TileSize;
+	const uint32_t startY = (tileIndex / m_TilesX) * FrameBuffer::TileSize;
+	const uint32_t endX = std::min(startX + FrameBuffer::TileSize, m_Width);
+	const uint32_t endY = std::min(startY + FrameBuffer::TileSize, m_Height);
+
+	for (uint32_t r = startY; r < endY; ++r)
+		std::fill(m_Texels.begin() + (startX + (r * m_Width)), m_Texels.begin() + (endX + (r * m_Width)), Texel{ RGBColor{ 0.f, 0.f, 0.f }, 0.f, 1.f });
+}
+
+void Elite::TransparencyBuffer::Composite(const FrameBuffer& frameBuffer) const
+{
+	uint32_t* pColors = frameBuffer.GetColorBuffer();
+	for (uint32_t tileIndex : m_TouchedTiles)
+	{
+		const uint32_t startX = (tileIndex % m_TilesX) * FrameBuffer::TileSize;
+		const uint32_t startY = (tileIndex / m_TilesX) * FrameBuffer::TileSize;
+		const uint32_t endX = std::min(startX + FrameBuffer::TileSize, m_Width);
+		const uint32_t endY = std::min(startY + FrameBuffer::TileSize, m_Height);
+
+		for (uint32_t r = startY; r < endY; ++r)
+		{
+			for (uint32_t c = startX; c < endX; ++c)
+			{
+				const Texel& texel = m_Texels[c + (r * m_Width)];
+				if (texel.revealage >= 1.f || texel.weight <= 0.f)
+					continue;
+
+				uint32_t& pixel = pColors[c + (r * m_Width)];
+				const RGBColor average = texel.color / texel.weight;
+				pixel = frameBuffer.PackColor(average * (1.f - texel.revealage) + frameBuffer.UnpackColor(pixel) * texel.revealage);
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ERGBColor.h"
+#include "FrameBuffer.h"
+
+namespace Elite
+{
+	//Weighted blended order independent transparency: transparent pixels are summed in any order, weighted by how close they are,
+	//& composited over the opaque color in one pass once every transparent triangle is drawn, so nothing has to be sorted
+	class TransparencyBuffer final
+	{
+	public:
+		TransparencyBuffer();
+		~TransparencyBuffer() = default;
+
+		TransparencyBuffer(const TransparencyBuffer&) = delete;
+		TransparencyBuffer(TransparencyBuffer&&) noexcept = delete;
+		TransparencyBuffer& operator=(const TransparencyBuffer&) = delete;
+		TransparencyBuffer& operator=(TransparencyBuffer&&) noexcept = delete;
+
+		//Uses the tiles of the frame buffer
+		void Resize(uint32_t width, uint32_t height);
+
+		//Starts a new frame, only tiles that get a transparent pixel are cleared & composited
+		void Clear();
+
+		//Has to be called before a transparent pixel is added to a tile
+		inline void TouchTile(uint32_t tileX, uint32_t tileY)
+		{
+			const uint32_t tileIndex = tileX + (tileY * m_TilesX);
+			if (m_TileEpochs[tileIndex] != m_FrameEpoch)
+				InitializeTile(tileIndex);
+		}
+
+		//Color is not premultiplied, depth is 0 at the near plane & 1 at the far plane
+		inline void AddPixel(uint32_t x, uint32_t y, const RGBColor& color, float alpha, float depth)
+		{
+			//Closer pixels weigh more, so the front of a stack of layers wins the average
+			const float distance = 1.f - depth;
+			const float weight = alpha * std::max(1e-2f, 3e3f * distance * distance * distance);
+
+			Texel& texel = m_Texels[x + (y * m_Width)];
+			texel.color += color * (alpha * weight);
+			texel.weight += alpha * weight;
+			texel.revealage *= 1.f - alpha;
+		}
+
+		//Blends the weighted average transparent color over the color buffer of the frame buffer,
+		//by how much of the opaque pixel all transparent layers together still let through
+		void Composite(const FrameBuffer& frameBuffer) const;
+
+	private:
+		struct Texel
+		{
+			RGBColor color;
+			float weight;
+			float revealage;
+		};
+
+		void InitializeTile(uint32_t tileIndex);
+
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_TilesX;
+		uint32_t m_TilesY;
+		std::vector<Texel> m_Texels;
+
+		//Same scheme as the frame buffer, tiles whose epoch differs from the frame epoch hold no transparent pixels
+		uint32_t m_FrameEpoch;
+		std::vector<uint32_t> m_TileEpochs;
+		std::vector<uint32_t> m_TouchedTiles;
+	};
+}
@@ -3,10 +3,20 @@
 
 //Standard includes
 #include <iostream>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <fstream>
 
 //Project includes
 #include "ETimer.h"
 #include "ERenderer.h"
+#include "ImageWriter.h"
+#include "BatchRenderer.h"
+#include "Microbench.h"
+#include "Profiler.h"
+#include "FrameStatistics.h"
+#include "Benchmark.h"
 
 #ifdef _DEBUG
 	#include <vld.h>
@@ -19,11 +29,374 @@ void ShutDown(SDL_Window* pWindow)
 	SDL_Quit();
 }
 
-int main(int argc, char* args[])
+bool HasArgument(int argc, char* args[], const char* name)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(args[i], name) == 0)
+			return true;
+	}
+	return false;
+}
+
+//Returns the value that follows the argument, offset picks later values for arguments that take more than one
+const char* GetArgumentValue(int argc, char* args[], const char* name, int offset = 0)
+{
+	for (int i = 1; i < argc - 1 - offset; ++i)
+	{
+		if (strcmp(args[i], name) == 0)
+			return args[i + 1 + offset];
+	}
+	return nullptr;
+}
+
+float GetArgumentFloat(int argc, char* args[], const char* name, float defaultValue, int offset = 0)
+{
+	const char* pValue = GetArgumentValue(argc, args, name, offset);
+	return pValue ? float(atof(pValue)) : defaultValue;
+}
+
+uint32_t GetArgumentUInt(int argc, char* args[], const char* name, uint32_t defaultValue)
+{
+	const char* pValue = GetArgumentValue(argc, args, name);
+	return pValue ? uint32_t(strtoul(pValue, nullptr, 10)) : defaultValue;
+}
+
+//Prints the statistics of every zone recorded so far & writes them as a Chrome trace
+void WriteProfile(const std::string& filePath)
+{
+#ifdef ELITE_PROFILING
+	Elite::PrintProfileStatistics(std::cout);
+	Elite::WriteProfileTrace(filePath);
+#else
+	std::cout << "Profiler: built without ELITE_PROFILING, nothing was recorded for " << filePath << "\n";
+#endif
+}
+
+//Starts a CSV with one row of counters per rendered frame
+bool OpenStatisticsFile(std::ofstream& file, const std::string& filePath)
+{
+	file.open(filePath);
+	if (!file)
+	{
+		std::cout << "Statistics: could not write " << filePath << "\n";
+		return false;
+	}
+	Elite::WriteFrameStatisticsHeader(file);
+	return true;
+}
+
+void PrintFrameStatistics(const char* pLabel, const Elite::FrameStatistics& statistics)
+{
+	std::cout << "Statistics: " << pLabel << " rasterized " << statistics.trianglesRasterized << " of " << statistics.trianglesTested << " triangle(s) ("
+		<< statistics.trianglesFrustumCulled << " frustum & " << statistics.trianglesBackFaceCulled << " back-face culled), "
+		<< statistics.fragmentsPassed << " of " << statistics.fragmentsTested << " fragment(s) passed the depth test";
+	if (statistics.pixelsCovered > 0)
+		std::cout << ", " << statistics.fragmentsOverwritten << " overwritten, average overdraw " << statistics.GetAverageOverdraw();
+	std::cout << "\n";
+}
+
+//Rows of instances that move away from the camera, every instance gets its own tint
+std::vector<Elite::InstanceData> MakeInstanceGrid(uint32_t amount, float spacing = 45.f)
+{
+	std::vector<Elite::InstanceData> instances{};
+	if (amount <= 1)
+		return instances;
+
+	const uint32_t columns = uint32_t(ceilf(sqrtf(float(amount))));
+	for (uint32_t i = 0; i < amount; ++i)
+	{
+		Elite::FMatrix4 world = Elite::FMatrix4::Identity();
+		world[3].x = (float(i % columns) - (float(columns - 1) * 0.5f)) * spacing;
+		world[3].z = -float(i / columns) * spacing;
+
+		const float hue = 2.f * float(E_PI) * float(i) / float(amount);
+		const Elite::RGBColor tint{ 0.75f + 0.25f * cosf(hue), 0.75f + 0.25f * cosf(hue - 2.094f), 0.75f + 0.25f * cosf(hue + 2.094f) };
+		instances.push_back({ world, tint, 0 });
+	}
+	return instances;
+}
+
+//Renders the software rasterizer without window or DirectX device
+//--headless [--width 640] [--height 480] [--frames 1] [--output frame.ppm] [--camera x y z] [--fov 45] [--rotate] [--instances 1] [--fire] [--profile trace.json]
+//	[--stats statistics.csv] [--heatmap overdraw|shading]
+int RunHeadless(int argc, char* args[])
+{
+	SDL_Init(0);
+
+	const uint32_t width = GetArgumentUInt(argc, args, "--width", 640);
+	const uint32_t height = GetArgumentUInt(argc, args, "--height", 480);
+	const uint32_t amountOfFrames = GetArgumentUInt(argc, args, "--frames", 1);
+	const char* pOutput = GetArgumentValue(argc, args, "--output");
+	const std::string output = pOutput ? pOutput : "frame.ppm";
+
+	const Elite::FPoint3 cameraPosition{ GetArgumentFloat(argc, args, "--camera", 0.f, 0),
+		GetArgumentFloat(argc, args, "--camera", 0.f, 1), GetArgumentFloat(argc, args, "--camera", 0.f, 2) };
+	const float fov = GetArgumentFloat(argc, args, "--fov", 45.f);
+
+	auto pRenderer{ std::make_unique<Elite::Renderer>(nullptr, width, height) };
+	Elite::Camera* pCamera = new Elite::Camera(float(width) / float(height), cameraPosition, { 0.f, 0.f, -1.f }, fov);
+	pRenderer->SetCamera(pCamera);
+	pRenderer->SetInstances(MakeInstanceGrid(GetArgumentUInt(argc, args, "--instances", 1)));
+	if (HasArgument(argc, args, "--rotate"))
+		pRenderer->ToggleRotation();
+	if (HasArgument(argc, args, "--fire"))
+		pRenderer->ToggleFireMesh();
+	if (const char* pHeatmap = GetArgumentValue(argc, args, "--heatmap"))
+		pRenderer->SetDebugView((strcmp(pHeatmap, "shading") == 0) ? Elite::DebugView::shadingCost : Elite::DebugView::overdraw);
+
+	const char* pStatistics = GetArgumentValue(argc, args, "--stats");
+	std::ofstream statisticsFile{};
+	if (pStatistics && OpenStatisticsFile(statisticsFile, pStatistics))
+		pRenderer->SetPixelStatistics(true);
+
+	//Frames advance at a fixed rate so every run produces the same images
+	//Frames where nothing changed are not rendered again, the last one is saved in their place
+	const float frameTime = 1.f / 60.f;
+	uint32_t amountOfUnchangedFrames = 0;
+	int result = 0;
+	for (uint32_t frame = 0; frame < amountOfFrames; ++frame)
+	{
+		if (!pRenderer->Render())
+			++amountOfUnchangedFrames;
+		else if (statisticsFile.is_open())
+			Elite::WriteFrameStatistics(statisticsFile, frame, pRenderer->GetFrameStatistics());
+		pRenderer->Update(frameTime);
+
+		const std::string filePath = (amountOfFrames > 1) ? Elite::GetNumberedFilePath(output, frame) : output;
+		if (!pRenderer->SaveFrame(filePath))
+			result = 1;
+	}
+	std::cout << "Headless: rendered " << amountOfFrames << " frame(s) (" << amountOfUnchangedFrames << " unchanged) at " << width << "x" << height
+		<< ", " << pRenderer->GetAmountOfVisibleObjects() << " of " << pRenderer->GetScene().GetAmountOfNodes() << " object(s) visible\n";
+	if (statisticsFile.is_open())
+	{
+		PrintFrameStatistics("last frame", pRenderer->GetFrameStatistics());
+		std::cout << "Statistics: wrote " << (amountOfFrames - amountOfUnchangedFrames) << " frame(s) to " << pStatistics << "\n";
+	}
+	if (const char* pProfile = GetArgumentValue(argc, args, "--profile"))
+		WriteProfile(pProfile);
+
+	pRenderer.reset();
+	delete pCamera;
+	pCamera = nullptr;
+	SDL_Quit();
+	return result;
+}
+
+//Renders a turntable of the software rasterizer on every core, frames are written in order
+//--batch [--threads 0] [--width 640] [--height 480] [--frames 360] [--output frame.ppm] [--camera x y z] [--fov 45] [--instances 1] [--fire] [--profile trace.json]
+//	[--stats statistics.csv]
+int RunBatch(int argc, char* args[])
+{
+	SDL_Init(0);
+
+	const uint32_t width = GetArgumentUInt(argc, args, "--width", 640);
+	const uint32_t height = GetArgumentUInt(argc, args, "--height", 480);
+	const uint32_t amountOfFrames = std::max(GetArgumentUInt(argc, args, "--frames", 360), 1u);
+	const uint32_t amountOfThreads = GetArgumentUInt(argc, args, "--threads", 0);
+	const char* pOutput = GetArgumentValue(argc, args, "--output");
+	const std::string output = pOutput ? pOutput : "frame.ppm";
+
+	const Elite::FPoint3 cameraPosition{ GetArgumentFloat(argc, args, "--camera", 0.f, 0),
+		GetArgumentFloat(argc, args, "--camera", 0.f, 1), GetArgumentFloat(argc, args, "--camera", 0.f, 2) };
+	const float fov = GetArgumentFloat(argc, args, "--fov", 45.f);
+
+	auto pRenderer{ std::make_unique<Elite::Renderer>(nullptr, width, height) };
+	Elite::Camera* pCamera = new Elite::Camera(float(width) / float(height), cameraPosition, { 0.f, 0.f, -1.f }, fov);
+	pRenderer->SetInstances(MakeInstanceGrid(GetArgumentUInt(argc, args, "--instances", 1)));
+	if (HasArgument(argc, args, "--fire"))
+		pRenderer->ToggleFireMesh();
+
+	//One full rotation of the world over all frames
+	const Elite::PipelineState& state = pRenderer->GetPipelineState();
+	std::vector<Elite::RenderJob> jobs{};
+	for (uint32_t frame = 0; frame < amountOfFrames; ++frame)
+	{
+		Elite::FMatrix4 world = state.world;
+		Elite::FMatrix4 rotation = Elite::MakeRotationY(2.f * float(E_PI) * float(frame) / float(amountOfFrames));
+		world[0] = rotation[0];
+		world[1] = rotation[1];
+		world[2] = rotation[2];
+		jobs.push_back({ pCamera->GetWorldToView(), pCamera->GetProjectionMatrix(), world, {}, state.cull, Elite::ShadingRateMode::full, Elite::DepthFormat::float32, state.renderTransparent });
+
+		//Every pose gets its own culling pass
+		pRenderer->CullScene(Elite::SoftwareBackend::GetClipMatrix(jobs.back().worldToView, jobs.back().projection, world), float(height), jobs.back().instances);
+	}
+
+	Elite::BatchRenderer batchRenderer{ pRenderer->GetSoftwareBackend(), width, height, amountOfThreads };
+	const char* pStatistics = GetArgumentValue(argc, args, "--stats");
+	std::ofstream statisticsFile{};
+	if (pStatistics && OpenStatisticsFile(statisticsFile, pStatistics))
+		batchRenderer.SetPixelStatistics(true);
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	//The counters of every thread's frames are added up over the whole batch
+	int result = 0;
+	Elite::FrameStatistics totalStatistics{};
+	batchRenderer.Render(jobs, [&](uint32_t jobIndex, SDL_Surface* pFrame, const Elite::FrameStatistics& statistics)
+	{
+		totalStatistics += statistics;
+		if (statisticsFile.is_open())
+			Elite::WriteFrameStatistics(statisticsFile, jobIndex, statistics);
+
+		const std::string filePath = (amountOfFrames > 1) ? Elite::GetNumberedFilePath(output, jobIndex) : output;
+		if (!Elite::WriteImage(filePath, pFrame))
+			result = 1;
+	});
+
+	const float seconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count();
+	std::cout << "Batch: rendered " << amountOfFrames << " frame(s) at " << width << "x" << height << " on " << batchRenderer.GetAmountOfThreads()
+		<< " thread(s) in " << seconds << "s (" << float(amountOfFrames) / seconds << " FPS)\n";
+	PrintFrameStatistics("all frames", totalStatistics);
+	if (statisticsFile.is_open())
+		std::cout << "Statistics: wrote " << amountOfFrames << " frame(s) to " << pStatistics << "\n";
+	if (const char* pProfile = GetArgumentValue(argc, args, "--profile"))
+		WriteProfile(pProfile);
+
+	pRenderer.reset();
+	delete pCamera;
+	pCamera = nullptr;
+	SDL_Quit();
+	return result;
+}
+
+//Replays the camera & rotation paths of a settings file at a fixed timestep & writes the measurements as JSON
+//Per stage times are the self times of the profiler zones, so without ELITE_PROFILING (the Profile configuration) it refuses to run
+//Returns 1 when the comparison with the baseline found a regression
+//--benchmark [settings.txt] [--output benchmark.json] [--compare baseline.json] [--threshold 0.05] [--image frame.ppm]
+int RunBenchmark(int argc, char* args[])
 {
-	//Unreferenced parameters
+#ifndef ELITE_PROFILING
 	(void)argc;
 	(void)args;
+	std::cout << "Benchmark: built without ELITE_PROFILING, the stages cannot be timed, build the Profile configuration\n";
+	return 1;
+#else
+	const char* pSettings = GetArgumentValue(argc, args, "--benchmark");
+	const std::string settingsPath = (pSettings && strncmp(pSettings, "--", 2) != 0) ? pSettings : "Resources/benchmark.txt";
+	Elite::BenchmarkSettings settings{};
+	if (!Elite::LoadBenchmarkSettings(settingsPath, settings))
+		return 1;
+
+	Elite::BenchmarkResult baseline{};
+	const char* pCompare = GetArgumentValue(argc, args, "--compare");
+	if (pCompare && !Elite::ReadBenchmarkResult(pCompare, baseline))
+		return 1;
+
+	SDL_Init(0);
+
+	auto pRenderer{ std::make_unique<Elite::Renderer>(nullptr, settings.width, settings.height) };
+	Elite::Camera* pCamera = new Elite::Camera(float(settings.width) / float(settings.height), { 0.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, settings.fov);
+	pRenderer->SetCamera(pCamera);
+	pRenderer->SetInstances(MakeInstanceGrid(settings.instances));
+	if (settings.renderTransparent)
+		pRenderer->ToggleFireMesh();
+	if (!settings.isOcclusionCulling)
+		pRenderer->ToggleOcclusionCulling();
+	if (!settings.isMeshletOcclusion)
+		pRenderer->ToggleMeshletOcclusion();
+	pRenderer->SetShadingRateMode(settings.shadingRateMode);
+	pRenderer->SetDepthFormat(settings.depthFormat);
+
+	Elite::BenchmarkResult result{};
+	result.settingsPath = settingsPath;
+	result.settingsHash = settings.hash;
+	result.width = settings.width;
+	result.height = settings.height;
+	result.imageHash = Elite::HashSeed;
+	result.isProfiled = true;
+
+	//Warmup frames render the first pose, every frame is rendered in full & the poses follow each other in the same order every run
+	for (uint32_t frame = 0; frame < settings.warmupFrames + settings.frames; ++frame)
+	{
+		const bool isMeasured = (frame >= settings.warmupFrames);
+		const float time = isMeasured ? float(frame - settings.warmupFrames) * settings.timestep : 0.f;
+		const Elite::CameraKey pose = Elite::GetCameraPose(settings.cameraPath, time);
+		pCamera->SetPose(pose.position, pose.pitch, pose.yaw);
+		pRenderer->SetWorldRotation(Elite::GetWorldRotation(settings.rotationPath, time) * float(E_TO_RADIANS));
+		pRenderer->Invalidate();
+
+		Elite::ClearProfile();
+		const auto start = std::chrono::steady_clock::now();
+		pRenderer->Render();
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (!isMeasured)
+			continue;
+
+		result.frameTimes.push_back(milliseconds);
+		result.statistics += pRenderer->GetFrameStatistics();
+		result.imageHash = Elite::HashBytes(pRenderer->GetFramePixels(), size_t(settings.width) * settings.height * sizeof(uint32_t), result.imageHash);
+
+		//Stages that did not run in a frame took no time in it
+		const size_t measuredFrame = result.frameTimes.size() - 1;
+		for (const Elite::ProfileZoneStatistics& zone : Elite::GetProfileStatistics())
+		{
+			std::vector<double>& times = result.stageTimes[zone.name];
+			times.resize(measuredFrame, 0.0);
+			times.push_back(double(zone.self) / 1e6);
+			result.stageCalls[zone.name] += zone.count;
+		}
+	}
+	for (std::pair<const std::string, std::vector<double>>& stage : result.stageTimes)
+		stage.second.resize(result.frameTimes.size(), 0.0);
+
+	Elite::PrintBenchmarkResult(result, std::cout);
+	PrintFrameStatistics("all frames", result.statistics);
+	const char* pOutput = GetArgumentValue(argc, args, "--output");
+	int exitCode = Elite::WriteBenchmarkResult(pOutput ? pOutput : "benchmark.json", result) ? 0 : 1;
+	if (const char* pImage = GetArgumentValue(argc, args, "--image"))
+	{
+		if (!pRenderer->SaveFrame(pImage))
+			exitCode = 1;
+	}
+	if (pCompare && !Elite::CompareBenchmarkResults(baseline, result, GetArgumentFloat(argc, args, "--threshold", 0.05f), std::cout))
+		exitCode = 1;
+
+	pRenderer.reset();
+	delete pCamera;
+	pCamera = nullptr;
+	SDL_Quit();
+	return exitCode;
+#endif
+}
+
+//Times the SIMD math against the scalar code it replaces & the throughput of the rasterizer's kernels, nothing is rendered
+//Returns 1 when an operation lost more than the threshold of its throughput against the baseline
+//--microbench [--iterations 1000000] [--filter name] [--time 0.5] [--output microbench.csv] [--compare baseline.csv] [--threshold 0.05]
+int RunMicrobench(int argc, char* args[])
+{
+	std::vector<Elite::MicrobenchResult> baseline{};
+	const char* pCompare = GetArgumentValue(argc, args, "--compare");
+	if (pCompare && !Elite::ReadMicrobenchResults(pCompare, baseline))
+		return 1;
+
+	SDL_Init(0);
+	const char* pFilter = GetArgumentValue(argc, args, "--filter");
+	const std::vector<Elite::MicrobenchResult> results = Elite::RunMicrobenchmarks(GetArgumentUInt(argc, args, "--iterations", 1000000),
+		pFilter ? pFilter : "", GetArgumentFloat(argc, args, "--time", 0.5f));
+
+	int exitCode = 0;
+	const char* pOutput = GetArgumentValue(argc, args, "--output");
+	if (pOutput && !Elite::WriteMicrobenchResults(pOutput, results))
+		exitCode = 1;
+	if (pCompare && !Elite::CompareMicrobenchResults(baseline, results, GetArgumentFloat(argc, args, "--threshold", 0.05f), std::cout))
+		exitCode = 1;
+	SDL_Quit();
+	return exitCode;
+}
+
+int main(int argc, char* args[])
+{
+	ELITE_PROFILE_THREAD("Main");
+	if (HasArgument(argc, args, "--microbench"))
+		return RunMicrobench(argc, args);
+	if (HasArgument(argc, args, "--benchmark"))
+		return RunBenchmark(argc, args);
+	if (HasArgument(argc, args, "--batch"))
+		return RunBatch(argc, args);
+	if (HasArgument(argc, args, "--headless"))
+		return RunHeadless(argc, args);
 
 	//Create window + surfaces
 	SDL_Init(SDL_INIT_VIDEO);
@@ -44,8 +417,14 @@ int main(int argc, char* args[])
 	auto pRenderer{ std::make_unique<Elite::Renderer>(pWindow) };
 	Elite::Camera* pCamera = new Elite::Camera(float(width) / float(height));
 	pRenderer->SetCamera(pCamera);
+	pRenderer->SetInstances(MakeInstanceGrid(GetArgumentUInt(argc, args, "--instances", 1)));
 
-	//Start loop
+	//Start loop, idle frames sleep until there is input, but wake up at least this often (in milliseconds)
+	const int32_t idleWaitTime = 100;
+	//Frame statistics are recorded while N is toggled on
+	const std::string statisticsPath = "statistics.csv";
+	std::ofstream statisticsFile{};
+	uint32_t amountOfRecordedFrames = 0;
 	pTimer->Start();
 	float printTimer = 0.f;
 	bool isLooping = true;
@@ -61,6 +440,11 @@ int main(int argc, char* args[])
 			case SDL_QUIT:
 				isLooping = false;
 				break;
+			case SDL_WINDOWEVENT:
+				//The last frame is only presented once, a covered window has to get a new one
+				if (e.window.event == SDL_WINDOWEVENT_EXPOSED)
+					pRenderer->Invalidate();
+				break;
 			case SDL_KEYUP:
 				if (e.key.keysym.scancode == SDL_SCANCODE_E)
 					pRenderer->ToggleRenderMode();
@@ -72,23 +456,70 @@ int main(int argc, char* args[])
 					pRenderer->ToggleSample();
 				if (e.key.keysym.scancode == SDL_SCANCODE_T)
 					pRenderer->ToggleFireMesh();
+				if (e.key.keysym.scancode == SDL_SCANCODE_G)
+					pRenderer->ToggleResolutionGovernor();
+				if (e.key.keysym.scancode == SDL_SCANCODE_V)
+					pRenderer->ToggleShadingRate();
+				if (e.key.keysym.scancode == SDL_SCANCODE_L)
+					pRenderer->ToggleFrameLatency();
+				if (e.key.keysym.scancode == SDL_SCANCODE_P)
+					pRenderer->TogglePresentMode();
+				if (e.key.keysym.scancode == SDL_SCANCODE_Z)
+					pRenderer->ToggleDepthFormat();
+				if (e.key.keysym.scancode == SDL_SCANCODE_O)
+					pRenderer->ToggleMeshletOcclusion();
+				if (e.key.keysym.scancode == SDL_SCANCODE_B)
+					pRenderer->ToggleOcclusionCulling();
+				if (e.key.keysym.scancode == SDL_SCANCODE_K)
+					WriteProfile("profile.json");
+				if (e.key.keysym.scancode == SDL_SCANCODE_H)
+					pRenderer->ToggleDebugView();
+				if (e.key.keysym.scancode == SDL_SCANCODE_J)
+					pTimer->PrintFrameTimeHistogram(std::cout);
+				if (e.key.keysym.scancode == SDL_SCANCODE_N)
+				{
+					if (statisticsFile.is_open())
+					{
+						statisticsFile.close();
+						pRenderer->SetPixelStatistics(false);
+						std::cout << "Statistics: stopped recording to " << statisticsPath << "\n";
+					}
+					else if (OpenStatisticsFile(statisticsFile, statisticsPath))
+					{
+						pRenderer->SetPixelStatistics(true);
+						std::cout << "Statistics: started recording to " << statisticsPath << "\n";
+					}
+				}
 
 				break;
 			}
 		}
 
 		//--------- Render ---------
-		pRenderer->Render();
+		//Nothing changed, so the time spent waiting for input is not counted as frame time either
+		const bool isFrameRendered = pRenderer->Render();
+		if (!isFrameRendered)
+		{
+			pTimer->Stop();
+			SDL_WaitEventTimeout(nullptr, idleWaitTime);
+			pTimer->Start();
+		}
+		//Blitted frames finish while the next one renders, so each row holds the frame before, nothing is finished after the first one
+		else if (statisticsFile.is_open() && pRenderer->GetFrameStatistics().pixels != 0)
+			Elite::WriteFrameStatistics(statisticsFile, amountOfRecordedFrames++, pRenderer->GetFrameStatistics());
 
 		//--------- Timer ---------
-		pTimer->Update();
+		//Only rendered frames go into the frame time percentiles
+		pTimer->Update(isFrameRendered);
 		pCamera->Update(pTimer->GetElapsed());
 		pRenderer->Update(pTimer->GetElapsed());
 		printTimer += pTimer->GetElapsed();
 		if (printTimer >= 1.f)
 		{
 			printTimer = 0.f;
-			std::cout << "FPS: " << pTimer->GetFPS() << std::endl;
+			const Elite::FrameTimeSummary frameTimes = pTimer->GetFrameTimeSummary();
+			std::cout << "FPS: " << pTimer->GetFPS() << " (" << pRenderer->GetRenderWidth() << "x" << pRenderer->GetRenderHeight() << "), frame time p50 "
+				<< Elite::ToMilliseconds(frameTimes.p50) << " ms, p99 " << Elite::ToMilliseconds(frameTimes.p99) << " ms, max " << Elite::ToMilliseconds(frameTimes.max) << " ms, " << frameTimes.amountOfHitches << " hitch(es)" << std::endl;
 		}
 
 	}
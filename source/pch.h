@@ -10,11 +10,13 @@
 #include "SDL_syswm.h"
 #include "SDL_surface.h"
 
-// DirectX Headers
+// DirectX Headers, only when the DirectX backend is built
+#ifdef ELITE_BACKEND_DX11
 #include <dxgi.h>
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <d3dx11effect.h>
+#endif
 
 //Elite headers
 #include "EMath.h"